@@ -0,0 +1,27 @@
+#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 direction;
+layout (location = 2) in vec4 color;
+layout (location = 3) in float life;
+layout (location = 4) in float speed;
+layout (location = 5) in float overrideScale;
+
+out vec3 vPosition;
+out vec3 vDirection;
+out vec4 vColor;
+out float vLife;
+out float vSpeed;
+out float vScale;
+
+uniform float delta;
+uniform float colorDecay;
+
+void main()
+{
+    vLife = life - delta;
+    vPosition = position + (direction * speed) * delta;
+    vDirection = direction;
+    vColor = vec4(color.rgb, color.a - colorDecay * delta);
+    vSpeed = speed;
+    vScale = overrideScale;
+}
@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec4 color;
+layout (location = 3) in float life;
+layout (location = 5) in float overrideScale;
+
+out vec4 vColor;
+out float vLife;
+out float vScale;
+
+uniform float scale = 5.0f;
+
+void main()
+{
+    vColor = color;
+    vLife = life;
+    vScale = overrideScale >= 0.0 ? overrideScale : scale;
+    gl_Position = vec4(position, 1.0);
+}
@@ -1,9 +1,8 @@
 #version 330 core
+in vec4 SpriteColor;
 out vec4 color;
 
-uniform vec3 spriteColor;
-
 void main()
 {    
-    color = vec4(spriteColor, 1.0);
+    color = SpriteColor;
 }  
\ No newline at end of file
@@ -1,10 +1,12 @@
 #version 330 core
 layout (location = 0) in vec4 vertex;
+layout (location = 1) in vec4 color;
+out vec4 SpriteColor;
 
-uniform mat4 model;
 uniform mat4 projection;
 
 void main()
 {
-    gl_Position = projection * model * vec4(vertex.xy, 0.0, 1.0);
+    SpriteColor = color;
+    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
 }
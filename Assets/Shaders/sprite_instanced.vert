@@ -0,0 +1,13 @@
+#version 330 core
+layout (location = 0) in vec4 vertex;
+layout (location = 1) in vec2 offset;
+out vec2 TexCoords;
+
+uniform mat4 model;
+uniform mat4 projection;
+
+void main()
+{
+    TexCoords = vertex.zw;
+    gl_Position = projection * (model * vec4(vertex.xy, 0.0, 1.0) + vec4(offset, 0.0, 0.0));
+}
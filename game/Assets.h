@@ -40,6 +40,9 @@ namespace Assets
 		const std::string SpriteFragmentFile = BasePath + InnerPath + "sprite.frag";
 		const std::string SpriteNoColorFragmentFile = BasePath + InnerPath + "sprite_no_color.frag";
 
+		const std::string SpriteInstancedName = "shader_sprite_instanced";
+		const std::string SpriteInstancedVertexFile = BasePath + InnerPath + "sprite_instanced.vert";
+
 		const std::string TextName = "shader_text";
 		const std::string TextVertexFile = BasePath + InnerPath + "text.vert";
 		const std::string TextFragmentFile = BasePath + InnerPath + "text.frag";
@@ -50,6 +53,14 @@ namespace Assets
 
 		const std::string ParticleShapeFragmentFile = BasePath + InnerPath + "particle_shape.frag";
 		const std::string ParticleTextureFragmentFile = BasePath + InnerPath + "particle_texture.frag";
+
+		const std::string ParticleFeedbackName = "shader_particle_feedback";
+		const std::string ParticleFeedbackVertexFile = BasePath + InnerPath + "particle_feedback.vert";
+		const std::string ParticleFeedbackGeometryFile = BasePath + InnerPath + "particle_feedback.geom";
+
+		const std::string ParticleGpuName = "shader_particle_gpu";
+		const std::string ParticleGpuVertexFile = BasePath + InnerPath + "particle_gpu.vert";
+		const std::string ParticleGpuGeometryFile = BasePath + InnerPath + "particle_gpu.geom";
 	}
 
 	namespace Fonts
@@ -14,6 +14,7 @@
 Alien::Alien(AlienType InType)
 	: Score(0), Type(InType)
 {
+	AddTypeTag<Alien>();
 	HasCollision(true);
 
 	TeamPtr = std::make_shared<TeamComponent>(weak_from_this());
@@ -38,6 +39,11 @@ void Alien::SetProjectilePool(const ProjectilePoolPtr& InProjectilePool)
 	CurrentProjectilePool = InProjectilePool;
 }
 
+void Alien::SetType(AlienType InType)
+{
+	Type = InType;
+}
+
 int Alien::GetScore() const
 {
 	return Score;
@@ -87,6 +93,11 @@ bool Alien::TakeDamage(float InDamage)
 	return true;
 }
 
+IDamageable* Alien::AsDamageable()
+{
+	return this;
+}
+
 void Alien::Shoot() const
 {
 	if (CurrentProjectilePool == nullptr)
@@ -101,7 +112,10 @@ void Alien::Shoot() const
 	SpawnLocation.y += (GetSize().y + 5.f);
 
 	Projectile::SharedPtr NewProjectile = CurrentProjectilePool->Create(SpawnLocation, TeamPtr->GetTeam());
-	CurrentScene->Add(NewProjectile);
+	if (NewProjectile != nullptr)
+	{
+		CurrentScene->Activate(NewProjectile);
+	}
 }
 
 Alien::GameSharedPtr Alien::GetGame() const
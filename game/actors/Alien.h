@@ -31,6 +31,7 @@ public:
 	Alien(const glm::vec3& InLocation, const glm::vec3& InSize, AlienType InType);
 
 	void SetProjectilePool(const ProjectilePoolPtr& InProjectilePool);
+	void SetType(AlienType InType);
 
 	int GetScore() const;
 	AlienType GetType() const;
@@ -39,6 +40,7 @@ public:
 	void Begin() override;
 
 	bool TakeDamage(float InDamage) override;
+	IDamageable* AsDamageable() override;
 
 	void Shoot() const;
 
@@ -0,0 +1,323 @@
+#include "AlienFormation.h"
+
+#include <algorithm>
+
+AlienFormation::AlienFormation()
+	: NumRows(0), NumCols(0), NumAlive(0), OuterLeftCol(0), OuterRightCol(0), LastRow(0)
+{
+}
+
+VolleyPattern AlienFormation::ParsePattern(const std::string& InName)
+{
+	if (InName == "Columns")
+	{
+		return VolleyPattern::Columns;
+	}
+
+	if (InName == "Burst")
+	{
+		return VolleyPattern::Burst;
+	}
+
+	if (InName == "Aimed")
+	{
+		return VolleyPattern::Aimed;
+	}
+
+	return VolleyPattern::Random;
+}
+
+void AlienFormation::Resize(int InNumRows, int InNumCols)
+{
+	NumRows = std::max(0, InNumRows);
+	NumCols = std::max(0, InNumCols);
+
+	AliveMask.assign((GetNum() + 63) / 64, 0);
+	ColAliveCount.assign(NumCols, 0);
+	RowAliveCount.assign(NumRows, 0);
+	ColLowestRow.assign(NumCols, -1);
+	AliveColSlots.assign(NumCols, -1);
+	AliveCols.clear();
+	AliveCols.reserve(NumCols);
+
+	Clear();
+}
+
+void AlienFormation::ReviveAll()
+{
+	const int Num = GetNum();
+	std::fill(AliveMask.begin(), AliveMask.end(), ~0ull);
+	if (Num % 64 != 0)
+	{
+		AliveMask.back() = (1ull << (Num % 64)) - 1;
+	}
+
+	NumAlive = Num;
+	std::fill(ColAliveCount.begin(), ColAliveCount.end(), NumRows);
+	std::fill(RowAliveCount.begin(), RowAliveCount.end(), NumCols);
+	std::fill(ColLowestRow.begin(), ColLowestRow.end(), NumRows - 1);
+
+	AliveCols.clear();
+	for (int Col = 0; Col < NumCols; ++Col)
+	{
+		AliveColSlots[Col] = Col;
+		AliveCols.push_back(Col);
+	}
+
+	OuterLeftCol = 0;
+	OuterRightCol = std::max(0, NumCols - 1);
+	LastRow = std::max(0, NumRows - 1);
+}
+
+void AlienFormation::Clear()
+{
+	std::fill(AliveMask.begin(), AliveMask.end(), 0);
+	NumAlive = 0;
+	std::fill(ColAliveCount.begin(), ColAliveCount.end(), 0);
+	std::fill(RowAliveCount.begin(), RowAliveCount.end(), 0);
+	std::fill(ColLowestRow.begin(), ColLowestRow.end(), -1);
+	std::fill(AliveColSlots.begin(), AliveColSlots.end(), -1);
+	AliveCols.clear();
+
+	OuterLeftCol = 0;
+	OuterRightCol = std::max(0, NumCols - 1);
+	LastRow = 0;
+}
+
+void AlienFormation::Kill(int Index)
+{
+	if (!IsAlive(Index))
+	{
+		return;
+	}
+
+	AliveMask[Index >> 6] &= ~(1ull << (Index & 63));
+	NumAlive--;
+
+	const int Row = Index / NumCols;
+	const int Col = Index % NumCols;
+	RowAliveCount[Row]--;
+	ColAliveCount[Col]--;
+
+	if (ColAliveCount[Col] <= 0)
+	{
+		ColLowestRow[Col] = -1;
+		RemoveAliveCol(Col);
+	}
+	else if (ColLowestRow[Col] == Row)
+	{
+		int NewLowest = Row - 1;
+		while (NewLowest >= 0 && !IsAlive(NewLowest * NumCols + Col))
+		{
+			NewLowest--;
+		}
+
+		ColLowestRow[Col] = NewLowest;
+	}
+
+	UpdateBounds();
+}
+
+bool AlienFormation::IsAlive(int Index) const
+{
+	if (Index < 0 || Index >= GetNum())
+	{
+		return false;
+	}
+
+	return (AliveMask[Index >> 6] & (1ull << (Index & 63))) != 0;
+}
+
+int AlienFormation::GetNumRows() const
+{
+	return NumRows;
+}
+
+int AlienFormation::GetNumCols() const
+{
+	return NumCols;
+}
+
+int AlienFormation::GetNum() const
+{
+	return NumRows * NumCols;
+}
+
+int AlienFormation::GetNumAlive() const
+{
+	return NumAlive;
+}
+
+int AlienFormation::GetOuterLeftCol() const
+{
+	return OuterLeftCol;
+}
+
+int AlienFormation::GetOuterRightCol() const
+{
+	return OuterRightCol;
+}
+
+int AlienFormation::GetLastRow() const
+{
+	return LastRow;
+}
+
+int AlienFormation::GetFrontLine(int Col) const
+{
+	if (Col < 0 || Col >= NumCols || ColLowestRow[Col] < 0)
+	{
+		return -1;
+	}
+
+	return ColLowestRow[Col] * NumCols + Col;
+}
+
+void AlienFormation::SelectShooters(VolleyPattern Pattern, int NumShooters, int AimCol, Random::REngine& Engine, std::vector<int>& OutShooters)
+{
+	OutShooters.clear();
+	NumShooters = std::min(NumShooters, static_cast<int>(AliveCols.size()));
+	if (NumShooters <= 0)
+	{
+		return;
+	}
+
+	switch (Pattern)
+	{
+	case VolleyPattern::Columns:
+		SelectColumns(NumShooters, OutShooters);
+		break;
+	case VolleyPattern::Burst:
+		SelectRandom(1, Engine, OutShooters);
+		break;
+	case VolleyPattern::Aimed:
+		SelectAimed(NumShooters, AimCol, OutShooters);
+		break;
+	case VolleyPattern::Random:
+	default:
+		SelectRandom(NumShooters, Engine, OutShooters);
+		break;
+	}
+}
+
+void AlienFormation::SelectRandom(int NumShooters, Random::REngine& Engine, std::vector<int>& OutShooters)
+{
+	// Partial Fisher-Yates, the first NumShooters slots end up holding the picked columns.
+	const int LastSlot = static_cast<int>(AliveCols.size()) - 1;
+	for (int Slot = 0; Slot < NumShooters; ++Slot)
+	{
+		Random::IntDistribution Distribution(Slot, LastSlot);
+		SwapAliveCols(Slot, Distribution(Engine));
+		OutShooters.push_back(GetFrontLine(AliveCols[Slot]));
+	}
+}
+
+void AlienFormation::SelectColumns(int NumShooters, std::vector<int>& OutShooters) const
+{
+	const int Span = OuterRightCol - OuterLeftCol + 1;
+	for (int i = 0; i < NumShooters; ++i)
+	{
+		const int Target = OuterLeftCol + ((2 * i + 1) * Span) / (2 * NumShooters);
+		const int Shooter = GetFrontLine(FindNearestAliveCol(Target));
+		if (Shooter >= 0 && std::find(OutShooters.begin(), OutShooters.end(), Shooter) == OutShooters.end())
+		{
+			OutShooters.push_back(Shooter);
+		}
+	}
+}
+
+void AlienFormation::SelectAimed(int NumShooters, int AimCol, std::vector<int>& OutShooters) const
+{
+	const int FirstCol = FindNearestAliveCol(AimCol);
+	if (FirstCol < 0)
+	{
+		return;
+	}
+
+	OutShooters.push_back(GetFrontLine(FirstCol));
+	for (int Distance = 1; static_cast<int>(OutShooters.size()) < NumShooters; ++Distance)
+	{
+		const int Left = FirstCol - Distance;
+		const int Right = FirstCol + Distance;
+		if (Left < OuterLeftCol && Right > OuterRightCol)
+		{
+			break;
+		}
+
+		if (GetFrontLine(Left) >= 0)
+		{
+			OutShooters.push_back(GetFrontLine(Left));
+		}
+
+		if (static_cast<int>(OutShooters.size()) < NumShooters && GetFrontLine(Right) >= 0)
+		{
+			OutShooters.push_back(GetFrontLine(Right));
+		}
+	}
+}
+
+int AlienFormation::FindNearestAliveCol(int Col) const
+{
+	if (AliveCols.empty())
+	{
+		return -1;
+	}
+
+	Col = std::max(OuterLeftCol, std::min(OuterRightCol, Col));
+	for (int Distance = 0; Distance < NumCols; ++Distance)
+	{
+		if (Col - Distance >= 0 && ColAliveCount[Col - Distance] > 0)
+		{
+			return Col - Distance;
+		}
+
+		if (Col + Distance < NumCols && ColAliveCount[Col + Distance] > 0)
+		{
+			return Col + Distance;
+		}
+	}
+
+	return -1;
+}
+
+void AlienFormation::SwapAliveCols(int SlotA, int SlotB)
+{
+	const int ColA = AliveCols[SlotA];
+	const int ColB = AliveCols[SlotB];
+	AliveCols[SlotA] = ColB;
+	AliveCols[SlotB] = ColA;
+	AliveColSlots[ColB] = SlotA;
+	AliveColSlots[ColA] = SlotB;
+}
+
+void AlienFormation::RemoveAliveCol(int Col)
+{
+	const int Slot = AliveColSlots[Col];
+	if (Slot < 0)
+	{
+		return;
+	}
+
+	SwapAliveCols(Slot, static_cast<int>(AliveCols.size()) - 1);
+	AliveCols.pop_back();
+	AliveColSlots[Col] = -1;
+}
+
+void AlienFormation::UpdateBounds()
+{
+	// Bounds only shrink during a wave, so each loop walks past an empty line once.
+	while (OuterLeftCol < OuterRightCol && ColAliveCount[OuterLeftCol] <= 0)
+	{
+		OuterLeftCol++;
+	}
+
+	while (OuterRightCol > OuterLeftCol && ColAliveCount[OuterRightCol] <= 0)
+	{
+		OuterRightCol--;
+	}
+
+	while (LastRow > 0 && RowAliveCount[LastRow] <= 0)
+	{
+		LastRow--;
+	}
+}
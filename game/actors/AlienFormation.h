@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../pk/core/utils/Random.h"
+
+using namespace pk;
+
+enum class VolleyPattern : std::uint8_t
+{
+	// Random front line aliens.
+	Random,
+	// Front line aliens spread evenly across the formation.
+	Columns,
+	// One random front line alien firing several shots.
+	Burst,
+	// The front line aliens closest to the aim column.
+	Aimed
+};
+
+// Alive bookkeeping of a grid of aliens, updated on every kill so no query rescans the grid.
+class AlienFormation
+{
+public:
+	AlienFormation();
+
+	static VolleyPattern ParsePattern(const std::string& InName);
+
+	// Every alien starts dead, ReviveAll fills the grid.
+	void Resize(int InNumRows, int InNumCols);
+	void ReviveAll();
+	void Clear();
+	void Kill(int Index);
+
+	bool IsAlive(int Index) const;
+	int GetNumRows() const;
+	int GetNumCols() const;
+	int GetNum() const;
+	int GetNumAlive() const;
+
+	int GetOuterLeftCol() const;
+	int GetOuterRightCol() const;
+	int GetLastRow() const;
+	// Index of the lowest alive alien of the column, -1 if the column is empty.
+	int GetFrontLine(int Col) const;
+
+	// Front line aliens firing the next volley, OutShooters never grows past its reserved size.
+	void SelectShooters(VolleyPattern Pattern, int NumShooters, int AimCol, Random::REngine& Engine, std::vector<int>& OutShooters);
+
+private:
+	void SelectRandom(int NumShooters, Random::REngine& Engine, std::vector<int>& OutShooters);
+	void SelectColumns(int NumShooters, std::vector<int>& OutShooters) const;
+	void SelectAimed(int NumShooters, int AimCol, std::vector<int>& OutShooters) const;
+	int FindNearestAliveCol(int Col) const;
+	void SwapAliveCols(int SlotA, int SlotB);
+	void RemoveAliveCol(int Col);
+	void UpdateBounds();
+
+	int NumRows;
+	int NumCols;
+	int NumAlive;
+	int OuterLeftCol;
+	int OuterRightCol;
+	int LastRow;
+
+	std::vector<std::uint64_t> AliveMask;
+	std::vector<int> ColAliveCount;
+	std::vector<int> RowAliveCount;
+	std::vector<int> ColLowestRow;
+	// Columns with at least one alien, shuffled in place by the random selection.
+	std::vector<int> AliveCols;
+	std::vector<int> AliveColSlots;
+};
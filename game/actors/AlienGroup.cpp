@@ -1,14 +1,29 @@
 #include "AlienGroup.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+
 #include "../Assets.h"
 #include "../scenes/Game.h"
+#include "../pools/ProjectilePool.h"
+#include "../components/TeamComponent.h"
+#include "Projectile.h"
+#include "../../pk/core/asset/AssetManager.h"
+#include "../../pk/core/render/Renderer.h"
 #include "../../pk/core/utils/Random.h"
 #include "../../pk/core/utils/ClassSettingsReader.h"
 #include "../../pk/core/world/Scene.h"
+#include "../../pk/sound/SoundEngine.h"
 
 const int AlienGroup::DEFAULT_NUM_ROWS_PER_TYPE = 2;
 const int AlienGroup::DEFAULT_ALIEN_PER_ROW = 11;
 const int AlienGroup::DEFAULT_MAX_SHOOTING_ALIEN = 1;
+const int AlienGroup::DEFAULT_BURST_COUNT = 3;
+const int AlienGroup::DEFAULT_SHOOT_SEED = 0;
+const float AlienGroup::DEFAULT_BURST_INTERVAL = 0.15f;
+const std::string AlienGroup::DEFAULT_VOLLEY_PATTERN = "Random";
 const float AlienGroup::DEFAULT_TOP_OFFSET = 60.f;
 const float AlienGroup::DEFAULT_MIN_MOVE_DELAY = 1.f;
 const float AlienGroup::DEFAULT_MAX_MOVE_DELAY = 2.f;
@@ -19,20 +34,48 @@ const float AlienGroup::DEFAULT_V_MOVE_STEP = 5.f;
 const float AlienGroup::DEFAULT_H_DISTANCE = 20.f;
 const float AlienGroup::DEFAULT_V_DISTANCE = 20.f;
 const glm::vec3 AlienGroup::DEFAULT_ALIEN_SIZE = glm::vec3(10.f, 10.f, 1.f);
+const ClassSettings::Schema AlienGroup::SETTINGS_SCHEMA = {
+	{ "NumRowsPerType", ClassSettings::ValueType::Int },
+	{ "NumAlienPerRow", ClassSettings::ValueType::Int },
+	{ "MaxShootingAlien", ClassSettings::ValueType::Int },
+	{ "VolleyPattern", ClassSettings::ValueType::String },
+	{ "BurstCount", ClassSettings::ValueType::Int },
+	{ "BurstInterval", ClassSettings::ValueType::Float },
+	{ "ShootSeed", ClassSettings::ValueType::Int },
+	{ "TopOffset", ClassSettings::ValueType::Float },
+	{ "MinMoveDelay", ClassSettings::ValueType::Float },
+	{ "MaxMoveDelay", ClassSettings::ValueType::Float },
+	{ "ShootMaxCooldown", ClassSettings::ValueType::Float },
+	{ "ShootMinCooldown", ClassSettings::ValueType::Float },
+	{ "HorizontalMoveStep", ClassSettings::ValueType::Float },
+	{ "VerticalMoveStep", ClassSettings::ValueType::Float },
+	{ "HorizontalDistance", ClassSettings::ValueType::Float },
+	{ "VerticalDistance", ClassSettings::ValueType::Float },
+	{ "AlienSize", ClassSettings::ValueType::Vec3 }
+};
 
 using namespace Assets;
 
 AlienGroup::AlienGroup()
 	: bRightDirection(true), bGoDown(false),
 		NumRowsPerType(DEFAULT_NUM_ROWS_PER_TYPE), NumAlienPerRow(DEFAULT_ALIEN_PER_ROW),
-		OuterLeftCol(0), OuterRightCol(DEFAULT_ALIEN_PER_ROW - 1), LastRow(0), MaxShootingAlien(DEFAULT_MAX_SHOOTING_ALIEN), TopOffset(DEFAULT_TOP_OFFSET),
-		MinMoveDelay(DEFAULT_MIN_MOVE_DELAY), MaxMoveDelay(DEFAULT_MAX_MOVE_DELAY), SelectedMoveDelay(MaxMoveDelay), CurrentDelay(0.f),
-		ShootMaxCooldown(DEFAULT_SHOOT_MAX_COOLDOWN), ShootMinCooldown(DEFAULT_SHOOT_MIN_COOLDOWN), SelectedShootCooldown(DEFAULT_SHOOT_MAX_COOLDOWN), CurrentShootCooldown(0.f),
+		MaxShootingAlien(DEFAULT_MAX_SHOOTING_ALIEN), Pattern(VolleyPattern::Random),
+		BurstCount(DEFAULT_BURST_COUNT), BurstShotsLeft(0), BurstShooter(-1), BurstInterval(DEFAULT_BURST_INTERVAL), TopOffset(DEFAULT_TOP_OFFSET),
+		MinMoveDelay(DEFAULT_MIN_MOVE_DELAY), MaxMoveDelay(DEFAULT_MAX_MOVE_DELAY), SelectedMoveDelay(MaxMoveDelay),
+		ShootMaxCooldown(DEFAULT_SHOOT_MAX_COOLDOWN), ShootMinCooldown(DEFAULT_SHOOT_MIN_COOLDOWN), SelectedShootCooldown(DEFAULT_SHOOT_MAX_COOLDOWN),
 		HorizontalMoveStep(DEFAULT_H_MOVE_STEP), VerticalMoveStep(DEFAULT_V_MOVE_STEP),
 		HorizontalDistance(DEFAULT_H_DISTANCE), VerticalDistance(DEFAULT_V_DISTANCE),
-		AlienSize(DEFAULT_ALIEN_SIZE),
+		AlienSize(DEFAULT_ALIEN_SIZE), ShootEngine(Random::NewSeed()), bInstancesDirty(true),
 		State(GroupState::None)
 {
+	AddTypeTag<AlienGroup>();
+	HasCollision(true);
+	SetCollisionVolume(true);
+
+	TeamPtr = std::make_shared<TeamComponent>(weak_from_this());
+	TeamPtr->SetTeam(Team::Alien);
+	AddComponent(TeamPtr);
+
 	AlienTypeData SquidData(Config::SquidFile, Textures::SquidName);
 	AlienTypeData CrabData(Config::CrabFile, Textures::CrabName);
 	AlienTypeData OctopusData(Config::OctopusFile, Textures::OctopusName);
@@ -67,6 +110,21 @@ int AlienGroup::GetMaxShootingAlien() const
 	return MaxShootingAlien;
 }
 
+VolleyPattern AlienGroup::GetVolleyPattern() const
+{
+	return Pattern;
+}
+
+int AlienGroup::GetBurstCount() const
+{
+	return BurstCount;
+}
+
+float AlienGroup::GetBurstInterval() const
+{
+	return BurstInterval;
+}
+
 float AlienGroup::GetTopOffset() const
 {
 	return TopOffset;
@@ -114,9 +172,7 @@ float AlienGroup::GetVerticalDistance() const
 
 float AlienGroup::GetAliveRatio() const
 {
-	const float AliensCount = static_cast<float>(AllAliens.size());
-	const float AliveCount = static_cast<float>(AliveAliensIdx.size());
-	return AliveCount / AliensCount;
+	return static_cast<float>(Formation.GetNumAlive()) / static_cast<float>(GetNumAliens());
 }
 
 glm::vec3 AlienGroup::GetAlienSize() const
@@ -124,6 +180,37 @@ glm::vec3 AlienGroup::GetAlienSize() const
 	return AlienSize;
 }
 
+int AlienGroup::GetNumAliens() const
+{
+	return static_cast<int>(CellOffsets.size());
+}
+
+int AlienGroup::GetNumAliveAliens() const
+{
+	return Formation.GetNumAlive();
+}
+
+bool AlienGroup::IsAlienAlive(int Index) const
+{
+	return Formation.IsAlive(Index);
+}
+
+int AlienGroup::GetScore(int Index) const
+{
+	if (Index < 0 || Index >= GetNumAliens())
+	{
+		return 0;
+	}
+
+	const AlienType Type = RowTypes[Index / NumAlienPerRow];
+	return ConfigTypeMapping.at(Type).Score;
+}
+
+glm::vec3 AlienGroup::GetAlienLocation(int Index) const
+{
+	return GetLocation() + glm::vec3(CellOffsets[Index], 0.f);
+}
+
 void AlienGroup::SetNumRowsPerType(int InNum)
 {
 	NumRowsPerType = std::abs(InNum);
@@ -139,6 +226,26 @@ void AlienGroup::SetMaxShootingAlien(int InNum)
 	MaxShootingAlien = std::abs(InNum);
 }
 
+void AlienGroup::SetVolleyPattern(VolleyPattern InPattern)
+{
+	Pattern = InPattern;
+}
+
+void AlienGroup::SetBurstCount(int InCount)
+{
+	BurstCount = std::max(1, InCount);
+}
+
+void AlienGroup::SetBurstInterval(float InInterval)
+{
+	BurstInterval = std::abs(InInterval);
+}
+
+void AlienGroup::SetShootSeed(int InSeed)
+{
+	ShootEngine.seed(InSeed == 0 ? Random::NewSeed() : static_cast<unsigned int>(InSeed));
+}
+
 void AlienGroup::SetTopOffset(float InOffset)
 {
 	TopOffset = std::abs(InOffset);
@@ -208,18 +315,23 @@ void AlienGroup::LoadConfig()
 {
 	Actor::LoadConfig();
 
-	ClassSettings::SharedConstPtr GroupSettings = ClassSettingsReader::Load(GetConfigFile());
+	ClassSettings::SharedConstPtr GroupSettings = ClassSettingsReader::Load(GetConfigFile(), SETTINGS_SCHEMA);
 	if (GroupSettings == nullptr)
 	{
 		return;
 	}
 
-	int InNumRows, InNumAlien, InMaxShootingAlien;
-	float InTopOffset, InMinMoveDelay, InMaxMoveDelay, InShootMaxCooldown, InShootMinCooldown, InHMoveStep, InVMoveStep, InHDistance, InVDistance;
+	int InNumRows, InNumAlien, InMaxShootingAlien, InBurstCount, InShootSeed;
+	float InBurstInterval, InTopOffset, InMinMoveDelay, InMaxMoveDelay, InShootMaxCooldown, InShootMinCooldown, InHMoveStep, InVMoveStep, InHDistance, InVDistance;
+	std::string InVolleyPattern;
 	glm::vec3 InAlienSize(DEFAULT_ALIEN_SIZE);
 	GroupSettings->Get("NumRowsPerType", DEFAULT_NUM_ROWS_PER_TYPE, InNumRows);
 	GroupSettings->Get("NumAlienPerRow", DEFAULT_ALIEN_PER_ROW, InNumAlien);
 	GroupSettings->Get("MaxShootingAlien", DEFAULT_MAX_SHOOTING_ALIEN, InMaxShootingAlien);
+	GroupSettings->Get("VolleyPattern", DEFAULT_VOLLEY_PATTERN, InVolleyPattern);
+	GroupSettings->Get("BurstCount", DEFAULT_BURST_COUNT, InBurstCount);
+	GroupSettings->Get("BurstInterval", DEFAULT_BURST_INTERVAL, InBurstInterval);
+	GroupSettings->Get("ShootSeed", DEFAULT_SHOOT_SEED, InShootSeed);
 	GroupSettings->Get("TopOffset", DEFAULT_TOP_OFFSET, InTopOffset);
 	GroupSettings->Get("MinMoveDelay", DEFAULT_MIN_MOVE_DELAY, InMinMoveDelay);
 	GroupSettings->Get("MaxMoveDelay", DEFAULT_MAX_MOVE_DELAY, InMaxMoveDelay);
@@ -234,6 +346,10 @@ void AlienGroup::LoadConfig()
 	SetNumRowsPerType(InNumRows);
 	SetNumAlienPerRow(InNumAlien);
 	SetMaxShootingAlien(InMaxShootingAlien);
+	SetVolleyPattern(AlienFormation::ParsePattern(InVolleyPattern));
+	SetBurstCount(InBurstCount);
+	SetBurstInterval(InBurstInterval);
+	SetShootSeed(InShootSeed);
 	SetTopOffset(InTopOffset);
 	SetMinMoveDelay(InMinMoveDelay);
 	SetMaxMoveDelay(InMaxMoveDelay);
@@ -244,6 +360,43 @@ void AlienGroup::LoadConfig()
 	SetHorizontalDistance(InHDistance);
 	SetVerticalDistance(InVDistance);
 	SetAlienSize(InAlienSize);
+
+	LoadTypeConfigs();
+}
+
+void AlienGroup::LoadTypeConfigs()
+{
+	for (std::pair<const AlienType, AlienTypeData>& TypePair : ConfigTypeMapping)
+	{
+		ClassSettings::SharedConstPtr TypeSettings = ClassSettingsReader::Load(TypePair.second.ConfigFile);
+		if (TypeSettings == nullptr)
+		{
+			continue;
+		}
+
+		TypeSettings->Get("Score", 0, TypePair.second.Score);
+	}
+}
+
+void AlienGroup::OnConfigReloaded()
+{
+	const int OldNumRows = NumRowsPerType;
+	const int OldNumAlien = NumAlienPerRow;
+	LoadConfig();
+
+	if (OldNumRows == NumRowsPerType && OldNumAlien == NumAlienPerRow)
+	{
+		BuildOffsets();
+		return;
+	}
+
+	const bool bWasMoving = State == GroupState::Moving;
+	BuildMatrix();
+
+	if (bWasMoving)
+	{
+		StartGroup();
+	}
 }
 
 void AlienGroup::Begin()
@@ -251,9 +404,8 @@ void AlienGroup::Begin()
 	Actor::Begin();
 
 	BuildMatrix();
-	StartGroup();
-
 	GenerateShootCooldown();
+	StartGroup();
 
 	GamePtr = std::dynamic_pointer_cast<Game>(GetScene());
 }
@@ -266,16 +418,108 @@ void AlienGroup::Update(const float Delta)
 		return;
 	}
 
-	UpdateShootCooldown(Delta);
-	UpdateMoveDelay(Delta);
 	if (ReachedPlayer())
 	{
 		State = GroupState::Stopped;
+		StopTimers();
 		NotifyReachedPlayer();
 		return;
 	}
 
-	UpdateAliveAliens();
+	CheckDefeat();
+}
+
+void AlienGroup::Render() const
+{
+	if (bInstancesDirty)
+	{
+		UpdateInstances();
+	}
+
+	const Shader::SharedPtr InstancedShader = AssetManager::Get().GetShader(Shaders::SpriteInstancedName);
+
+	glm::mat4 Model = glm::translate(glm::mat4(1.f), GetLocation());
+	Model = glm::scale(Model, AlienSize);
+
+	for (const AlienInstanceRange& Range : InstanceRanges)
+	{
+		const Texture::SharedPtr TypeTexture = AssetManager::Get().GetTexture(ConfigTypeMapping.at(Range.Type).TextureName);
+		Renderer::Get().RenderSpriteInstanced(InstancedShader, TypeTexture, Model, Instances, Range.First, Range.Count);
+	}
+}
+
+bool AlienGroup::Collide(const Actor& Other, CollisionResult& OutResult) const
+{
+	if (Formation.GetNumAlive() <= 0 || !Actor::Collide(Other, OutResult))
+	{
+		return false;
+	}
+
+	OutResult.bHit = false;
+
+	const glm::vec2 Stride = GetCellStride();
+	if (Stride.x <= 0.f || Stride.y <= 0.f)
+	{
+		return false;
+	}
+
+	const BoundingBox OtherBox(Other.GetBoundingBox());
+	const glm::vec3 Corner = GetLocation() - (GetSize() / 2.f);
+	const int NumRows = static_cast<int>(RowTypes.size());
+
+	// Only the cells under the other box can be hit.
+	const int FirstCol = std::max(0, static_cast<int>(std::floor((OtherBox.Left() - Corner.x) / Stride.x)));
+	const int LastCol = std::min(NumAlienPerRow - 1, static_cast<int>(std::floor((OtherBox.Right() - Corner.x) / Stride.x)));
+	const int FirstRow = std::max(0, static_cast<int>(std::floor((OtherBox.Top() - Corner.y) / Stride.y)));
+	const int LastHitRow = std::min(NumRows - 1, static_cast<int>(std::floor((OtherBox.Bottom() - Corner.y) / Stride.y)));
+
+	for (int Row = FirstRow; Row <= LastHitRow; ++Row)
+	{
+		for (int Col = FirstCol; Col <= LastCol; ++Col)
+		{
+			const int Index = Row * NumAlienPerRow + Col;
+			if (!IsAlienAlive(Index))
+			{
+				continue;
+			}
+
+			const BoundingBox CellBox(Transform(GetAlienLocation(Index), AlienSize));
+			const bool bCollidedX = CellBox.Right() >= OtherBox.Left() && OtherBox.Right() >= CellBox.Left();
+			const bool bCollidedY = CellBox.Top() <= OtherBox.Bottom() && OtherBox.Top() <= CellBox.Bottom();
+			if (bCollidedX && bCollidedY)
+			{
+				OutResult.bHit = true;
+				OutResult.ImpactLocation = GetAlienLocation(Index);
+				OutResult.HitIndex = Index;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool AlienGroup::TakeDamage(float InDamage)
+{
+	// Without a collision result there is no way to tell which alien was hit.
+	return false;
+}
+
+bool AlienGroup::TakeDamage(float InDamage, const CollisionResult& Result)
+{
+	if (!IsAlienAlive(Result.HitIndex))
+	{
+		return false;
+	}
+
+	KillAlien(Result.HitIndex);
+	PlayExplosionAudio();
+	return true;
+}
+
+IDamageable* AlienGroup::AsDamageable()
+{
+	return this;
 }
 
 void AlienGroup::StartGroup()
@@ -288,69 +532,57 @@ void AlienGroup::StartGroup()
 
 	bRightDirection = true;
 	bGoDown = false;
-	CurrentShootCooldown = 0.f;
-	CurrentDelay = 0.f;
 	SelectedMoveDelay = MaxMoveDelay;
-	OuterLeftCol = 0;
-	OuterRightCol = NumAlienPerRow - 1;
-	LastRow = 0;
 
 	const float Width = static_cast<float>(CurrentScene->GetScreenWidth());
 
 	const float AlienPerRow = static_cast<float>(NumAlienPerRow);
 
-	const float GroupRectangleWidth = (AlienSize.x * AlienPerRow) + (HorizontalDistance * AlienPerRow);
+	const float GroupRectangleWidth = GetCellStride().x * AlienPerRow;
 	const float StartX = (Width - GroupRectangleWidth) / 2;
 
-	glm::vec3 CurrentLocation(0.f);
-	CurrentLocation.y = TopOffset;
-	CurrentLocation.x = StartX + (AlienSize.x / 2);
+	// The origin is the center of the formation, the first alien sits in its top left corner.
+	const glm::vec3 FirstLocation(StartX + (AlienSize.x / 2), TopOffset, 0.f);
+	const glm::vec3 HalfSpan((GetSize().x - AlienSize.x) / 2, (GetSize().y - AlienSize.y) / 2, 0.f);
+	SetLocation(FirstLocation + HalfSpan);
 
-	AliveAliensIdx.clear();
-	AliveAliensIdx.reserve(AllAliens.size());
-	for (int i = 0; i < AllAliens.size(); ++i)
-	{
-		const Alien::SharedPtr& Alien = AllAliens[i];
-		Alien->CancelDestroy();
-		CurrentScene->Add(Alien);
-		Alien->SetSize(AlienSize);
-		Alien->SetLocation(CurrentLocation);
-		AliveAliensIdx.push_back(i);
+	ReviveAll();
 
-		CurrentLocation.x += HorizontalDistance + (AlienSize.x);
+	State = GroupState::Moving;
+	StartTimers();
+}
 
-		if ((i + 1) % NumAlienPerRow == 0)
-		{
-			CurrentLocation.x = StartX + (AlienSize.x / 2);
-			CurrentLocation.y += VerticalDistance + (AlienSize.y);
-		}
-	}
+DelegateHandle AlienGroup::AddOnReachedPlayerDelegate(const OnReachedPlayerDelegate& InFunction)
+{
+	return OnReachedPlayerFunctions.Add(InFunction);
+}
 
-	State = GroupState::Moving;
+DelegateHandle AlienGroup::AddOnDefeatDelegate(const OnDefeatDelegate& InFunction)
+{
+	return OnDefeatFunctions.Add(InFunction);
 }
 
-void AlienGroup::AddOnReachedPlayerDelegate(const OnReachedPlayerDelegate& InFunction)
+void AlienGroup::RemoveOnReachedPlayerDelegate(DelegateHandle& Handle)
 {
-	OnReachedPlayerFunctions.push_back(InFunction);
+	OnReachedPlayerFunctions.Remove(Handle);
 }
 
-void AlienGroup::AddOnDefeatDelegate(const OnDefeatDelegate& InFunction)
+void AlienGroup::RemoveOnDefeatDelegate(DelegateHandle& Handle)
 {
-	OnDefeatFunctions.push_back(InFunction);
+	OnDefeatFunctions.Remove(Handle);
 }
 
 void AlienGroup::InvadersWon()
 {
 	HideBoard();
 	State = GroupState::Stopped;
+	StopTimers();
 }
 
-void AlienGroup::HideBoard() const
+void AlienGroup::HideBoard()
 {
-	for (const Alien::SharedPtr& Alien : AllAliens)
-	{
-		Alien->Destroy();
-	}
+	Formation.Clear();
+	bInstancesDirty = true;
 }
 
 void AlienGroup::PlayNextTrack() const
@@ -366,24 +598,89 @@ void AlienGroup::PlayNextTrack() const
 
 void AlienGroup::BuildMatrix()
 {
+	RowTypes.clear();
 	BuildMatrixPerType(AlienType::Octopus);
 	BuildMatrixPerType(AlienType::Crab);
 	BuildMatrixPerType(AlienType::Squid);
+
+	Formation.Resize(static_cast<int>(RowTypes.size()), NumAlienPerRow);
+	VolleyShooters.clear();
+	VolleyShooters.reserve(NumAlienPerRow);
+
+	BuildOffsets();
 }
 
 void AlienGroup::BuildMatrixPerType(AlienType Type)
 {
-	const int AlienToSpawn = NumRowsPerType * NumAlienPerRow;
-	for (int i = 0; i < AlienToSpawn; ++i)
+	for (int i = 0; i < NumRowsPerType; ++i)
+	{
+		RowTypes.push_back(Type);
+	}
+}
+
+void AlienGroup::BuildOffsets()
+{
+	const int NumRows = static_cast<int>(RowTypes.size());
+	const glm::vec2 Stride = GetCellStride();
+	const glm::vec2 Span(Stride.x * static_cast<float>(NumAlienPerRow - 1), Stride.y * static_cast<float>(NumRows - 1));
+
+	CellOffsets.clear();
+	CellOffsets.reserve(NumRows * NumAlienPerRow);
+	for (int Row = 0; Row < NumRows; ++Row)
+	{
+		for (int Col = 0; Col < NumAlienPerRow; ++Col)
+		{
+			CellOffsets.emplace_back(Stride.x * static_cast<float>(Col) - Span.x / 2, Stride.y * static_cast<float>(Row) - Span.y / 2);
+		}
+	}
+
+	SetSize(glm::vec3(Span.x + AlienSize.x, Span.y + AlienSize.y, 1.f));
+	bInstancesDirty = true;
+}
+
+void AlienGroup::ReviveAll()
+{
+	Formation.ReviveAll();
+	bInstancesDirty = true;
+}
+
+void AlienGroup::KillAlien(int Index)
+{
+	Formation.Kill(Index);
+	bInstancesDirty = true;
+}
+
+void AlienGroup::UpdateInstances() const
+{
+	InstanceOffsets.clear();
+	InstanceRanges.clear();
+
+	// Rows of the same type are next to each other, so each type is one contiguous range.
+	for (int Row = 0; Row < static_cast<int>(RowTypes.size()); ++Row)
 	{
-		Alien::SharedPtr NewAlien = std::make_shared<Alien>(Type);
-		NewAlien->SetConfig(ConfigTypeMapping[Type].ConfigFile);
-		NewAlien->SetShader(Shaders::SpriteNoColorName);
-		NewAlien->SetTexture(ConfigTypeMapping[Type].TextureName);
-		NewAlien->SetProjectilePool(ProjectilePoolPtr);
+		if (InstanceRanges.empty() || InstanceRanges.back().Type != RowTypes[Row])
+		{
+			InstanceRanges.emplace_back(RowTypes[Row], static_cast<int>(InstanceOffsets.size()));
+		}
 
-		AllAliens.push_back(NewAlien);
+		for (int Col = 0; Col < NumAlienPerRow; ++Col)
+		{
+			const int Index = Row * NumAlienPerRow + Col;
+			if (IsAlienAlive(Index))
+			{
+				InstanceOffsets.push_back(CellOffsets[Index]);
+				InstanceRanges.back().Count++;
+			}
+		}
 	}
+
+	Instances.Upload(InstanceOffsets);
+	bInstancesDirty = false;
+}
+
+glm::vec2 AlienGroup::GetCellStride() const
+{
+	return glm::vec2(AlienSize.x + HorizontalDistance, AlienSize.y + VerticalDistance);
 }
 
 bool AlienGroup::ReachedEnd() const
@@ -395,10 +692,8 @@ bool AlienGroup::ReachedEnd() const
 	}
 
 	const float Width = static_cast<float>(CurrentScene->GetScreenWidth());
-	const Alien::SharedPtr LeftAlien = AllAliens[OuterLeftCol];
-	const Alien::SharedPtr RightAlien = AllAliens[OuterRightCol];
-	const glm::vec3 LeftLocation = LeftAlien->GetLocation();
-	const glm::vec3 RightLocation = RightAlien->GetLocation();
+	const glm::vec3 LeftLocation = GetAlienLocation(Formation.GetOuterLeftCol());
+	const glm::vec3 RightLocation = GetAlienLocation(Formation.GetOuterRightCol());
 
 	if (!bRightDirection && LeftLocation.x - HorizontalMoveStep - (AlienSize.x) <= 0.f)
 	{
@@ -421,14 +716,14 @@ bool AlienGroup::ReachedPlayer() const
 		return false;
 	}
 
-	const float Height = static_cast<float>(CurrentScene->GetScreenHeight());
-	const Alien::SharedPtr LastAlien = AllAliens[LastRow * NumAlienPerRow];
-	if (LastAlien == nullptr)
+	const int LastIndex = Formation.GetLastRow() * NumAlienPerRow;
+	if (LastIndex >= GetNumAliens())
 	{
 		return false;
 	}
 
-	const glm::vec3 LastLocation = LastAlien->GetLocation();
+	const float Height = static_cast<float>(CurrentScene->GetScreenHeight());
+	const glm::vec3 LastLocation = GetAlienLocation(LastIndex);
 	if ((LastLocation.y + AlienSize.y) >= Height)
 	{
 		return true;
@@ -437,40 +732,7 @@ bool AlienGroup::ReachedPlayer() const
 	return false;
 }
 
-void AlienGroup::UpdateOuterColsAndRow()
-{
-	const int RowCount = GetNumRowsTotal();
-
-	OuterLeftCol = NumAlienPerRow - 1;
-	OuterRightCol = 0;
-	LastRow = 0;
-
-	for (int j = 0; j < NumAlienPerRow; ++j)
-	{
-		for (int i = 0; i < RowCount; ++i)
-		{
-			const int LeftCalcIndex = i * NumAlienPerRow + j;
-			if (!AllAliens[LeftCalcIndex]->IsDestroyed() && j < OuterLeftCol)
-			{
-				OuterLeftCol = j;
-			}
-
-			const int RightIndex = (NumAlienPerRow - j - 1);
-			const int RightCalcIndex = i * NumAlienPerRow + (RightIndex);
-			if (!AllAliens[RightCalcIndex]->IsDestroyed() && RightIndex > OuterRightCol)
-			{
-				OuterRightCol = RightIndex;
-			}
-
-			if (!AllAliens[LeftCalcIndex]->IsDestroyed() && i >= LastRow)
-			{
-				LastRow = i;
-			}
-		}
-	}
-}
-
-void AlienGroup::MoveAliens(const float Delta)
+void AlienGroup::MoveAliens()
 {
 	glm::vec3 MoveOffset(0.f);
 	if (bGoDown)
@@ -487,11 +749,7 @@ void AlienGroup::MoveAliens(const float Delta)
 		MoveOffset.x = -HorizontalMoveStep;
 	}
 
-	for (const Alien::SharedPtr& Alien : AllAliens)
-	{
-		const glm::vec3 NewLocation = Alien->GetLocation() + MoveOffset;
-		Alien->SetLocation(NewLocation);
-	}
+	SetLocation(GetLocation() + MoveOffset);
 
 	if (ReachedEnd())
 	{
@@ -502,56 +760,134 @@ void AlienGroup::MoveAliens(const float Delta)
 
 void AlienGroup::GenerateShootCooldown()
 {
-	SelectedShootCooldown = Random::Get(ShootMinCooldown, ShootMaxCooldown);
+	SelectedShootCooldown = Random::Get(ShootEngine, ShootMinCooldown, ShootMaxCooldown);
 }
 
-void AlienGroup::Shoot() const
+void AlienGroup::Shoot()
 {
-	int ShootingAlien = Random::Get(0, MaxShootingAlien);
-	if (ShootingAlien <= 0) { ShootingAlien = 1; }
+	const int NumShooters = Random::Get(ShootEngine, 1, std::max(1, MaxShootingAlien));
 
-	std::vector<int> AvailableAliensIdx = AliveAliensIdx;
-	if (ShootingAlien > AvailableAliensIdx.size())
+	// Only the lowest alien of a column can shoot, nothing stands in its way.
+	Formation.SelectShooters(Pattern, NumShooters, GetAimCol(), ShootEngine, VolleyShooters);
+	for (const int Shooter : VolleyShooters)
 	{
-		ShootingAlien = static_cast<int>(AvailableAliensIdx.size()) - 1;
+		ShootFrom(Shooter);
 	}
 
-	for (int i = 0; i < ShootingAlien; ++i)
+	if (Pattern == VolleyPattern::Burst && !VolleyShooters.empty() && BurstCount > 1)
 	{
-		const int AliveCount = static_cast<int>(AvailableAliensIdx.size()) - 1;
-		const int RandomAlienIndex = Random::Get(0, AliveCount);
-		const int AliveAlien = AvailableAliensIdx[RandomAlienIndex];
+		BurstShooter = VolleyShooters.front();
+		BurstShotsLeft = BurstCount - 1;
+		ClearTimer(BurstTimer);
+		BurstTimer = SetTimer(BurstInterval, [this]() { OnBurstTimer(); });
+	}
+}
 
-		AvailableAliensIdx.erase(AvailableAliensIdx.begin() + RandomAlienIndex);
+void AlienGroup::ShootFrom(int Index) const
+{
+	if (ProjectilePoolPtr == nullptr)
+	{
+		std::cout << "[AlienGroup] - Unable to shoot, no pool obtained.\n";
+		return;
+	}
 
-		AllAliens[AliveAlien]->Shoot();
+	const Scene::SharedPtr CurrentScene = GetScene();
+	if (CurrentScene == nullptr)
+	{
+		return;
+	}
+
+	glm::vec3 SpawnLocation(GetAlienLocation(Index));
+	SpawnLocation.y += (AlienSize.y + 5.f);
+
+	Projectile::SharedPtr NewProjectile = ProjectilePoolPtr->Create(SpawnLocation, TeamPtr->GetTeam());
+	if (NewProjectile != nullptr)
+	{
+		CurrentScene->Activate(NewProjectile);
 	}
 }
 
-void AlienGroup::UpdateShootCooldown(const float Delta)
+int AlienGroup::GetAimCol() const
 {
-	CurrentShootCooldown += Delta;
-	if (CurrentShootCooldown >= SelectedShootCooldown)
+	const Game::SharedPtr CurrentGame = GetGame();
+	const float StrideX = GetCellStride().x;
+	if (CurrentGame == nullptr || StrideX <= 0.f)
 	{
-		Shoot();
-		CurrentShootCooldown = 0.f;
-		GenerateShootCooldown();
+		return NumAlienPerRow / 2;
 	}
+
+	const float Left = GetLocation().x - (GetSize().x / 2.f);
+	return static_cast<int>(std::floor((CurrentGame->GetPlayerLocation().x - Left) / StrideX));
 }
 
-void AlienGroup::UpdateMoveDelay(const float Delta)
+void AlienGroup::PlayExplosionAudio() const
 {
-	CurrentDelay += Delta;
-	if (CurrentDelay >= SelectedMoveDelay)
+	const Game::SharedPtr CurrentGame = GetGame();
+	if (CurrentGame == nullptr)
 	{
-		UpdateOuterColsAndRow();
-		MoveAliens(Delta);
-		PlayNextTrack();
-		GenerateMoveDelay();
-		CurrentDelay = 0.f;
+		SoundEngine::Get().Play(Assets::Sounds::AlienExplosion, 1.f);
+	}
+	else
+	{
+		CurrentGame->PlayAudio(Assets::Sounds::AlienExplosionName, 1.f);
 	}
 }
 
+void AlienGroup::StartTimers()
+{
+	StopTimers();
+	ShootTimer = SetTimer(SelectedShootCooldown, [this]() { OnShootTimer(); });
+	MoveTimer = SetTimer(SelectedMoveDelay, [this]() { OnMoveTimer(); });
+}
+
+void AlienGroup::StopTimers()
+{
+	ClearTimer(ShootTimer);
+	ClearTimer(MoveTimer);
+	ClearTimer(BurstTimer);
+}
+
+void AlienGroup::OnShootTimer()
+{
+	if (State != GroupState::Moving)
+	{
+		return;
+	}
+
+	Shoot();
+	GenerateShootCooldown();
+	ShootTimer = SetTimer(SelectedShootCooldown, [this]() { OnShootTimer(); });
+}
+
+void AlienGroup::OnBurstTimer()
+{
+	// The burst ends early if its shooter dies in between shots.
+	if (State != GroupState::Moving || !IsAlienAlive(BurstShooter))
+	{
+		BurstShotsLeft = 0;
+		return;
+	}
+
+	ShootFrom(BurstShooter);
+	if (--BurstShotsLeft > 0)
+	{
+		BurstTimer = SetTimer(BurstInterval, [this]() { OnBurstTimer(); });
+	}
+}
+
+void AlienGroup::OnMoveTimer()
+{
+	if (State != GroupState::Moving)
+	{
+		return;
+	}
+
+	MoveAliens();
+	PlayNextTrack();
+	GenerateMoveDelay();
+	MoveTimer = SetTimer(SelectedMoveDelay, [this]() { OnMoveTimer(); });
+}
+
 void AlienGroup::GenerateMoveDelay()
 {
 	float Ratio = GetAliveRatio();
@@ -560,39 +896,29 @@ void AlienGroup::GenerateMoveDelay()
 	SelectedMoveDelay = Math::Lerp(MinMoveDelay, MaxMoveDelay, Ratio);
 }
 
-void AlienGroup::UpdateAliveAliens()
+void AlienGroup::CheckDefeat()
 {
 	if (State == GroupState::Stopped)
 	{
 		return;
 	}
 
-	AliveAliensIdx.erase(
-		std::remove_if(AliveAliensIdx.begin(), AliveAliensIdx.end(), [this](int Index) { return AllAliens[Index]->IsDestroyed(); }),
-		AliveAliensIdx.end()
-	);
-
-	if (AliveAliensIdx.empty())
+	if (Formation.GetNumAlive() <= 0)
 	{
 		State = GroupState::Stopped;
+		StopTimers();
 		NotifyDefeat();
 	}
 }
 
 void AlienGroup::NotifyReachedPlayer() const
 {
-	for (const OnReachedPlayerDelegate& Function : OnReachedPlayerFunctions)
-	{
-		Function();
-	}
+	OnReachedPlayerFunctions.Broadcast();
 }
 
 void AlienGroup::NotifyDefeat() const
 {
-	for (const OnDefeatDelegate& Function : OnDefeatFunctions)
-	{
-		Function();
-	}
+	OnDefeatFunctions.Broadcast();
 }
 
 AlienGroup::GameSharedPtr AlienGroup::GetGame() const
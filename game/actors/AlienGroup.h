@@ -1,12 +1,19 @@
 #pragma once
 
-#include <functional>
+#include <cstdint>
 #include <vector>
 #include <map>
 
 #include "Alien.h"
+#include "AlienFormation.h"
+#include "../../pk/core/interfaces/IDamageable.h"
+#include "../../pk/core/render/InstanceBuffer.h"
+#include "../../pk/core/utils/ClassSettings.h"
+#include "../../pk/core/utils/Delegate.h"
+#include "../../pk/core/utils/Random.h"
 
 class ProjectilePool;
+class TeamComponent;
 class Game;
 
 using namespace pk;
@@ -22,27 +29,46 @@ struct AlienTypeData
 {
 	std::string ConfigFile;
 	std::string TextureName;
+	int Score;
 
-	AlienTypeData() = default;
+	AlienTypeData() : Score(0) {}
 	AlienTypeData(std::string InConfigFile, std::string InTextureName)
-		: ConfigFile(std::move(InConfigFile)), TextureName(std::move(InTextureName)) {}
+		: ConfigFile(std::move(InConfigFile)), TextureName(std::move(InTextureName)), Score(0) {}
 };
 
-class AlienGroup : public Actor
+// Alive aliens of one type, drawn with a single instanced call.
+struct AlienInstanceRange
+{
+	AlienType Type;
+	int First;
+	int Count;
+
+	AlienInstanceRange(AlienType InType, int InFirst)
+		: Type(InType), First(InFirst), Count(0) {}
+};
+
+// The formation is one actor: a group origin, a grid of local offsets and an alive bitmask.
+class AlienGroup : public Actor, public IDamageable
 {
 public:
 	typedef std::shared_ptr<AlienGroup> SharedPtr;
 	typedef std::weak_ptr<Game> GameWeakPtr;
 	typedef std::shared_ptr<Game> GameSharedPtr;
-	typedef std::vector<Alien::SharedPtr> AlienList;
+	typedef std::shared_ptr<TeamComponent> TeamComponentPtr;
 	typedef std::map<AlienType, AlienTypeData> ConfigMap;
 	typedef std::pair<AlienType, AlienTypeData> ConfigMapPair;
-	typedef std::function<void()> OnReachedPlayerDelegate;
-	typedef std::function<void()> OnDefeatDelegate;
+	typedef MulticastDelegate<void(), 4> OnReachedPlayerEvent;
+	typedef MulticastDelegate<void(), 4> OnDefeatEvent;
+	typedef OnReachedPlayerEvent::DelegateType OnReachedPlayerDelegate;
+	typedef OnDefeatEvent::DelegateType OnDefeatDelegate;
 
 	static const int DEFAULT_NUM_ROWS_PER_TYPE;
 	static const int DEFAULT_ALIEN_PER_ROW;
 	static const int DEFAULT_MAX_SHOOTING_ALIEN;
+	static const int DEFAULT_BURST_COUNT;
+	static const int DEFAULT_SHOOT_SEED;
+	static const float DEFAULT_BURST_INTERVAL;
+	static const std::string DEFAULT_VOLLEY_PATTERN;
 	static const float DEFAULT_TOP_OFFSET;
 	static const float DEFAULT_MIN_MOVE_DELAY;
 	static const float DEFAULT_MAX_MOVE_DELAY;
@@ -53,6 +79,7 @@ public:
 	static const float DEFAULT_H_DISTANCE;
 	static const float DEFAULT_V_DISTANCE;
 	static const glm::vec3 DEFAULT_ALIEN_SIZE;
+	static const pk::ClassSettings::Schema SETTINGS_SCHEMA;
 
 	AlienGroup();
 
@@ -61,6 +88,9 @@ public:
 	int GetNumRowsTotal() const;
 	int GetNumAlienPerRow() const;
 	int GetMaxShootingAlien() const;
+	VolleyPattern GetVolleyPattern() const;
+	int GetBurstCount() const;
+	float GetBurstInterval() const;
 	float GetTopOffset() const;
 	float GetMinMoveDelay() const;
 	float GetMaxMoveDelay() const;
@@ -73,9 +103,20 @@ public:
 	float GetAliveRatio() const;
 	glm::vec3 GetAlienSize() const;
 
+	int GetNumAliens() const;
+	int GetNumAliveAliens() const;
+	bool IsAlienAlive(int Index) const;
+	int GetScore(int Index) const;
+	glm::vec3 GetAlienLocation(int Index) const;
+
 	void SetNumRowsPerType(int InNum);
 	void SetNumAlienPerRow(int InNum);
 	void SetMaxShootingAlien(int InNum);
+	void SetVolleyPattern(VolleyPattern InPattern);
+	void SetBurstCount(int InCount);
+	void SetBurstInterval(float InInterval);
+	// Zero draws a fresh seed, any other value replays the same volleys.
+	void SetShootSeed(int InSeed);
 	void SetTopOffset(float InOffset);
 	void SetMinMoveDelay(float InMoveDelay);
 	void SetMaxMoveDelay(float InMoveDelay);
@@ -90,33 +131,54 @@ public:
 	void SetProjectilePool(const std::shared_ptr<ProjectilePool>& InProjectilePool);
 
 	void LoadConfig() override;
+	void OnConfigReloaded() override;
 	void Begin() override;
 	void Update(const float Delta) override;
+	void Render() const override;
+
+	// Grid lookup of the cells under the other actor, HitIndex is the alien that was hit.
+	bool Collide(const Actor& Other, CollisionResult& OutResult) const override;
+	bool TakeDamage(float InDamage) override;
+	bool TakeDamage(float InDamage, const CollisionResult& Result) override;
+	IDamageable* AsDamageable() override;
 
 	void StartGroup();
 
-	void AddOnReachedPlayerDelegate(const OnReachedPlayerDelegate& InFunction);
-	void AddOnDefeatDelegate(const OnDefeatDelegate& InFunction);
+	DelegateHandle AddOnReachedPlayerDelegate(const OnReachedPlayerDelegate& InFunction);
+	DelegateHandle AddOnDefeatDelegate(const OnDefeatDelegate& InFunction);
+	void RemoveOnReachedPlayerDelegate(DelegateHandle& Handle);
+	void RemoveOnDefeatDelegate(DelegateHandle& Handle);
 
 	void InvadersWon();
-	void HideBoard() const;
+	void HideBoard();
 
 private:
 	void PlayNextTrack() const;
+	void LoadTypeConfigs();
 	void BuildMatrix();
 	void BuildMatrixPerType(AlienType Type);
+	void BuildOffsets();
+	void ReviveAll();
+	void KillAlien(int Index);
+	void UpdateInstances() const;
+	glm::vec2 GetCellStride() const;
 	bool ReachedEnd() const;
 	bool ReachedPlayer() const;
-	void UpdateOuterColsAndRow();
-	void MoveAliens(const float Delta);
+	void MoveAliens();
 
 	void GenerateShootCooldown();
-	void Shoot() const;
-
-	void UpdateShootCooldown(const float Delta);
-	void UpdateMoveDelay(const float Delta);
+	void Shoot();
+	void ShootFrom(int Index) const;
+	int GetAimCol() const;
+	void PlayExplosionAudio() const;
+
+	void StartTimers();
+	void StopTimers();
+	void OnShootTimer();
+	void OnBurstTimer();
+	void OnMoveTimer();
 	void GenerateMoveDelay();
-	void UpdateAliveAliens();
+	void CheckDefeat();
 
 	void NotifyReachedPlayer() const;
 	void NotifyDefeat() const;
@@ -127,19 +189,19 @@ private:
 	bool bGoDown;
 	int NumRowsPerType;
 	int NumAlienPerRow;
-	int OuterLeftCol;
-	int OuterRightCol;
-	int LastRow;
 	int MaxShootingAlien;
+	VolleyPattern Pattern;
+	int BurstCount;
+	int BurstShotsLeft;
+	int BurstShooter;
+	float BurstInterval;
 	float TopOffset;
 	float MinMoveDelay;
 	float MaxMoveDelay;
 	float SelectedMoveDelay;
-	float CurrentDelay;
 	float ShootMaxCooldown;
 	float ShootMinCooldown;
 	float SelectedShootCooldown;
-	float CurrentShootCooldown;
 	float HorizontalMoveStep;
 	float VerticalMoveStep;
 	float HorizontalDistance;
@@ -148,13 +210,28 @@ private:
 
 	std::shared_ptr<ProjectilePool> ProjectilePoolPtr;
 
-	AlienList AllAliens;
-	std::vector<int> AliveAliensIdx;
+	TeamComponentPtr TeamPtr;
+
+	std::vector<AlienType> RowTypes;
+	std::vector<glm::vec2> CellOffsets;
+	AlienFormation Formation;
+	// Reserved for a full front line in BuildMatrix, a volley never allocates.
+	std::vector<int> VolleyShooters;
+	Random::REngine ShootEngine;
+
+	mutable InstanceBuffer Instances;
+	mutable std::vector<glm::vec2> InstanceOffsets;
+	mutable std::vector<AlienInstanceRange> InstanceRanges;
+	mutable bool bInstancesDirty;
 
 	ConfigMap ConfigTypeMapping;
 
-	std::vector<OnReachedPlayerDelegate> OnReachedPlayerFunctions;
-	std::vector<OnDefeatDelegate> OnDefeatFunctions;
+	OnReachedPlayerEvent OnReachedPlayerFunctions;
+	OnDefeatEvent OnDefeatFunctions;
+
+	TimerHandle ShootTimer;
+	TimerHandle MoveTimer;
+	TimerHandle BurstTimer;
 
 	GroupState State;
 	GameWeakPtr GamePtr;
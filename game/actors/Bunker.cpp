@@ -1,20 +1,54 @@
 #include "Bunker.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <glad/glad.h>
 
-#include "Brick.h"
 #include "../Assets.h"
-#include "../../pk/core/world/Scene.h"
+#include "../components/TeamComponent.h"
+#include "../../pk/core/asset/AssetManager.h"
+#include "../../pk/core/asset/Texture.h"
+#include "../../pk/core/render/CachedLayer.h"
+#include "../../pk/core/render/Renderer.h"
 #include "../../pk/core/utils/ClassSettingsReader.h"
 
 const glm::vec3 Bunker::DEFAULT_BRICK_SIZE = glm::vec3(15.f, 15.f, 1.f);
 const glm::vec4 Bunker::DEFAULT_BRICK_COLOR = Colors::White;
+const int Bunker::DEFAULT_RESOLUTION = 8;
+const Bunker::SchemeType Bunker::DAMAGE_SPLAT = {
+	"*  * *  ",
+	"  ***  *",
+	" ****** ",
+	"********",
+	"******* ",
+	" ****** ",
+	"*  ** * ",
+	" *  *  *",
+};
+
+using namespace Assets;
+
+Bunker::Bunker()
+	: Bunker(Transform())
+{
+}
 
 Bunker::Bunker(const Transform& InTransform)
 	: Actor(InTransform),
-		BrickSize(DEFAULT_BRICK_SIZE), BrickColor(DEFAULT_BRICK_COLOR)
+		BrickSize(DEFAULT_BRICK_SIZE), BrickColor(DEFAULT_BRICK_COLOR), Resolution(DEFAULT_RESOLUTION),
+		PixelWidth(0), PixelHeight(0), WordsPerRow(0), DirtyFirstRow(-1), DirtyLastRow(-1)
 {
+	AddTypeTag<Bunker>();
+	HasCollision(true);
+	SetCollisionVolume(true);
+	SetRenderLayer(RenderLayer::Bunkers);
+
+	TeamPtr = std::make_shared<TeamComponent>(weak_from_this());
+	TeamPtr->SetTeam(Team::Brick);
+	AddComponent(TeamPtr);
+
 	BuildScheme();
+	UpdateSize();
 }
 
 Bunker::Bunker(const glm::vec3& InLocation, const glm::vec3& InSize)
@@ -25,6 +59,7 @@ Bunker::Bunker(const glm::vec3& InLocation, const glm::vec3& InSize)
 void Bunker::SetBrickSize(const glm::vec3& InSize)
 {
 	BrickSize = glm::abs(InSize);
+	UpdateSize();
 }
 
 void Bunker::SetBrickColor(const glm::vec4& InColor)
@@ -32,6 +67,11 @@ void Bunker::SetBrickColor(const glm::vec4& InColor)
 	BrickColor = glm::abs(InColor);
 }
 
+void Bunker::SetResolution(int InResolution)
+{
+	Resolution = std::max(1, InResolution);
+}
+
 glm::vec3 Bunker::GetBrickSize() const
 {
 	return BrickSize;
@@ -42,6 +82,55 @@ glm::vec4 Bunker::GetBrickColor() const
 	return BrickColor;
 }
 
+void Bunker::SetCachedLayer(const CachedLayerPtr& InLayer)
+{
+	Layer = InLayer;
+	if (Layer != nullptr)
+	{
+		Layer->Invalidate();
+	}
+}
+
+int Bunker::GetResolution() const
+{
+	return Resolution;
+}
+
+int Bunker::GetPixelWidth() const
+{
+	return PixelWidth;
+}
+
+int Bunker::GetPixelHeight() const
+{
+	return PixelHeight;
+}
+
+int Bunker::CountSolidPixels() const
+{
+	int Totals = 0;
+	for (std::uint64_t Word : Pixels)
+	{
+		while (Word != 0)
+		{
+			Word &= Word - 1;
+			Totals++;
+		}
+	}
+
+	return Totals;
+}
+
+bool Bunker::IsSolid(int Col, int Row) const
+{
+	if (Col < 0 || Col >= PixelWidth || Row < 0 || Row >= PixelHeight)
+	{
+		return false;
+	}
+
+	return (Pixels[Row * WordsPerRow + (Col >> 6)] & (1ull << (Col & 63))) != 0;
+}
+
 void Bunker::LoadConfig()
 {
 	Actor::LoadConfig();
@@ -52,64 +141,161 @@ void Bunker::LoadConfig()
 		return;
 	}
 
+	int InResolution;
 	glm::vec3 InBrickSize(DEFAULT_BRICK_SIZE);
 	glm::vec4 InBrickColor(DEFAULT_BRICK_COLOR);
 	BunkerSettings->Get("BrickSize", InBrickSize);
 	BunkerSettings->Get("BrickColor", InBrickColor);
+	BunkerSettings->Get("Resolution", DEFAULT_RESOLUTION, InResolution);
 
 	SetBrickSize(InBrickSize);
 	SetBrickColor(InBrickColor);
+	SetResolution(InResolution);
+}
+
+void Bunker::OnConfigReloaded()
+{
+	const int OldResolution = Resolution;
+	LoadConfig();
+
+	if (Layer != nullptr)
+	{
+		Layer->Invalidate();
+	}
+
+	// Damage can't be mapped onto a different resolution, the bunker comes back whole.
+	if (OldResolution != Resolution)
+	{
+		Build();
+	}
 }
 
 void Bunker::Begin()
 {
 	Actor::Begin();
 
-	InitializeBricks();
 	Build();
 }
 
-void Bunker::Build() const
+void Bunker::Render() const
 {
-	Scene::SharedPtr CurrentScene = GetScene();
-	if (CurrentScene == nullptr)
+	if (Layer == nullptr)
+	{
+		RenderBricks();
+	}
+}
+
+void Bunker::RenderBricks() const
+{
+	if (Pixels.empty())
 	{
-		std::cout << "Cannot build bunker. Empty scene\n";
 		return;
 	}
 
-	const int Rows = static_cast<int>(Scheme.size());
-	const int Cols = static_cast<int>(Scheme[0].length());
+	if (BunkerTexture == nullptr || BunkerTexture->GetWidth() != PixelWidth || BunkerTexture->GetHeight() != PixelHeight)
+	{
+		BunkerTexture = std::make_shared<Texture>(PixelWidth, PixelHeight, GL_RGBA, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, GL_NEAREST, GL_NEAREST);
+		MarkDirty(0, PixelHeight - 1);
+	}
 
-	const glm::vec3 BunkerCenter(GetLocation());
+	UploadDirtyRows();
 
-	const float StartX = ((static_cast<float>(Cols) / 2) * BrickSize.x) - BrickSize.x / 2;
-	const float StartY = (static_cast<float>(Rows) / 2) * BrickSize.y;
+	const Shader::SharedPtr SpriteShader = AssetManager::Get().GetShader(Shaders::SpriteName);
+	Renderer::Get().RenderSprite(SpriteShader, BunkerTexture, GetRenderModel(), glm::vec3(BrickColor));
+}
 
-	int BrickIndex = 0;
-	glm::vec3 StartLocation(BunkerCenter.x - StartX, BunkerCenter.y - StartY, 1.f);
-	for (const std::string& SchemeRow : Scheme)
+bool Bunker::Collide(const Actor& Other, CollisionResult& OutResult) const
+{
+	if (Pixels.empty() || !Actor::Collide(Other, OutResult))
 	{
-		for (int i = 0; i < SchemeRow.length(); ++i)
+		return false;
+	}
+
+	OutResult.bHit = false;
+
+	const glm::vec3 Size(GetSize());
+	const glm::vec2 PixelSize(Size.x / static_cast<float>(PixelWidth), Size.y / static_cast<float>(PixelHeight));
+	if (PixelSize.x <= 0.f || PixelSize.y <= 0.f)
+	{
+		return false;
+	}
+
+	const BoundingBox OtherBox(Other.GetBoundingBox());
+	const glm::vec3 Corner = GetLocation() - (Size / 2.f);
+
+	const int FirstCol = std::max(0, static_cast<int>(std::floor((OtherBox.Left() - Corner.x) / PixelSize.x)));
+	const int LastCol = std::min(PixelWidth - 1, static_cast<int>(std::floor((OtherBox.Right() - Corner.x) / PixelSize.x)));
+	const int FirstRow = std::max(0, static_cast<int>(std::floor((OtherBox.Top() - Corner.y) / PixelSize.y)));
+	const int LastRow = std::min(PixelHeight - 1, static_cast<int>(std::floor((OtherBox.Bottom() - Corner.y) / PixelSize.y)));
+
+	// Whatever moves up meets the bottom of the bunker first.
+	const bool bMovingUp = Other.GetVelocity().y < 0.f;
+	for (int Step = 0; Step <= LastRow - FirstRow; ++Step)
+	{
+		const int Row = bMovingUp ? LastRow - Step : FirstRow + Step;
+		for (int Col = FirstCol; Col <= LastCol; ++Col)
 		{
-			const char Char = SchemeRow[i];
-			if (Char == '*')
+			if (IsSolid(Col, Row))
 			{
-				Brick::SharedPtr CurrentBrick = Bricks[BrickIndex];
-				CurrentBrick->CancelDestroy();
-				CurrentBrick->SetLocation(StartLocation);
-				CurrentScene->Add(CurrentBrick);
-				BrickIndex++;
+				OutResult.bHit = true;
+				OutResult.ImpactLocation = GetPixelLocation(Col, Row);
+				OutResult.HitIndex = Row * PixelWidth + Col;
+				return true;
 			}
+		}
+	}
+
+	return false;
+}
+
+bool Bunker::TakeDamage(float /*InDamage*/)
+{
+	// Without a collision result there is no way to tell where the bunker was hit.
+	return false;
+}
+
+bool Bunker::TakeDamage(float /*InDamage*/, const CollisionResult& Result)
+{
+	if (Result.HitIndex < 0 || Result.HitIndex >= PixelWidth * PixelHeight)
+	{
+		return false;
+	}
+
+	Erode(Result.HitIndex % PixelWidth, Result.HitIndex / PixelWidth);
+	return true;
+}
 
-			StartLocation.x += BrickSize.x;
-			if ((i + 1) % Cols == 0)
+IDamageable* Bunker::AsDamageable()
+{
+	return this;
+}
+
+void Bunker::Build()
+{
+	const int Rows = static_cast<int>(Scheme.size());
+	const int Cols = static_cast<int>(Scheme[0].length());
+
+	PixelWidth = Cols * Resolution;
+	PixelHeight = Rows * Resolution;
+	WordsPerRow = (PixelWidth + 63) / 64;
+
+	Pixels.assign(WordsPerRow * PixelHeight, 0);
+	Texels.assign(PixelWidth * PixelHeight * 4, 0);
+
+	for (int Row = 0; Row < PixelHeight; ++Row)
+	{
+		const std::string& SchemeRow = Scheme[Row / Resolution];
+		for (int Col = 0; Col < PixelWidth; ++Col)
+		{
+			if (SchemeRow[Col / Resolution] == '*')
 			{
-				StartLocation.x = BunkerCenter.x - StartX;
-				StartLocation.y += BrickSize.y;
+				SetSolid(Col, Row, true);
 			}
 		}
 	}
+
+	MarkDirty(0, PixelHeight - 1);
+	UpdateSize();
 }
 
 void Bunker::BuildScheme()
@@ -123,22 +309,88 @@ void Bunker::BuildScheme()
 	};
 }
 
-void Bunker::InitializeBricks()
+void Bunker::UpdateSize()
+{
+	const float Rows = static_cast<float>(Scheme.size());
+	const float Cols = static_cast<float>(Scheme[0].length());
+	SetSize(glm::vec3(Cols * BrickSize.x, Rows * BrickSize.y, 1.f));
+}
+
+void Bunker::SetSolid(int Col, int Row, bool bSolid)
 {
-	Bricks.clear();
+	const std::uint64_t Bit = 1ull << (Col & 63);
+	std::uint64_t& Word = Pixels[Row * WordsPerRow + (Col >> 6)];
+	Word = bSolid ? (Word | Bit) : (Word & ~Bit);
 
-	const int Rows = 5;
-	const int Cols = 6;
-	int Totals = Rows * Cols;
-	Totals -= Cols - 2 - 2;
+	unsigned char* Texel = &Texels[(Row * PixelWidth + Col) * 4];
+	Texel[0] = Texel[1] = Texel[2] = 255;
+	Texel[3] = bSolid ? 255 : 0;
+}
+
+void Bunker::Erode(int CenterCol, int CenterRow)
+{
+	// The splat covers one brick whatever the resolution, so damage looks the same at any grain.
+	const int SplatRows = static_cast<int>(DAMAGE_SPLAT.size());
+	const int SplatCols = static_cast<int>(DAMAGE_SPLAT[0].length());
+	const int StartCol = CenterCol - Resolution / 2;
+	const int StartRow = CenterRow - Resolution / 2;
+
+	for (int y = 0; y < Resolution; ++y)
+	{
+		const int Row = StartRow + y;
+		if (Row < 0 || Row >= PixelHeight)
+		{
+			continue;
+		}
+
+		const std::string& SplatRow = DAMAGE_SPLAT[y * SplatRows / Resolution];
+		for (int x = 0; x < Resolution; ++x)
+		{
+			const int Col = StartCol + x;
+			if (SplatRow[x * SplatCols / Resolution] == '*' && IsSolid(Col, Row))
+			{
+				SetSolid(Col, Row, false);
+			}
+		}
+	}
 
+	MarkDirty(std::max(0, StartRow), std::min(PixelHeight - 1, StartRow + Resolution - 1));
+}
 
-	for (int i = 0; i < Totals; ++i)
+void Bunker::MarkDirty(int FirstRow, int LastRow) const
+{
+	if (FirstRow > LastRow)
 	{
-		Brick::SharedPtr InBrick = std::make_shared<Brick>();
-		InBrick->SetShader(Assets::Shaders::ShapeName);
-		InBrick->SetColor(BrickColor);
-		InBrick->SetSize(BrickSize);
-		Bricks.push_back(InBrick);
+		return;
 	}
+
+	DirtyFirstRow = DirtyFirstRow < 0 ? FirstRow : std::min(DirtyFirstRow, FirstRow);
+	DirtyLastRow = std::max(DirtyLastRow, LastRow);
+
+	if (Layer != nullptr)
+	{
+		Layer->Invalidate();
+	}
+}
+
+void Bunker::UploadDirtyRows() const
+{
+	if (DirtyFirstRow < 0)
+	{
+		return;
+	}
+
+	const int NumRows = DirtyLastRow - DirtyFirstRow + 1;
+	BunkerTexture->UpdateRows(&Texels[DirtyFirstRow * PixelWidth * 4], DirtyFirstRow, NumRows);
+
+	DirtyFirstRow = -1;
+	DirtyLastRow = -1;
+}
+
+glm::vec3 Bunker::GetPixelLocation(int Col, int Row) const
+{
+	const glm::vec3 Corner = GetLocation() - (GetSize() / 2.f);
+	const float PixelX = GetSize().x / static_cast<float>(PixelWidth);
+	const float PixelY = GetSize().y / static_cast<float>(PixelHeight);
+	return glm::vec3(Corner.x + (static_cast<float>(Col) + .5f) * PixelX, Corner.y + (static_cast<float>(Row) + .5f) * PixelY, GetLocation().z);
 }
@@ -1,45 +1,94 @@
 #pragma once
 
+#include <cstdint>
+
 #include "../../pk/core/world/Actor.h"
+#include "../../pk/core/interfaces/IDamageable.h"
+
+namespace pk
+{
+	class Texture;
+	class CachedLayer;
+}
 
-class Brick;
+class TeamComponent;
 
 using namespace pk;
 
-class Bunker : public Actor
+// The whole bunker is one occupancy bitmap, every brick of the scheme is Resolution x Resolution pixels.
+class Bunker : public Actor, public IDamageable
 {
 public:
 	typedef std::shared_ptr<Bunker> SharedPtr;
-	typedef std::shared_ptr<Brick> BrickSharedPtr;
-	typedef std::vector<BrickSharedPtr> BrickList;
+	typedef std::shared_ptr<Texture> TextureSharedPtr;
+	typedef std::shared_ptr<TeamComponent> TeamComponentPtr;
+	typedef std::shared_ptr<CachedLayer> CachedLayerPtr;
 	typedef std::vector<std::string> SchemeType;
 
 	static const glm::vec3 DEFAULT_BRICK_SIZE;
 	static const glm::vec4 DEFAULT_BRICK_COLOR;
+	static const int DEFAULT_RESOLUTION;
+	static const SchemeType DAMAGE_SPLAT;
 
-	Bunker() = default;
+	Bunker();
 	Bunker(const Transform& InTransform);
 	Bunker(const glm::vec3& InLocation, const glm::vec3& InSize);
 
 	void SetBrickSize(const glm::vec3& InSize);
 	void SetBrickColor(const glm::vec4& InColor);
+	void SetResolution(int InResolution);
+	// Once set the bunker no longer draws itself, the layer's owner composites it and redraws through RenderBricks.
+	void SetCachedLayer(const CachedLayerPtr& InLayer);
 
 	glm::vec3 GetBrickSize() const;
 	glm::vec4 GetBrickColor() const;
+	int GetResolution() const;
+	int GetPixelWidth() const;
+	int GetPixelHeight() const;
+	int CountSolidPixels() const;
+	bool IsSolid(int Col, int Row) const;
 
 	void LoadConfig() override;
+	void OnConfigReloaded() override;
 	void Begin() override;
+	void Render() const override;
+	void RenderBricks() const;
+
+	// Bounds test first, then the bitmap under the other box, HitIndex is the first solid pixel met.
+	bool Collide(const Actor& Other, CollisionResult& OutResult) const override;
+	bool TakeDamage(float InDamage) override;
+	bool TakeDamage(float InDamage, const CollisionResult& Result) override;
+	IDamageable* AsDamageable() override;
 
-	void Build() const;
+	void Build();
 
 	~Bunker() override = default;
 private:
 	void BuildScheme();
-	void InitializeBricks();
+	void UpdateSize();
+	void SetSolid(int Col, int Row, bool bSolid);
+	void Erode(int CenterCol, int CenterRow);
+	void MarkDirty(int FirstRow, int LastRow) const;
+	void UploadDirtyRows() const;
+	glm::vec3 GetPixelLocation(int Col, int Row) const;
 
 	glm::vec3 BrickSize;
 	glm::vec4 BrickColor;
+	int Resolution;
 
 	SchemeType Scheme;
-	BrickList Bricks;
+	TeamComponentPtr TeamPtr;
+
+	int PixelWidth;
+	int PixelHeight;
+	int WordsPerRow;
+	std::vector<std::uint64_t> Pixels;
+
+	// Texels mirror the bitmap, only rows touched since the last render are uploaded.
+	mutable std::vector<unsigned char> Texels;
+	mutable TextureSharedPtr BunkerTexture;
+	mutable int DirtyFirstRow;
+	mutable int DirtyLastRow;
+
+	CachedLayerPtr Layer;
 };
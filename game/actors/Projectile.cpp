@@ -7,7 +7,11 @@
 
 Projectile::Projectile()
 {
+	AddTypeTag<Projectile>();
 	HasCollision(true);
+	// Gone once it leaves the screen, the scene's cull pass takes care of it.
+	SetDestroyOffscreen(true);
+	SetRenderLayer(RenderLayer::Projectiles);
 
 	TeamPtr = std::make_shared<TeamComponent>(weak_from_this());
 	AddComponent(TeamPtr);
@@ -41,30 +45,36 @@ bool Projectile::TakeDamage(float InDamage)
 	return true;
 }
 
-void Projectile::AddOnHitDelegate(const OnHitDelegate& InDelegate)
+IDamageable* Projectile::AsDamageable()
 {
-	OnHitFunctions.push_back(InDelegate);
+	return this;
 }
 
-void Projectile::AddOnDestroyDelegate(const OnDestroyDelegate& InDelegate)
+DelegateHandle Projectile::AddOnHitDelegate(const OnHitDelegate& InDelegate)
 {
-	OnDestroyFunctions.push_back(InDelegate);
+	return OnHitFunctions.Add(InDelegate);
 }
 
-void Projectile::OnActorHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result)
+DelegateHandle Projectile::AddOnDestroyDelegate(const OnDestroyDelegate& InDelegate)
 {
-	Actor::OnActorHit(HitActor, Result);
+	return OnDestroyFunctions.Add(InDelegate);
+}
 
-	OnHit(HitActor, Result);
+void Projectile::RemoveOnHitDelegate(DelegateHandle& Handle)
+{
+	OnHitFunctions.Remove(Handle);
 }
 
-void Projectile::Update(const float Delta)
+void Projectile::RemoveOnDestroyDelegate(DelegateHandle& Handle)
 {
-	Actor::Update(Delta);
-	if (!IsInViewport())
-	{
-		Destroy();
-	}
+	OnDestroyFunctions.Remove(Handle);
+}
+
+void Projectile::OnActorHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result)
+{
+	Actor::OnActorHit(HitActor, Result);
+
+	OnHit(HitActor, Result);
 }
 
 void Projectile::Destroy()
@@ -72,44 +82,36 @@ void Projectile::Destroy()
 	NotifyDestroy();
 
 	Actor::Destroy();
-	OnHitFunctions.clear();
-	OnDestroyFunctions.clear();
 }
 
 Projectile::~Projectile() = default;
 
 void Projectile::OnHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result)
 {
-	const TeamComponentPtr HitTeamComponent = HitActor->GetComponent<TeamComponent>();
+	const TeamComponent* HitTeamComponent = HitActor->GetComponent<TeamComponent>();
 	// Skip same team
 	if (!HitTeamComponent || GetTeam() == HitTeamComponent->GetTeam())
 	{
 		return;
 	}
 
-	std::shared_ptr<IDamageable> DamageableActor = std::dynamic_pointer_cast<IDamageable>(HitActor);
+	IDamageable* DamageableActor = HitActor->AsDamageable();
 	if (!DamageableActor)
 	{
 		return;
 	}
 
 	NotifyHit(HitActor, Result);
-	DamageableActor->TakeDamage(0.f);
+	DamageableActor->TakeDamage(0.f, Result);
 	Destroy();
 }
 
 void Projectile::NotifyHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result) const
 {
-	for (const OnHitDelegate& Delegate : OnHitFunctions)
-	{
-		Delegate(HitActor, Result);
-	}
+	OnHitFunctions.Broadcast(HitActor, Result);
 }
 
 void Projectile::NotifyDestroy() const
 {
-	for (const OnDestroyDelegate& Delegate : OnDestroyFunctions)
-	{
-		Delegate();
-	}
+	OnDestroyFunctions.Broadcast();
 }
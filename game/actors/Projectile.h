@@ -2,11 +2,9 @@
 
 #include "../../pk/core/world/Actor.h"
 #include "../../pk/core/interfaces/IDamageable.h"
+#include "../../pk/core/utils/Delegate.h"
 #include "../Types.h"
 
-#include <functional>
-#include <vector>
-
 class TeamComponent;
 
 using namespace pk;
@@ -14,8 +12,12 @@ using namespace pk;
 class Projectile : public Actor, public IDamageable
 {
 public:
-	typedef std::function<void(const Actor::SharedPtr& HitActor, const CollisionResult& Result)> OnHitDelegate;
-	typedef std::function<void()> OnDestroyDelegate;
+	static const std::size_t MAX_OBSERVERS = 4;
+
+	typedef MulticastDelegate<void(const Actor::SharedPtr& HitActor, const CollisionResult& Result), MAX_OBSERVERS> OnHitEvent;
+	typedef MulticastDelegate<void(), MAX_OBSERVERS> OnDestroyEvent;
+	typedef OnHitEvent::DelegateType OnHitDelegate;
+	typedef OnDestroyEvent::DelegateType OnDestroyDelegate;
 	typedef std::shared_ptr<Projectile> SharedPtr;
 	typedef std::shared_ptr<TeamComponent> TeamComponentPtr;
 
@@ -27,14 +29,15 @@ public:
 	Team GetTeam() const;
 
 	bool TakeDamage(float InDamage) override;
+	IDamageable* AsDamageable() override;
 
-	void AddOnHitDelegate(const OnHitDelegate& InDelegate);
-	void AddOnDestroyDelegate(const OnDestroyDelegate& InDelegate);
+	DelegateHandle AddOnHitDelegate(const OnHitDelegate& InDelegate);
+	DelegateHandle AddOnDestroyDelegate(const OnDestroyDelegate& InDelegate);
+	void RemoveOnHitDelegate(DelegateHandle& Handle);
+	void RemoveOnDestroyDelegate(DelegateHandle& Handle);
 
 	void OnActorHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result) override;
 
-	void Update(const float Delta) override;
-
 	void Destroy() override;
 
 	~Projectile() override;
@@ -45,6 +48,6 @@ private:
 	void NotifyDestroy() const;
 
 	TeamComponentPtr TeamPtr;
-	std::vector<OnHitDelegate> OnHitFunctions;
-	std::vector<OnDestroyDelegate> OnDestroyFunctions;
+	OnHitEvent OnHitFunctions;
+	OnDestroyEvent OnDestroyFunctions;
 };
@@ -15,9 +15,15 @@ const glm::vec3 Secret::DEFAULT_ALIEN_SIZE = glm::vec3(40.f, 20.f, 1.f);
 
 Secret::Secret()
 	: SpawnAudioChannel(0), bAlienActive(false), SpawnTimeMin(DEFAULT_SPAWN_TIME_MIN), SpawnTimeMax(DEFAULT_SPAWN_TIME_MAX),
-		SelectedSpawnTime(0.f), CurrentSpawnTime(0.f), AlienSpeed(DEFAULT_ALIEN_SPEED),
-		TopOffset(DEFAULT_ALIEN_TOP_OFFSET), AlienSize(DEFAULT_ALIEN_SIZE)
+		SelectedSpawnTime(0.f), AlienSpeed(DEFAULT_ALIEN_SPEED),
+		TopOffset(DEFAULT_ALIEN_TOP_OFFSET), AlienSize(DEFAULT_ALIEN_SIZE), CurrentAlienIndex(-1)
 {
+	AddTypeTag<Secret>();
+
+	// Only one bonus alien flies at a time.
+	AlienPool.SetGrowth(PoolGrowth::Fixed);
+	AlienPool.SetFactory([this](int Index) { return CreateAlien(Index); });
+	AlienPool.SetOnAcquire([](Alien& InAlien) { InAlien.CancelDestroy(); });
 }
 
 float Secret::GetSpawnTimeMin() const
@@ -108,7 +114,7 @@ void Secret::Begin()
 {
 	Actor::Begin();
 
-	CreateAlien();
+	AlienPool.Reserve(1);
 	SelectSpawnTime();
 	GamePtr = std::dynamic_pointer_cast<Game>(GetScene());
 }
@@ -118,13 +124,12 @@ void Secret::Update(const float Delta)
 	Actor::Update(Delta);
 
 	UpdateAlien();
-	UpdateSpawnTime(Delta);
 }
 
 void Secret::Reset()
 {
 	bAlienActive = false;
-	CurrentAlien->Destroy();
+	ReleaseAlien();
 	StopSpawnAudio();
 	SelectSpawnTime();
 }
@@ -132,21 +137,9 @@ void Secret::Reset()
 void Secret::SelectSpawnTime()
 {
 	SelectedSpawnTime = Random::Get(SpawnTimeMin, SpawnTimeMax);
-}
 
-void Secret::UpdateSpawnTime(const float Delta)
-{
-	if (bAlienActive)
-	{
-		return;
-	}
-
-	CurrentSpawnTime += Delta;
-	if (CurrentSpawnTime >= SelectedSpawnTime)
-	{
-		SpawnAlien();
-		CurrentSpawnTime = 0.f;
-	}
+	ClearTimer(SpawnTimer);
+	SpawnTimer = SetTimer(SelectedSpawnTime, [this]() { SpawnAlien(); });
 }
 
 void Secret::UpdateAlien()
@@ -158,20 +151,20 @@ void Secret::UpdateAlien()
 
 	if (!CurrentAlien || !CurrentAlien->IsInViewport() || CurrentAlien->IsDestroyed())
 	{
-		CurrentAlien->Destroy();
+		ReleaseAlien();
 		bAlienActive = false;
 		StopSpawnAudio();
 		SelectSpawnTime();
 	}
 }
 
-void Secret::CreateAlien()
+Alien::SharedPtr Secret::CreateAlien(int Index) const
 {
-	CurrentAlien = std::make_shared<Alien>(AlienType::Secret);
-	CurrentAlien->SetConfig(Assets::Config::BonusAlienFile);
-	CurrentAlien->SetShader(Assets::Shaders::SpriteName);
-	CurrentAlien->SetTexture(Assets::Textures::SecretName);
-	CurrentAlien->SetSize(AlienSize);
+	Alien::SharedPtr NewAlien = std::make_shared<Alien>(AlienType::Secret);
+	NewAlien->SetConfig(Assets::Config::BonusAlienFile);
+	NewAlien->SetShader(Assets::Shaders::SpriteName);
+	NewAlien->SetTexture(Assets::Textures::SecretName);
+	return NewAlien;
 }
 
 void Secret::SpawnAlien()
@@ -192,16 +185,36 @@ void Secret::SpawnAlien()
 	const glm::vec3 Location(LocationX, (AlienSize.y / 2) + TopOffset, 0.f);
 	const glm::vec3 Velocity = Direction * AlienSpeed;
 
-	CurrentAlien->CancelDestroy();
+	CurrentAlien = AlienPool.Acquire(CurrentAlienIndex);
+	if (CurrentAlien == nullptr)
+	{
+		return;
+	}
+
+	CurrentAlien->SetSize(AlienSize);
 	CurrentAlien->SetLocation(Location);
 	CurrentAlien->SetVelocity(Velocity);
 
-	CurrentScene->Add(CurrentAlien);
+	CurrentScene->Activate(CurrentAlien);
 	PlaySpawnAudio();
 
 	bAlienActive = true;
 }
 
+void Secret::ReleaseAlien()
+{
+	if (CurrentAlien == nullptr)
+	{
+		return;
+	}
+
+	CurrentAlien->Destroy();
+	CurrentAlien = nullptr;
+
+	AlienPool.Release(CurrentAlienIndex);
+	CurrentAlienIndex = -1;
+}
+
 void Secret::PlaySpawnAudio()
 {
 	const GameSharedPtr CurrentGame = GetGame();
@@ -2,6 +2,7 @@
 
 #include "../../pk/core/world/Actor.h"
 #include "Alien.h"
+#include "../../pk/core/utils/ObjectPool.h"
 
 class Game;
 
@@ -42,10 +43,10 @@ public:
 
 private:
 	void SelectSpawnTime();
-	void UpdateSpawnTime(const float Delta);
 	void UpdateAlien();
-	void CreateAlien();
+	Alien::SharedPtr CreateAlien(int Index) const;
 	void SpawnAlien();
+	void ReleaseAlien();
 
 	void PlaySpawnAudio();
 	void StopSpawnAudio();
@@ -57,11 +58,13 @@ private:
 	float SpawnTimeMin;
 	float SpawnTimeMax;
 	float SelectedSpawnTime;
-	float CurrentSpawnTime;
+	TimerHandle SpawnTimer;
 	float AlienSpeed;
 	float TopOffset;
 	glm::vec3 AlienSize;
 
+	ObjectPool<Alien> AlienPool;
 	Alien::SharedPtr CurrentAlien;
+	int CurrentAlienIndex;
 	GameWeakPtr GamePtr;
 };
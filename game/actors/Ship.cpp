@@ -4,6 +4,7 @@
 #include <GLFW/glfw3.h>
 
 #include "Alien.h"
+#include "AlienGroup.h"
 #include "Projectile.h"
 #include "../Assets.h"
 #include "../scenes/Game.h"
@@ -18,13 +19,20 @@
 const float Ship::DEFAULT_SPEED = 450.f;
 const float Ship::DEFAULT_COOLDOWN = 1.f;
 const int Ship::DEFAULT_LIFE_POINTS = 3;
+const ClassSettings::Schema Ship::SETTINGS_SCHEMA = {
+	{ "Speed", ClassSettings::ValueType::Float },
+	{ "Cooldown", ClassSettings::ValueType::Float },
+	{ "LifePoints", ClassSettings::ValueType::Int },
+	{ "Color", ClassSettings::ValueType::Vec4 }
+};
 
 Ship::Ship(const Transform& InTransform)
 	: Actor(InTransform), bCanShoot(true), MaxSpeed(DEFAULT_SPEED), Speed(DEFAULT_SPEED),
-		ShootCooldown(DEFAULT_COOLDOWN), CurrentCooldown(0.f), bShouldCooldown(false),
+		ShootCooldown(DEFAULT_COOLDOWN),
 		MaxLifePoints(DEFAULT_LIFE_POINTS), LifePoints(DEFAULT_LIFE_POINTS),
 		ScorePoints(0)
 {
+	AddTypeTag<Ship>();
 	HasCollision(true);
 
 	TeamPtr = std::make_shared<TeamComponent>(weak_from_this());
@@ -107,7 +115,7 @@ void Ship::LoadConfig()
 {
 	Actor::LoadConfig();
 
-	ClassSettings::SharedConstPtr ShipSettings = ClassSettingsReader::Load(GetConfigFile());
+	ClassSettings::SharedConstPtr ShipSettings = ClassSettingsReader::Load(GetConfigFile(), SETTINGS_SCHEMA);
 
 	if (ShipSettings == nullptr)
 	{
@@ -130,7 +138,14 @@ void Ship::LoadConfig()
 	SetLifePoints(InLifePoints);
 	SetColor(SettingColor);
 
-	CurrentCooldown = 0.f;
+	ClearTimer(CooldownTimer);
+}
+
+void Ship::OnConfigReloaded()
+{
+	const int CurrentLifePoints = LifePoints;
+	LoadConfig();
+	SetLifePoints(CurrentLifePoints);
 }
 
 void Ship::Begin()
@@ -159,10 +174,10 @@ void Ship::Input(const InputHandler& Handler, const float Delta)
 
 	if ((Handler.IsPressed(GLFW_KEY_SPACE) 
 		|| Handler.IsPadPressed(GLFW_GAMEPAD_BUTTON_SQUARE)) 
-		&& CurrentCooldown <= 0.f
+		&& !IsTimerActive(CooldownTimer)
 	)
 	{
-		bShouldCooldown = true;
+		CooldownTimer = SetTimer(ShootCooldown, nullptr);
 		Shoot();
 	}
 
@@ -173,7 +188,6 @@ void Ship::Update(const float Delta)
 {
 	Actor::Update(Delta);
 
-	UpdateCooldown(Delta);
 	ConstraintInViewport(Delta);
 }
 
@@ -186,9 +200,19 @@ bool Ship::TakeDamage(float InDamage)
 	return false;
 }
 
-void Ship::AddOnTakeDamageObserver(const OnTakeDamageDelegate& Callback)
+IDamageable* Ship::AsDamageable()
+{
+	return this;
+}
+
+DelegateHandle Ship::AddOnTakeDamageObserver(const OnTakeDamageDelegate& Callback)
 {
-	OnTakeDamageFunctions.push_back(Callback);
+	return OnTakeDamageFunctions.Add(Callback);
+}
+
+void Ship::RemoveOnTakeDamageObserver(DelegateHandle& Handle)
+{
+	OnTakeDamageFunctions.Remove(Handle);
 }
 
 void Ship::ConstraintInViewport(const float Delta)
@@ -243,61 +267,60 @@ void Ship::Shoot()
 	glm::vec3 SpawnLocation(GetLocation());
 	SpawnLocation.y -= (GetSize().y / 2);
 
-	Projectile::SharedPtr NewProjectile = CurrentProjectilePool->Create(SpawnLocation, TeamPtr->GetTeam());
-	NewProjectile->AddOnHitDelegate([this](const Actor::SharedPtr& HitActor, const CollisionResult& Result)
+	ActiveProjectile = CurrentProjectilePool->Create(SpawnLocation, TeamPtr->GetTeam());
+	if (ActiveProjectile == nullptr)
+	{
+		return;
+	}
+
+	ProjectileHitHandle = ActiveProjectile->AddOnHitDelegate([this](const Actor::SharedPtr& HitActor, const CollisionResult& Result)
 		{
-			OnProjectileHit(HitActor);
+			OnProjectileHit(HitActor, Result);
 		}
 	);
-	NewProjectile->AddOnDestroyDelegate([this]()
+	ProjectileDestroyHandle = ActiveProjectile->AddOnDestroyDelegate([this]()
 		{
 			OnProjectileDestroy();
 		}
 	);
 
-	CurrentScene->Add(NewProjectile);
+	CurrentScene->Activate(ActiveProjectile);
 
 	PlayAudio(Assets::Sounds::ShootName, Assets::Sounds::OldShoot, 1.f);
 	bCanShoot = false;
 }
 
-void Ship::UpdateCooldown(const float Delta)
+void Ship::OnProjectileHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result)
 {
-	if (!bShouldCooldown)
+	if (HitActor->IsA<AlienGroup>())
 	{
+		ScorePoints += static_cast<const AlienGroup*>(HitActor.get())->GetScore(Result.HitIndex);
 		return;
 	}
 
-	CurrentCooldown += Delta;
-	if (CurrentCooldown >= ShootCooldown)
-	{
-		bShouldCooldown = false;
-		CurrentCooldown = 0.f;
-	}
-}
-
-void Ship::OnProjectileHit(const Actor::SharedPtr& HitActor)
-{
-	Alien::SharedPtr HitAlien = std::dynamic_pointer_cast<Alien>(HitActor);
-	if (HitAlien == nullptr)
+	if (!HitActor->IsA<Alien>())
 	{
 		return;
 	}
 
-	ScorePoints += HitAlien->GetScore();
+	ScorePoints += static_cast<const Alien*>(HitActor.get())->GetScore();
 }
 
 void Ship::OnProjectileDestroy()
 {
+	if (ActiveProjectile != nullptr)
+	{
+		ActiveProjectile->RemoveOnHitDelegate(ProjectileHitHandle);
+		ActiveProjectile->RemoveOnDestroyDelegate(ProjectileDestroyHandle);
+		ActiveProjectile = nullptr;
+	}
+
 	bCanShoot = true;
 }
 
 void Ship::NotifyOnTakeDamage() const
 {
-	for (const OnTakeDamageDelegate& Callback : OnTakeDamageFunctions)
-	{
-		Callback();
-	}
+	OnTakeDamageFunctions.Broadcast();
 }
 
 void Ship::PlayAudio(const std::string& Name, const std::string& FilePath, float Volume) const
@@ -1,10 +1,11 @@
 #pragma once
 
-#include <functional>
-
 #include "../../pk/core/world/Actor.h"
 #include "../../pk/core/interfaces/IDamageable.h"
+#include "../../pk/core/utils/ClassSettings.h"
+#include "../../pk/core/utils/Delegate.h"
 
+class Projectile;
 class ProjectilePool;
 class TeamComponent;
 class Game;
@@ -18,11 +19,14 @@ public:
 	typedef std::shared_ptr<TeamComponent> TeamComponentPtr;
 	typedef std::shared_ptr<Game> GameSharedPtr;
 	typedef std::weak_ptr<Game> GameWeakPtr;
-	typedef std::function<void()> OnTakeDamageDelegate;
+	typedef std::shared_ptr<Projectile> ProjectilePtr;
+	typedef MulticastDelegate<void(), 4> OnTakeDamageEvent;
+	typedef OnTakeDamageEvent::DelegateType OnTakeDamageDelegate;
 
 	static const float DEFAULT_SPEED;
 	static const float DEFAULT_COOLDOWN;
 	static const int DEFAULT_LIFE_POINTS;
+	static const pk::ClassSettings::Schema SETTINGS_SCHEMA;
 
 	Ship(const Transform& InTransform);
 	Ship(const glm::vec3& InLocation, const glm::vec3& InSize);
@@ -46,20 +50,22 @@ public:
 	void SetProjectilePool(const ProjectilePoolPtr& InProjectilePool);
 
 	void LoadConfig() override;
+	void OnConfigReloaded() override;
 	void Begin() override;
 	void Input(const InputHandler& Handler, const float Delta) override;
 	void Update(const float Delta) override;
 
 	bool TakeDamage(float InDamage) override;
+	IDamageable* AsDamageable() override;
 
-	void AddOnTakeDamageObserver(const OnTakeDamageDelegate& Callback);
+	DelegateHandle AddOnTakeDamageObserver(const OnTakeDamageDelegate& Callback);
+	void RemoveOnTakeDamageObserver(DelegateHandle& Handle);
 
 private:
 	void ConstraintInViewport(const float Delta);
 	void Shoot();
-	void UpdateCooldown(const float Delta);
 
-	void OnProjectileHit(const Actor::SharedPtr& HitActor);
+	void OnProjectileHit(const Actor::SharedPtr& HitActor, const CollisionResult& Result);
 	void OnProjectileDestroy();
 
 	void NotifyOnTakeDamage() const;
@@ -72,8 +78,7 @@ private:
 	float MaxSpeed;
 	float Speed;
 	float ShootCooldown;
-	float CurrentCooldown;
-	bool bShouldCooldown;
+	TimerHandle CooldownTimer;
 	int MaxLifePoints;
 	int LifePoints;
 	int ScorePoints;
@@ -81,8 +86,11 @@ private:
 	TeamComponentPtr TeamPtr;
 
 	ProjectilePoolPtr CurrentProjectilePool;
+	ProjectilePtr ActiveProjectile;
+	DelegateHandle ProjectileHitHandle;
+	DelegateHandle ProjectileDestroyHandle;
 
-	std::vector<OnTakeDamageDelegate> OnTakeDamageFunctions;
+	OnTakeDamageEvent OnTakeDamageFunctions;
 
 	GameWeakPtr GamePtr;
 };
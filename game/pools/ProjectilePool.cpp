@@ -13,16 +13,33 @@ const float ProjectilePool::DEFAULT_SPEED = 500.f;
 const float ProjectilePool::DEFAULT_PARTICLE_SPEED = 200.f;
 const float ProjectilePool::DEFAULT_PARTICLE_LIFE = 0.5f;
 const float ProjectilePool::DEFAULT_PARTICLE_SCALE = 5.f;
+const int ProjectilePool::DEFAULT_GPU_PARTICLE_CAPACITY = 256;
 const glm::vec3 ProjectilePool::DEFAULT_SIZE = glm::vec3(5.f, 10.f, 1.f);
 const glm::vec3 ProjectilePool::DEFAULT_DIRECTION = glm::vec3(0.f, 1.f, 0.f);
 const glm::vec4 ProjectilePool::DEFAULT_PARTICLE_COLOR = Colors::Red;
+const ClassSettings::Schema ProjectilePool::SETTINGS_SCHEMA = {
+	{ "PoolSize", ClassSettings::ValueType::Int },
+	{ "ProjectileSpeed", ClassSettings::ValueType::Float },
+	{ "ProjectileLifeSpan", ClassSettings::ValueType::Float },
+	{ "ProjectileSize", ClassSettings::ValueType::Vec3 },
+	{ "ProjectileDirection", ClassSettings::ValueType::Vec3 },
+	{ "ParticleSpeed", ClassSettings::ValueType::Float },
+	{ "ParticleLife", ClassSettings::ValueType::Float },
+	{ "ParticleScale", ClassSettings::ValueType::Float },
+	{ "ParticleColor", ClassSettings::ValueType::Vec4 },
+	{ "GpuParticles", ClassSettings::ValueType::Int }
+};
 
 ProjectilePool::ProjectilePool(std::string InConfigFile)
-	: ConfigFile(std::move(InConfigFile)), PoolSize(0), NextIndex(0),
+	: ConfigFile(std::move(InConfigFile)), PoolSize(0),
 		ParticleSpeed(DEFAULT_PARTICLE_SPEED), ParticleLife(DEFAULT_PARTICLE_LIFE),
-		ParticleScale(DEFAULT_PARTICLE_SCALE), ParticleColor(DEFAULT_PARTICLE_COLOR)
+		ParticleScale(DEFAULT_PARTICLE_SCALE), ParticleColor(DEFAULT_PARTICLE_COLOR), bGpuParticles(false)
 {
-	Pool.clear();
+	// Grows instead of recycling a shot that is still flying, PoolSize is only the starting capacity.
+	Pool.SetGrowth(PoolGrowth::Double);
+	Pool.SetFactory([this](int Index) { return CreateProjectile(Index); });
+	Pool.SetOnAcquire([](Projectile& InProjectile) { InProjectile.CancelDestroy(); });
+
 	SetDefaults();
 	LoadConfig();
 	CreatePool();
@@ -31,8 +48,12 @@ ProjectilePool::ProjectilePool(std::string InConfigFile)
 
 Projectile::SharedPtr ProjectilePool::Create(const glm::vec3& InLocation, Team InTeam)
 {
-	Projectile::SharedPtr OutProjectile = Pool[NextIndex];
-	OutProjectile->CancelDestroy();
+	Projectile::SharedPtr OutProjectile = Pool.Acquire();
+	if (OutProjectile == nullptr)
+	{
+		return nullptr;
+	}
+
 	OutProjectile->SetLocation(InLocation);
 	OutProjectile->SetTeam(InTeam);
 	OutProjectile->SetSize(ProjectileInfo.Size);
@@ -43,19 +64,17 @@ Projectile::SharedPtr ProjectilePool::Create(const glm::vec3& InLocation, Team I
 	const glm::vec3 Velocity = ProjectileInfo.Direction * ProjectileInfo.Speed;
 	OutProjectile->SetVelocity(Velocity);
 
-	OutProjectile->AddOnHitDelegate([this](const Actor::SharedPtr& HitActor, const CollisionResult& Result)
-		{
-			OnProjectileHit(HitActor, Result);
-		}
-	);
-
-	NextIndex = (NextIndex + 1) % PoolSize;
 	return OutProjectile;
 }
 
 int ProjectilePool::GetPoolSize() const
 {
-	return PoolSize;
+	return Pool.GetCapacity();
+}
+
+PoolStats ProjectilePool::GetStats() const
+{
+	return Pool.GetStats();
 }
 
 float ProjectilePool::GetLifeSpan() const
@@ -108,6 +127,11 @@ std::string ProjectilePool::GetTextureName() const
 	return TextureName;
 }
 
+std::string ProjectilePool::GetConfigFile() const
+{
+	return ConfigFile;
+}
+
 void ProjectilePool::SetLifeSpan(float InLifeSpan)
 {
 	ProjectileInfo.InitialLifeSpan = std::max(0.f, InLifeSpan);
@@ -140,12 +164,23 @@ void ProjectilePool::SetTextureName(const std::string& InTextureName)
 
 void ProjectilePool::ResetPool() const
 {
-	for (const Projectile::SharedPtr& Projectile : Pool)
+	Pool.ForEach([](Projectile& InProjectile) { InProjectile.Destroy(); });
+
+	ExplosionEmitter->Reset();
+}
+
+void ProjectilePool::ReloadConfig()
+{
+	LoadConfig();
+	if (PoolSize < Pool.GetCapacity())
 	{
-		Projectile->Destroy();
+		// Live projectiles may sit past the new size, clear the field so the pool can give them back.
+		ResetPool();
+		Pool.Shrink(PoolSize);
 	}
 
-	ExplosionEmitter->Reset();
+	CreatePool();
+	PrepareEmitter();
 }
 
 void ProjectilePool::UpdateEffects(float Delta) const
@@ -164,6 +199,10 @@ void ProjectilePool::OnProjectileHit(const Actor::SharedPtr& HitActor, const Col
 	{
 		ExplosionEmitter->Spawn(Result.ImpactLocation, ParticleScale * 2.f);
 	}
+	else if (Result.HitIndex >= 0)
+	{
+		ExplosionEmitter->Spawn(Result.ImpactLocation);
+	}
 	else
 	{
 		ExplosionEmitter->Spawn(HitActor->GetLocation());
@@ -183,13 +222,13 @@ void ProjectilePool::SetDefaults()
 
 void ProjectilePool::LoadConfig()
 {
-	ClassSettings::SharedConstPtr PoolSettings = ClassSettingsReader::Load(ConfigFile);
+	ClassSettings::SharedConstPtr PoolSettings = ClassSettingsReader::Load(ConfigFile, SETTINGS_SCHEMA);
 	if (!PoolSettings)
 	{
 		return;
 	}
 
-	int InPoolSize;
+	int InPoolSize, InGpuParticles;
 	float InSpeed, InLifeSpan, InParticleSpeed, InParticleLife, InParticleScale;
 	glm::vec3 InSize, InDirection;
 	glm::vec4 InParticleColor;
@@ -203,6 +242,7 @@ void ProjectilePool::LoadConfig()
 	PoolSettings->Get("ParticleLife", DEFAULT_PARTICLE_LIFE, InParticleLife);
 	PoolSettings->Get("ParticleScale", DEFAULT_PARTICLE_SCALE, InParticleScale);
 	PoolSettings->Get("ParticleColor", InParticleColor);
+	PoolSettings->Get("GpuParticles", 0, InGpuParticles);
 
 	SetPoolSize(InPoolSize);
 	SetLifeSpan(InLifeSpan);
@@ -213,16 +253,26 @@ void ProjectilePool::LoadConfig()
 	SetParticleLife(InParticleLife);
 	SetParticleScale(InParticleScale);
 	SetParticleColor(InParticleColor);
+	bGpuParticles = InGpuParticles != 0;
 }
 
 void ProjectilePool::CreatePool()
 {
-	for (int i = 0; i < PoolSize; ++i)
-	{
-		Projectile::SharedPtr NewProjectile = std::make_shared<Projectile>();
-		NewProjectile->SetColor(Colors::White);
-		Pool.push_back(NewProjectile);
-	}
+	Pool.Reserve(PoolSize);
+}
+
+Projectile::SharedPtr ProjectilePool::CreateProjectile(int Index)
+{
+	Projectile::SharedPtr NewProjectile = std::make_shared<Projectile>();
+	NewProjectile->SetColor(Colors::White);
+	NewProjectile->AddOnHitDelegate([this](const Actor::SharedPtr& HitActor, const CollisionResult& Result)
+		{
+			OnProjectileHit(HitActor, Result);
+		}
+	);
+	NewProjectile->AddOnDestroyDelegate([this, Index]() { Pool.Release(Index); });
+
+	return NewProjectile;
 }
 
 void ProjectilePool::PrepareEmitter()
@@ -230,8 +280,13 @@ void ProjectilePool::PrepareEmitter()
 	constexpr int SpawnAmount = 1;
 	constexpr int ParticlePoolCapacity = SpawnAmount * 5;
 
-	ParticlePattern::Base::SharedPtr FirePattern = std::make_shared<SpawnTexture>(ParticleSpeed, ParticleLife, SpawnAmount, Colors::White);
-	ExplosionEmitter = std::make_shared<Emitter>(ParticlePoolCapacity, ParticleScale, Assets::Shaders::ParticleTextureName, Assets::Textures::ExplosionName, FirePattern);
+	const SpawnTexture FirePattern(ParticleSpeed, ParticleLife, SpawnAmount, Colors::White);
+	ExplosionEmitter = std::make_shared<Emitter<SpawnTexture>>(ParticlePoolCapacity, ParticleScale, Assets::Shaders::ParticleTextureName, Assets::Textures::ExplosionName, FirePattern);
+
+	if (bGpuParticles)
+	{
+		ExplosionEmitter->EnableGpuSimulation(DEFAULT_GPU_PARTICLE_CAPACITY, Assets::Shaders::ParticleFeedbackName, Assets::Shaders::ParticleGpuName);
+	}
 }
 
 void ProjectilePool::SetParticleSpeed(float InSpeed)
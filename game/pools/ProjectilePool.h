@@ -4,12 +4,17 @@
 
 #include "../actors/Projectile.h"
 #include "../Types.h"
+#include "../../pk/core/utils/ClassSettings.h"
+#include "../../pk/core/utils/ObjectPool.h"
 
 namespace pk
 {
+	template <class Pattern>
 	class Emitter;
 }
 
+class SpawnTexture;
+
 class ProjectilePool
 {
 public:
@@ -19,17 +24,21 @@ public:
 	static const float DEFAULT_PARTICLE_SPEED;
 	static const float DEFAULT_PARTICLE_LIFE;
 	static const float DEFAULT_PARTICLE_SCALE;
+	static const int DEFAULT_GPU_PARTICLE_CAPACITY;
 	static const glm::vec3 DEFAULT_SIZE;
 	static const glm::vec3 DEFAULT_DIRECTION;
 	static const glm::vec4 DEFAULT_PARTICLE_COLOR;
+	static const pk::ClassSettings::Schema SETTINGS_SCHEMA;
 
-	typedef std::vector<Projectile::SharedPtr> ProjectileList;
-	typedef std::shared_ptr<Emitter> EmitterPtr;
+	typedef ObjectPool<Projectile> ProjectileObjectPool;
+	typedef std::shared_ptr<Emitter<SpawnTexture>> EmitterPtr;
 
 	ProjectilePool(std::string InConfigFile);
+	// Returns nullptr only if the pool is exhausted and not allowed to grow.
 	Projectile::SharedPtr Create(const glm::vec3& InLocation, Team InTeam);
 
 	int GetPoolSize() const;
+	PoolStats GetStats() const;
 	float GetLifeSpan() const;
 	float GetSpeed() const;
 	float GetParticleSpeed() const;
@@ -40,6 +49,7 @@ public:
 	glm::vec4 GetParticleColor() const;
 	std::string GetShaderName() const;
 	std::string GetTextureName() const;
+	std::string GetConfigFile() const;
 
 	void SetLifeSpan(float InLifeSpan);
 	void SetSpeed(float InSpeed);
@@ -49,6 +59,7 @@ public:
 	void SetTextureName(const std::string& InTextureName);
 
 	void ResetPool() const;
+	void ReloadConfig();
 
 	void UpdateEffects(float Delta) const;
 	void RenderEffects() const;
@@ -60,6 +71,7 @@ private:
 	void SetDefaults();
 	void LoadConfig();
 	void CreatePool();
+	Projectile::SharedPtr CreateProjectile(int Index);
 	void PrepareEmitter();
 
 	void SetParticleSpeed(float InSpeed);
@@ -71,14 +83,15 @@ private:
 	std::string ShaderName;
 	std::string TextureName;
 
-	ProjectileList Pool;
+	ProjectileObjectPool Pool;
 	int PoolSize;
-	int NextIndex;
 
 	float ParticleSpeed;
 	float ParticleLife;
 	float ParticleScale;
 	glm::vec4 ParticleColor;
+	// Explosion particles move on the GPU, the CPU pool only queues each frame's spawns.
+	bool bGpuParticles;
 
 	ProjectileData ProjectileInfo;
 
@@ -6,6 +6,11 @@
 #include <GLFW/glfw3.h>
 
 #include "../../pk/core/asset/AssetManager.h"
+#include "../../pk/core/asset/HotReload.h"
+#include "../../pk/core/render/CachedLayer.h"
+#include "../../pk/core/render/Renderer.h"
+#include "../../pk/core/render/ResolutionController.h"
+#include "../../pk/core/vfx/GpuParticles.h"
 #include "../../pk/core/utils/ClassSettingsReader.h"
 #include "../../pk/sound/ISound.h"
 #include "../../pk/core/utils/Random.h"
@@ -20,6 +25,7 @@
 #include "../ui/GameOver.h"
 #include "../ui/Hud.h"
 #include "../ui/MainMenu.h"
+#include "../ui/StatsOverlay.h"
 #include "../saves/GameSave.h"
 #include "../pools/ProjectilePool.h"
 
@@ -31,15 +37,20 @@ const int Game::DEFAULT_NUM_BUNKERS = 3;
 const float Game::DEFAULT_BUNKERS_BOTTOM_OFFSET = 90.f;
 const int Game::DEFAULT_TEXT_SIZE = 26;
 const float Game::DEFAULT_PLAYER_HIT_COOLDOWN = 2.f;
+const int Game::DEFAULT_HOT_RELOAD = 0;
+const float Game::DEFAULT_RENDER_SCALE = 1.f;
+const std::string Game::DEFAULT_UPSCALE_FILTER = "Nearest";
+const int Game::DEFAULT_DYNAMIC_RESOLUTION = 0;
 
 Game::Game()
-	: NumBunkers(DEFAULT_NUM_BUNKERS), TextSize(DEFAULT_TEXT_SIZE), MainAudioChannel(0),
+	: NumBunkers(DEFAULT_NUM_BUNKERS), TextSize(DEFAULT_TEXT_SIZE), bHotReload(DEFAULT_HOT_RELOAD != 0), MainAudioChannel(0),
 	  BunkersBottomOffset(DEFAULT_BUNKERS_BOTTOM_OFFSET),
 	  ShipSize(DEFAULT_SHIP_SIZE),
-	  CurrentHitCooldown(0.f), PlayerHitCooldown(DEFAULT_PLAYER_HIT_COOLDOWN),
+	  PlayerHitCooldown(DEFAULT_PLAYER_HIT_COOLDOWN),
 	  State(GameState::Play)
 {
 	LoadConfig();
+	LoadWindowConfig();
 	IHandler.HandlePad(GLFW_JOYSTICK_1);
 
 	IHandler.HandleKey(GLFW_KEY_LEFT, InputType::Hold);
@@ -49,6 +60,7 @@ Game::Game()
 	IHandler.HandleKey(GLFW_KEY_UP, InputType::Press);
 	IHandler.HandleKey(GLFW_KEY_DOWN, InputType::Press);
 	IHandler.HandleKey(GLFW_KEY_ENTER, InputType::Press);
+	IHandler.HandleKey(GLFW_KEY_F3, InputType::Press);
 
 	IHandler.HandlePadKey(GLFW_GAMEPAD_BUTTON_START, InputType::Press);
 	IHandler.HandlePadKey(GLFW_GAMEPAD_BUTTON_DPAD_UP, InputType::Press);
@@ -75,7 +87,7 @@ void Game::LoadConfig()
 		return;
 	}
 
-	int InNumBunkers, InTextSize;
+	int InNumBunkers, InTextSize, InHotReload;
 	float InBunkersBottomOffset, InPlayerHitCooldown;
 	glm::vec3 InShipSize(DEFAULT_SHIP_SIZE);
 	GameSettings->Get("ShipSize", InShipSize);
@@ -83,12 +95,37 @@ void Game::LoadConfig()
 	GameSettings->Get("TextSize", DEFAULT_TEXT_SIZE, InTextSize);
 	GameSettings->Get("BunkersBottomOffset", DEFAULT_BUNKERS_BOTTOM_OFFSET, InBunkersBottomOffset);
 	GameSettings->Get("PlayerHitCooldown", DEFAULT_PLAYER_HIT_COOLDOWN, InPlayerHitCooldown);
+	GameSettings->Get("HotReload", DEFAULT_HOT_RELOAD, InHotReload);
 
 	SetNumBunkers(InNumBunkers);
 	SetTextSize(InTextSize);
 	SetBunkersBottomOffset(InBunkersBottomOffset);
 	SetShipSize(InShipSize);
 	SetPlayerHitCooldown(InPlayerHitCooldown);
+	bHotReload = bHotReload || InHotReload != 0;
+}
+
+void Game::LoadWindowConfig()
+{
+	ClassSettings::SharedConstPtr WindowSettings = ClassSettingsReader::Load(Config::WindowFile);
+	if (WindowSettings == nullptr)
+	{
+		std::cout << "[Game] - Unable to read window config file.\n";
+		return;
+	}
+
+	int InDynamicResolution;
+	float InRenderScale, InFrameBudget, InMinRenderScale;
+	std::string InUpscaleFilter;
+	WindowSettings->Get("RenderScale", DEFAULT_RENDER_SCALE, InRenderScale);
+	WindowSettings->Get("UpscaleFilter", DEFAULT_UPSCALE_FILTER, InUpscaleFilter);
+	WindowSettings->Get("DynamicResolution", DEFAULT_DYNAMIC_RESOLUTION, InDynamicResolution);
+	WindowSettings->Get("FrameBudget", ResolutionController::DEFAULT_FRAME_BUDGET, InFrameBudget);
+	WindowSettings->Get("MinRenderScale", ResolutionController::DEFAULT_MIN_SCALE, InMinRenderScale);
+
+	SetRenderScale(InRenderScale);
+	SetUpscaleFilter(InUpscaleFilter == "Linear" ? UpscaleFilter::Linear : UpscaleFilter::Nearest);
+	SetDynamicResolution(InDynamicResolution != 0, InFrameBudget, InMinRenderScale);
 }
 
 void Game::SpawnPlayer()
@@ -143,11 +180,14 @@ void Game::SpawnBunkers()
 
 	const float BunkerY = Height - (ShipSize.y) - BunkersBottomOffset;
 
+	BunkerLayer = std::make_shared<CachedLayer>();
+
 	for (int i = 0; i < NumBunkers; i++)
 	{
 		const glm::vec3 BunkerLocation(BunkerX, BunkerY, 1.f);
 		Bunker::SharedPtr CurrentBunker = std::make_shared<Bunker>(BunkerLocation, glm::vec3(0.f));
 		CurrentBunker->SetConfig(Config::BunkerFile);
+		CurrentBunker->SetCachedLayer(BunkerLayer);
 		Bunkers.push_back(CurrentBunker);
 		Add(CurrentBunker);
 
@@ -175,6 +215,24 @@ void Game::ConstructGameOver()
 	Add(GameOverW);
 }
 
+void Game::ConstructStatsOverlay()
+{
+	StatsOverlayW = std::make_shared<StatsOverlay>(Fonts::TextFontName);
+	Add(StatsOverlayW);
+}
+
+void Game::ToggleStatsOverlay() const
+{
+	if (StatsOverlayW->IsActive())
+	{
+		StatsOverlayW->Deactivate();
+	}
+	else
+	{
+		StatsOverlayW->Activate();
+	}
+}
+
 glm::vec3 Game::GetPlayerStartLocation() const
 {
 	const float Width = static_cast<float>(GetScreenWidth());
@@ -193,6 +251,25 @@ void Game::BuildBunkers() const
 	}
 }
 
+void Game::RenderBunkers() const
+{
+	if (BunkerLayer == nullptr)
+	{
+		return;
+	}
+
+	const Shader::SharedPtr CompositeShader = AssetManager::Get().GetShader(Shaders::SpriteNoColorName);
+	Renderer::Get().SetLayer(RenderLayer::Bunkers);
+	BunkerLayer->Render(CompositeShader, [this]()
+		{
+			for (const Bunker::SharedPtr& Bunker : Bunkers)
+			{
+				Bunker->RenderBricks();
+			}
+		}
+	);
+}
+
 void Game::ResetPlayer() const
 {
 	PlayerShip->SetLocation(GetPlayerStartLocation());
@@ -221,6 +298,9 @@ void Game::OnPlayerTakeDamage()
 		SecretAlien->Reset();
 		PlayAudio(Sounds::PlayerExplosionName, 1.f);
 		State = GameState::Pause;
+
+		PauseTimers.Clear(PlayerHitTimer);
+		PlayerHitTimer = PauseTimers.Set(PlayerHitCooldown, [this]() { OnPlayerHitCooldownEnd(); });
 	}
 }
 
@@ -264,28 +344,28 @@ void Game::SetBunkersBottomOffset(float InOffset)
 	BunkersBottomOffset = std::abs(InOffset);
 }
 
+void Game::SetHotReload(bool bEnable)
+{
+	bHotReload = bEnable;
+}
+
 void Game::SetPlayerHitCooldown(float InCooldown)
 {
 	PlayerHitCooldown = std::abs(InCooldown);
 }
 
-void Game::UpdatePlayerHitCooldown(float Delta)
+void Game::OnPlayerHitCooldownEnd()
 {
 	if (State != GameState::Pause)
 	{
 		return;
 	}
 
-	CurrentHitCooldown += Delta;
-	if (CurrentHitCooldown >= PlayerHitCooldown)
-	{
-		CurrentHitCooldown = 0.f;
-		AlienProjectilePool->ResetPool();
-		PlayerProjectilePool->ResetPool();
-		PlayerShip->SetLocation(GetPlayerStartLocation());
+	AlienProjectilePool->ResetPool();
+	PlayerProjectilePool->ResetPool();
+	PlayerShip->SetLocation(GetPlayerStartLocation());
 
-		State = GameState::Play;
-	}
+	State = GameState::Play;
 }
 
 void Game::SaveScore() const
@@ -301,6 +381,10 @@ void Game::SaveScore() const
 void Game::Begin()
 {
 	LoadAssets();
+	if (bHotReload)
+	{
+		HotReload::Get().Start(Assets::BasePath);
+	}
 
 	LoadSave();
 
@@ -311,6 +395,7 @@ void Game::Begin()
 	ConstructMainMenu();
 	ConstructHud();
 	ConstructGameOver();
+	ConstructStatsOverlay();
 
 	Scene::Begin();
 
@@ -353,6 +438,7 @@ void Game::Play()
 	}
 
 	State = GameState::Play;
+	PauseTimers.Clear(PlayerHitTimer);
 
 	MainMenuW->Deactivate();
 	GameOverW->Deactivate();
@@ -376,6 +462,7 @@ void Game::Menu()
 	}
 
 	State = GameState::Menu;
+	PauseTimers.Clear(PlayerHitTimer);
 
 	AlienProjectilePool->ResetPool();
 	PlayerProjectilePool->ResetPool();
@@ -392,6 +479,7 @@ void Game::Menu()
 
 void Game::Quit()
 {
+	HotReload::Get().Stop();
 	WriteSave();
 	Scene::Quit();
 }
@@ -438,6 +526,16 @@ std::vector<int> Game::GetHighScores() const
 	return SavePtr->GetHighScores();
 }
 
+glm::vec3 Game::GetPlayerLocation() const
+{
+	if (PlayerShip == nullptr)
+	{
+		return GetPlayerStartLocation();
+	}
+
+	return PlayerShip->GetLocation();
+}
+
 int Game::PlayAudio(const std::string& Name, float Volume) const
 {
 	return PlayAudio(Name, Volume, false);
@@ -467,6 +565,11 @@ void Game::HandleInput(const float Delta)
 		Menu();
 	}
 
+	if (IHandler.IsPressed(GLFW_KEY_F3))
+	{
+		ToggleStatsOverlay();
+	}
+
 	if (State == GameState::Play)
 	{
 		HandleActorsInput(Delta);
@@ -490,7 +593,7 @@ void Game::Update(const float Delta)
 		AlienProjectilePool->UpdateEffects(Delta);
 	}
 
-	UpdatePlayerHitCooldown(Delta);
+	PauseTimers.Advance(Delta);
 }
 
 void Game::Render(const float Delta)
@@ -498,6 +601,8 @@ void Game::Render(const float Delta)
 	if (State != GameState::Menu)
 	{
 		RenderActors();
+		RenderBunkers();
+		Renderer::Get().SetLayer(RenderLayer::Effects);
 		PlayerProjectilePool->RenderEffects();
 		AlienProjectilePool->RenderEffects();
 	}
@@ -505,6 +610,32 @@ void Game::Render(const float Delta)
 	RenderWidgets();
 }
 
+void Game::OnAssetReloaded(const std::string& Path)
+{
+	Scene::OnAssetReloaded(Path);
+
+	if (Path == Config::GameFile)
+	{
+		LoadConfig();
+	}
+	else if (Path == Config::WindowFile)
+	{
+		LoadWindowConfig();
+	}
+	else if (Path == PlayerProjectilePool->GetConfigFile())
+	{
+		PlayerProjectilePool->ReloadConfig();
+	}
+	else if (Path == AlienProjectilePool->GetConfigFile())
+	{
+		AlienProjectilePool->ReloadConfig();
+	}
+	else if (Path.rfind(BasePath + Shaders::InnerPath, 0) == 0)
+	{
+		ApplyProjection();
+	}
+}
+
 void Game::LoadAssets() const
 {
 	AssetManager::Get().LoadTexture(Textures::PlayerName, Textures::PlayerPath, GL_RGBA, GL_REPEAT, GL_REPEAT, GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
@@ -516,29 +647,16 @@ void Game::LoadAssets() const
 	AssetManager::Get().LoadTexture(Textures::BlueLaserName, Textures::BlueLaserPath, GL_RGBA, GL_REPEAT, GL_REPEAT, GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
 	AssetManager::Get().LoadTexture(Textures::RedLaserName, Textures::RedLaserPath, GL_RGBA, GL_REPEAT, GL_REPEAT, GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
 
-	Shader::SharedPtr ShapeShader = AssetManager::Get().LoadShader(Shaders::ShapeName, Shaders::ShapeVertexFile, Shaders::ShapeFragmentFile);
-	ShapeShader->Use();
-	ShapeShader->SetMatrix("projection", GetProjection());
-
-	Shader::SharedPtr SpriteShader = AssetManager::Get().LoadShader(Shaders::SpriteName, Shaders::SpriteVertexFile, Shaders::SpriteFragmentFile);
-	SpriteShader->Use();
-	SpriteShader->SetMatrix("projection", GetProjection());
-
-	Shader::SharedPtr SpriteNoColorShader = AssetManager::Get().LoadShader(Shaders::SpriteNoColorName, Shaders::SpriteVertexFile, Shaders::SpriteNoColorFragmentFile);
-	SpriteNoColorShader->Use();
-	SpriteNoColorShader->SetMatrix("projection", GetProjection());
-
-	Shader::SharedPtr TextShader = AssetManager::Get().LoadShader(Shaders::TextName, Shaders::TextVertexFile, Shaders::TextFragmentFile);
-	TextShader->Use();
-	TextShader->SetMatrix("projection", GetProjection());
-
-	Shader::SharedPtr ParticleShapeShader = AssetManager::Get().LoadShader(Shaders::ParticleShapeName, Shaders::ParticleVertexFile, Shaders::ParticleShapeFragmentFile);
-	ParticleShapeShader->Use();
-	ParticleShapeShader->SetMatrix("projection", GetProjection());
-
-	Shader::SharedPtr ParticleTextureShader = AssetManager::Get().LoadShader(Shaders::ParticleTextureName, Shaders::ParticleVertexFile, Shaders::ParticleTextureFragmentFile);
-	ParticleTextureShader->Use();
-	ParticleTextureShader->SetMatrix("projection", GetProjection());
+	AssetManager::Get().LoadShader(Shaders::ShapeName, Shaders::ShapeVertexFile, Shaders::ShapeFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::SpriteName, Shaders::SpriteVertexFile, Shaders::SpriteFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::SpriteNoColorName, Shaders::SpriteVertexFile, Shaders::SpriteNoColorFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::SpriteInstancedName, Shaders::SpriteInstancedVertexFile, Shaders::SpriteNoColorFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::TextName, Shaders::TextVertexFile, Shaders::TextFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::ParticleShapeName, Shaders::ParticleVertexFile, Shaders::ParticleShapeFragmentFile);
+	AssetManager::Get().LoadShader(Shaders::ParticleTextureName, Shaders::ParticleVertexFile, Shaders::ParticleTextureFragmentFile);
+	AssetManager::Get().LoadFeedbackShader(Shaders::ParticleFeedbackName, Shaders::ParticleFeedbackVertexFile, Shaders::ParticleFeedbackGeometryFile, GpuParticles::FEEDBACK_VARYINGS);
+	AssetManager::Get().LoadShader(Shaders::ParticleGpuName, Shaders::ParticleGpuVertexFile, Shaders::ParticleGpuGeometryFile, Shaders::ParticleTextureFragmentFile);
+	ApplyProjection();
 
 	Font::SharedPtr TextFont = AssetManager::Get().LoadFont(Fonts::TextFontName, Fonts::TextFontPath, Shaders::TextName);
 	TextFont->Load(TextSize, GL_CLAMP_TO_BORDER, GL_NEAREST);
@@ -551,9 +669,45 @@ void Game::LoadAssets() const
 	AssetManager::Get().LoadSound(Sounds::AlienExplosionName, Sounds::AlienExplosion);
 	AssetManager::Get().LoadSound(Sounds::PlayerExplosionName, Sounds::PlayerExplosion);
 	AssetManager::Get().LoadSound(Sounds::GameOverName, Sounds::GameOver);
-	AssetManager::Get().LoadSound(Sounds::MainJingleName, Sounds::MainJingle);
+	AssetManager::Get().LoadMusic(Sounds::MainJingleName, Sounds::MainJingle);
 	AssetManager::Get().LoadSound(Sounds::SecretAlienSpawnName, Sounds::SecretAlienSpawn);
 	AssetManager::Get().LoadSequenceSound(Sounds::AlienMoveName, String::GenerateStringsFromBase(Sounds::AlienMove, 4));
 	AssetManager::Get().LoadRandomSound(Sounds::ShootName, String::GenerateStringsFromBase(Sounds::Shoot, 4));
+
+	SoundEngine::Get().SetGroupLimit(Sounds::MainJingleName, 1, 255);
+	SoundEngine::Get().SetGroupLimit(Sounds::GameOverName, 1, 200);
+	SoundEngine::Get().SetGroupLimit(Sounds::PlayerExplosionName, 1, 200);
+	SoundEngine::Get().SetGroupLimit(Sounds::SecretAlienSpawnName, 1, 160);
+	SoundEngine::Get().SetGroupLimit(Sounds::AlienExplosionName, 4, 128);
+	SoundEngine::Get().SetGroupLimit(Sounds::ShootName, 3, 96);
+	SoundEngine::Get().SetGroupLimit(Sounds::OldShootName, 3, 96);
+	SoundEngine::Get().SetGroupLimit(Sounds::AlienMoveName, 1, 64);
+	SoundEngine::Get().SetGroupLimit(Sounds::MenuNavigationName, 2, 64);
+}
+
+void Game::ApplyProjection() const
+{
+	const std::vector<std::string> ShaderNames = {
+		Shaders::ShapeName,
+		Shaders::SpriteName,
+		Shaders::SpriteNoColorName,
+		Shaders::SpriteInstancedName,
+		Shaders::TextName,
+		Shaders::ParticleShapeName,
+		Shaders::ParticleTextureName,
+		Shaders::ParticleGpuName,
+	};
+
+	for (const std::string& Name : ShaderNames)
+	{
+		const Shader::SharedPtr CurrentShader = AssetManager::Get().GetShader(Name);
+		if (CurrentShader == nullptr)
+		{
+			continue;
+		}
+
+		Renderer::Get().UseShader(CurrentShader);
+		CurrentShader->SetMatrix("projection", GetProjection());
+	}
 }
 
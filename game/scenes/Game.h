@@ -2,6 +2,11 @@
 
 #include "../../pk/core/world/Scene.h"
 
+namespace pk
+{
+	class CachedLayer;
+}
+
 class Ship;
 class ProjectilePool;
 class AlienGroup;
@@ -10,6 +15,7 @@ class Bunker;
 class Hud;
 class MainMenu;
 class GameOver;
+class StatsOverlay;
 class GameSave;
 
 using namespace pk;
@@ -34,8 +40,10 @@ public:
 	typedef std::shared_ptr<Hud> HudPtr;
 	typedef std::shared_ptr<MainMenu> MainMenuPtr;
 	typedef std::shared_ptr<GameOver> GameOverPtr;
+	typedef std::shared_ptr<StatsOverlay> StatsOverlayPtr;
 	typedef std::shared_ptr<GameSave> GameSavePtr;
 	typedef std::vector<BunkerPtr> BunkerList;
+	typedef std::shared_ptr<CachedLayer> CachedLayerPtr;
 
 	static const glm::vec3 DEFAULT_SHIP_SIZE;
 	static const int MAX_NUM_BUNKERS;
@@ -43,12 +51,19 @@ public:
 	static const float DEFAULT_BUNKERS_BOTTOM_OFFSET;
 	static const int DEFAULT_TEXT_SIZE;
 	static const float DEFAULT_PLAYER_HIT_COOLDOWN;
+	static const int DEFAULT_HOT_RELOAD;
+	static const float DEFAULT_RENDER_SCALE;
+	static const std::string DEFAULT_UPSCALE_FILTER;
+	static const int DEFAULT_DYNAMIC_RESOLUTION;
 
 	Game();
 	Game(Window::WeakPtr InWindow);
 
 	void Begin() override;
 
+	// Watches the asset folder from Begin on, the config can only turn it on as well.
+	void SetHotReload(bool bEnable);
+
 	void Play();
 	void Menu();
 	void Quit() override;
@@ -57,6 +72,7 @@ public:
 
 	int GetMaxScores() const;
 	std::vector<int> GetHighScores() const;
+	glm::vec3 GetPlayerLocation() const;
 
 	int PlayAudio(const std::string& Name, float Volume) const;
 	int PlayAudio(const std::string& Name, float Volume, bool bLoop) const;
@@ -65,14 +81,18 @@ protected:
 	void HandleInput(const float Delta) override;
 	void Update(const float Delta) override;
 	void Render(const float Delta) override;
+	void OnAssetReloaded(const std::string& Path) override;
 
 private:
 	void LoadAssets() const;
+	void ApplyProjection() const;
 
 	void LoadSave();
 	void WriteSave() const;
 
 	void LoadConfig();
+	// Render resolution settings live with the window's, they can change while running.
+	void LoadWindowConfig();
 	void SpawnPlayer();
 	void SpawnAliens();
 	void SpawnSecretAlien();
@@ -80,9 +100,12 @@ private:
 	void ConstructMainMenu();
 	void ConstructHud();
 	void ConstructGameOver();
+	void ConstructStatsOverlay();
+	void ToggleStatsOverlay() const;
 
 	glm::vec3 GetPlayerStartLocation() const;
 	void BuildBunkers() const;
+	void RenderBunkers() const;
 	void ResetPlayer() const;
 
 	void OnInvadersReachedPlayer();
@@ -97,27 +120,33 @@ private:
 	void SetBunkersBottomOffset(float InOffset);
 	void SetPlayerHitCooldown(float InCooldown);
 
-	void UpdatePlayerHitCooldown(float Delta);
+	void OnPlayerHitCooldownEnd();
 
 	void SaveScore() const;
 
 	int NumBunkers;
 	int TextSize;
+	bool bHotReload;
 	unsigned int MainAudioChannel;
 	float BunkersBottomOffset;
 	glm::vec3 ShipSize;
 
-	float CurrentHitCooldown;
 	float PlayerHitCooldown;
+	TimerHandle PlayerHitTimer;
+	// Scene timers stop outside GameState::Play, these keep running while paused.
+	TimerWheel PauseTimers;
 
 	ShipSharedPtr PlayerShip;
 	AlienGroupPtr MainAlienGroup;
 	SecretAlienPtr SecretAlien;
 	BunkerList Bunkers;
+	// Bunkers only change when hit or rebuilt, they are composited from here the rest of the time.
+	CachedLayerPtr BunkerLayer;
 
 	HudPtr MainHud;
 	MainMenuPtr MainMenuW;
 	GameOverPtr GameOverW;
+	StatsOverlayPtr StatsOverlayW;
 
 	ProjectilePoolPtr PlayerProjectilePool;
 	ProjectilePoolPtr AlienProjectilePool;
@@ -5,12 +5,30 @@
 
 #include "../Assets.h"
 #include "../scenes/Game.h"
+#include "../../pk/core/asset/AssetManager.h"
+#include "../../pk/core/render/CachedLayer.h"
 #include "../../pk/core/utils/Common.h"
 #include "../../pk/core/input/InputHandler.h"
 
 GameOver::GameOver(const GameWeakPtr& InGame)
-	: GamePtr(InGame)
+	: GamePtr(InGame),
+		TitleLabel(Assets::Fonts::HeadingFontName, TextOrient::Center, 1.0f, Colors::White),
+		RestartLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		LeftArrowLabel(Assets::Fonts::TextFontName, TextOrient::Left, 1.0f, Colors::LightGray),
+		RightArrowLabel(Assets::Fonts::TextFontName, TextOrient::Left, 1.0f, Colors::LightGray)
 {
+	TitleLabel.SetText("GAME OVER!");
+	RestartLabel.SetText("Restart");
+	LeftArrowLabel.SetText(">");
+	RightArrowLabel.SetText("<");
+}
+
+void GameOver::Construct()
+{
+	Widget::Construct();
+
+	// Sized by the renderer on first use, so it follows the internal resolution.
+	Layer = std::make_shared<CachedLayer>();
 }
 
 void GameOver::Input(const InputHandler& Handler, const float Delta)
@@ -27,6 +45,27 @@ void GameOver::Render()
 {
 	Widget::Render();
 
+	if (Layer == nullptr)
+	{
+		RenderPanel();
+		return;
+	}
+
+	Layer->Render(AssetManager::Get().GetShader(Assets::Shaders::SpriteNoColorName), [this]() { RenderPanel(); });
+}
+
+void GameOver::OnActivate()
+{
+	Widget::OnActivate();
+
+	if (Layer != nullptr)
+	{
+		Layer->Invalidate();
+	}
+}
+
+void GameOver::RenderPanel()
+{
 	const Scene::SharedPtr CurrentScene = GetScene();
 	if (CurrentScene == nullptr)
 	{
@@ -34,13 +73,12 @@ void GameOver::Render()
 	}
 
 	const glm::vec2 Center(CurrentScene->GetScreenCenter());
-	const glm::vec2 TitlePos(Center.x, Center.y - 150.f);
-	const glm::vec2 RestartPos(Center.x, Center.y - 90.f);
+	TitleLabel.SetPosition(glm::vec2(Center.x, Center.y - 150.f));
+	RestartLabel.SetPosition(glm::vec2(Center.x, Center.y - 90.f));
 
-	glm::vec2 TitleSize, RestartSize;
-	RenderText(Assets::Fonts::HeadingFontName, TitlePos, "GAME OVER!", TextOrient::Center, 1.0f, Colors::White, TitleSize.x, TitleSize.y);
-	RenderText(Assets::Fonts::TextFontName, RestartPos, "Restart", TextOrient::Center, 1.0f, Colors::White, RestartSize.x, RestartSize.y);
-	RenderSelectArrows(RestartPos, RestartSize);
+	TitleLabel.Render();
+	RestartLabel.Render();
+	RenderSelectArrows(RestartLabel);
 }
 
 void GameOver::HandleInput() const
@@ -55,19 +93,17 @@ void GameOver::HandleInput() const
 	CurrentGame->Play();
 }
 
-void GameOver::RenderSelectArrows(const glm::vec2& OptionPos, const glm::vec2& OptionSize) const
+void GameOver::RenderSelectArrows(const Label& Option)
 {
-	const float LeftOffset = (OptionSize.x / 2) + 20.f;
-	const float RightOffset = (OptionSize.x / 2) + 10.f;
-
-	const glm::vec2 LeftArrow(OptionPos.x - LeftOffset, OptionPos.y);
-	const glm::vec2 RightArrow(OptionPos.x + RightOffset, OptionPos.y);
+	const float LeftOffset = (Option.GetSize().x / 2) + 20.f;
+	const float RightOffset = (Option.GetSize().x / 2) + 10.f;
 
-	const glm::vec4 Color(0.8f, 0.84f, 0.86f, 1.f);
+	const glm::vec2& OptionPos = Option.GetPosition();
+	LeftArrowLabel.SetPosition(glm::vec2(OptionPos.x - LeftOffset, OptionPos.y));
+	RightArrowLabel.SetPosition(glm::vec2(OptionPos.x + RightOffset, OptionPos.y));
 
-	float OutWidth, OutHeight;
-	RenderText(Assets::Fonts::TextFontName, LeftArrow, ">", TextOrient::Left, 1.0f, Color, OutWidth, OutHeight);
-	RenderText(Assets::Fonts::TextFontName, RightArrow, "<", TextOrient::Left, 1.0f, Color, OutWidth, OutHeight);
+	LeftArrowLabel.Render();
+	RightArrowLabel.Render();
 }
 
 GameOver::GameSharedPtr GameOver::GetGame() const
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "../../pk/ui/Widget.h"
+#include "../../pk/ui/Label.h"
+
+namespace pk
+{
+	class CachedLayer;
+}
 
 class Game;
 
@@ -12,16 +18,30 @@ public:
 	typedef std::shared_ptr<GameOver> SharedPtr;
 	typedef std::weak_ptr<Game> GameWeakPtr;
 	typedef std::shared_ptr<Game> GameSharedPtr;
+	typedef std::shared_ptr<CachedLayer> CachedLayerPtr;
 
 	GameOver(const GameWeakPtr& InGame);
+	void Construct() override;
 	void Input(const InputHandler& Handler, const float Delta) override;
 	void Render() override;
 
+protected:
+	void OnActivate() override;
+
 private:
 	void HandleInput() const;
-	void RenderSelectArrows(const glm::vec2& OptionPos, const glm::vec2& OptionSize) const;
+	void RenderPanel();
+	void RenderSelectArrows(const Label& Option);
 
 	GameSharedPtr GetGame() const;
 
 	GameWeakPtr GamePtr;
+
+	// Nothing on the screen changes while it is shown, drawn once per activation.
+	CachedLayerPtr Layer;
+
+	Label TitleLabel;
+	Label RestartLabel;
+	Label LeftArrowLabel;
+	Label RightArrowLabel;
 };
\ No newline at end of file
@@ -1,24 +1,33 @@
 #include "Hud.h"
 
-#include <sstream>
-
-#include "../../pk/core/asset/AssetManager.h"
 #include "../../pk/core/utils/Common.h"
 #include "../../pk/core/world/Scene.h"
 
-Hud::Hud(std::string InFontName)
-	: LifePoints(0), Score(0), FontName(std::move(InFontName))
+Hud::Hud(const std::string& InFontName)
+	: LifePoints(0), Score(0),
+		LifePointsLabel(InFontName, TextOrient::Left, 1.0f, Colors::White),
+		ScoreLabel(InFontName, TextOrient::Center, 1.0f, Colors::White)
 {
+	LifePointsLabel.SetText("LifePoints: " + std::to_string(LifePoints));
+	ScoreLabel.SetText("Score: " + std::to_string(Score));
 }
 
 void Hud::SetLifePoints(int InLifePoints)
 {
-	LifePoints = InLifePoints;
+	if (InLifePoints != LifePoints)
+	{
+		LifePoints = InLifePoints;
+		LifePointsLabel.SetText("LifePoints: " + std::to_string(LifePoints));
+	}
 }
 
 void Hud::SetScore(int InScore)
 {
-	Score = InScore;
+	if (InScore != Score)
+	{
+		Score = InScore;
+		ScoreLabel.SetText("Score: " + std::to_string(Score));
+	}
 }
 
 int Hud::GetLifePoints() const
@@ -42,15 +51,9 @@ void Hud::Render()
 	}
 
 	const glm::vec2 Center(CurrentScene->GetScreenCenter());
+	LifePointsLabel.SetPosition(glm::vec2(15.f, 15.f));
+	ScoreLabel.SetPosition(glm::vec2(Center.x, 15.f));
 
-	std::stringstream LifePointsText, ScoreText;
-	LifePointsText << "LifePoints: " << LifePoints;
-	ScoreText << "Score: " << Score;
-
-	const glm::vec2 LifePointPos = glm::vec2(15.f, 15.f);
-	const glm::vec2 ScorePos = glm::vec2(Center.x, 15.f);
-
-	float OutWidth, OutHeight;
-	RenderText(FontName, LifePointPos, LifePointsText.str(), TextOrient::Left, 1.0f, Colors::White, OutWidth, OutHeight);
-	RenderText(FontName, ScorePos, ScoreText.str(), TextOrient::Center, 1.0f, Colors::White, OutWidth, OutHeight);
+	LifePointsLabel.Render();
+	ScoreLabel.Render();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../pk/ui/Widget.h"
+#include "../../pk/ui/Label.h"
 
 #include <string>
 
@@ -9,8 +10,9 @@ using namespace pk;
 class Hud : public Widget
 {
 public:
-	Hud(std::string InFontName);
+	Hud(const std::string& InFontName);
 
+	// Only a value that differs from the shown one rebuilds its label.
 	void SetLifePoints(int InLifePoints);
 	void SetScore(int InScore);
 
@@ -23,5 +25,6 @@ private:
 	int LifePoints;
 	int Score;
 
-	std::string FontName;
-};
\ No newline at end of file
+	Label LifePointsLabel;
+	Label ScoreLabel;
+};
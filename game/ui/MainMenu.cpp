@@ -1,11 +1,13 @@
 #include "MainMenu.h"
 
+#include <algorithm>
 #include <iostream>
 #include <GLFW/glfw3.h>
 
 #include "../Assets.h"
 #include "../scenes/Game.h"
 #include "../../pk/core/asset/AssetManager.h"
+#include "../../pk/core/render/CachedLayer.h"
 #include "../../pk/core/utils/Common.h"
 #include "../../pk/core/save/SaveSystem.h"
 #include "../../pk/sound/SoundEngine.h"
@@ -17,9 +19,37 @@ const int MainMenu::QUIT_OPTION = 3;
 const int MainMenu::MAX_OPTION = 3;
 
 MainMenu::MainMenu(const GameWeakPtr& InGame)
-	: CurrentChoice(START_GAME_OPTION), MaxChoice(MAX_OPTION), GamePtr(InGame), CurrentPanel(Panel::Main)
+	: CurrentChoice(START_GAME_OPTION), MaxChoice(MAX_OPTION), GamePtr(InGame), CurrentPanel(Panel::Main),
+		TitleLabel(Assets::Fonts::HeadingFontName, TextOrient::Center, 1.0f, Colors::White),
+		StartLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		ScoresLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		MuteLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		QuitLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		ScoresTitleLabel(Assets::Fonts::HeadingFontName, TextOrient::Center, 1.0f, Colors::White),
+		NoDataLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		BackLabel(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White),
+		LeftArrowLabel(Assets::Fonts::TextFontName, TextOrient::Left, 1.0f, Colors::LightGray),
+		RightArrowLabel(Assets::Fonts::TextFontName, TextOrient::Left, 1.0f, Colors::LightGray)
 {
 	SetScene(InGame);
+
+	TitleLabel.SetText("SPACE INVADERS");
+	StartLabel.SetText("START GAME");
+	ScoresLabel.SetText("HIGH SCORES");
+	QuitLabel.SetText("QUIT");
+	ScoresTitleLabel.SetText("HIGH SCORES");
+	NoDataLabel.SetText("N/D");
+	BackLabel.SetText("BACK");
+	LeftArrowLabel.SetText(">");
+	RightArrowLabel.SetText("<");
+}
+
+void MainMenu::Construct()
+{
+	Widget::Construct();
+
+	// Sized by the renderer on first use, so it follows the internal resolution.
+	Layer = std::make_shared<CachedLayer>();
 }
 
 void MainMenu::Input(const InputHandler& Handler, const float Delta)
@@ -72,14 +102,35 @@ void MainMenu::Render()
 {
 	Widget::Render();
 
-	if (CurrentPanel == Panel::Main)
+	const auto RenderPanel = [this]()
 	{
-		RenderMain();
-	}
-	else
+		if (CurrentPanel == Panel::Main)
+		{
+			RenderMain();
+		}
+		else
+		{
+			RenderScores();
+		}
+	};
+
+	if (Layer == nullptr)
 	{
-		RenderScores();
+		RenderPanel();
+		return;
 	}
+
+	Layer->Render(AssetManager::Get().GetShader(Assets::Shaders::SpriteNoColorName), RenderPanel);
+}
+
+void MainMenu::OnActivate()
+{
+	Widget::OnActivate();
+
+	// Scores may have changed while the menu was hidden.
+	UpdateMuteLabel();
+	UpdateScoreLabels();
+	InvalidateLayer();
 }
 
 MainMenu::GameSharedPtr MainMenu::GetGame() const
@@ -87,7 +138,7 @@ MainMenu::GameSharedPtr MainMenu::GetGame() const
 	return GamePtr.lock();
 }
 
-void MainMenu::RenderMain() const
+void MainMenu::RenderMain()
 {
 	const Game::SharedPtr CurrentScene = GetGame();
 	if (CurrentScene == nullptr)
@@ -95,50 +146,37 @@ void MainMenu::RenderMain() const
 		return;
 	}
 
-	const std::string TitleText = "SPACE INVADERS", StartText = "START GAME", QuitText = "QUIT", ScoresText = "HIGH SCORES";
 	const glm::vec2 Center(CurrentScene->GetScreenCenter());
-	const glm::vec2 TitlePos(Center.x, Center.y - 150.f);
-	const glm::vec2 StartPos(Center.x, Center.y - 90.f);
-	const glm::vec2 ScoresPos(Center.x, Center.y - 55.f);
-	const glm::vec2 MutePos(Center.x, Center.y - 20.f);
-	const glm::vec2 QuitPos(Center.x, Center.y + 15.f);
-
-	glm::vec2 TitleSize, StartSize, MuteSize, QuitSize, ScoresSize;
-	std::string MuteText = "MUTE: ";
-	MuteText += (CurrentScene->IsMuted()) ? "YES" : "NO";
-
-	RenderText(Assets::Fonts::HeadingFontName, TitlePos, TitleText, TextOrient::Center, 1.0f, Colors::White, TitleSize.x, TitleSize.y);
-	RenderText(Assets::Fonts::TextFontName, StartPos, StartText, TextOrient::Center, 1.0f, Colors::White, StartSize.x, StartSize.y);
-	RenderText(Assets::Fonts::TextFontName, ScoresPos, ScoresText, TextOrient::Center, 1.0f, Colors::White, ScoresSize.x, ScoresSize.y);
-	RenderText(Assets::Fonts::TextFontName, MutePos, MuteText, TextOrient::Center, 1.0f, Colors::White, MuteSize.x, MuteSize.y);
-	RenderText(Assets::Fonts::TextFontName, QuitPos, QuitText, TextOrient::Center, 1.0f, Colors::White, QuitSize.x, QuitSize.y);
-
-	std::string SelectedText = StartText;
-	glm::vec2 SelectedPos = StartPos;
-	glm::vec2 SelectedSize = StartSize;
+	TitleLabel.SetPosition(glm::vec2(Center.x, Center.y - 150.f));
+	StartLabel.SetPosition(glm::vec2(Center.x, Center.y - 90.f));
+	ScoresLabel.SetPosition(glm::vec2(Center.x, Center.y - 55.f));
+	MuteLabel.SetPosition(glm::vec2(Center.x, Center.y - 20.f));
+	QuitLabel.SetPosition(glm::vec2(Center.x, Center.y + 15.f));
+
+	TitleLabel.Render();
+	StartLabel.Render();
+	ScoresLabel.Render();
+	MuteLabel.Render();
+	QuitLabel.Render();
+
+	const Label* Selected = &StartLabel;
 	if (CurrentChoice == SCORES_OPTION)
 	{
-		SelectedText = ScoresText;
-		SelectedPos = ScoresPos;
-		SelectedSize = ScoresSize;
+		Selected = &ScoresLabel;
 	}
 	else if (CurrentChoice == MUTE_OPTION)
 	{
-		SelectedText = MuteText;
-		SelectedPos = MutePos;
-		SelectedSize = MuteSize;
+		Selected = &MuteLabel;
 	}
 	else if (CurrentChoice == QUIT_OPTION)
 	{
-		SelectedText = QuitText;
-		SelectedPos = QuitPos;
-		SelectedSize = QuitSize;
+		Selected = &QuitLabel;
 	}
 
-	RenderSelectArrows(SelectedText, SelectedPos, SelectedSize);
+	RenderSelectArrows(*Selected);
 }
 
-void MainMenu::RenderScores() const
+void MainMenu::RenderScores()
 {
 	const Game::SharedPtr CurrentScene = GetGame();
 	if (CurrentScene == nullptr)
@@ -146,45 +184,70 @@ void MainMenu::RenderScores() const
 		return;
 	}
 
-	const std::vector<int> Scores = CurrentScene->GetHighScores();
-	const std::string TitleText = "HIGH SCORES", NoDataText = "N/D", BackText = "BACK";
 	const glm::vec2 Center(CurrentScene->GetScreenCenter());
-	const glm::vec2 TitlePos(Center.x, Center.y - 150.f);
-	const glm::vec2 NoDataPos(Center.x, Center.y - 90.f);
+	glm::vec2 CurrentScorePos(Center.x, Center.y - 90.f);
 
-	glm::vec2 TitleSize, NoDataSize, CurrentScorePos = NoDataPos;
-	RenderText(Assets::Fonts::HeadingFontName, TitlePos, TitleText, TextOrient::Center, 1.0f, Colors::White, TitleSize.x, TitleSize.y);
-	if (!Scores.empty())
+	ScoresTitleLabel.SetPosition(glm::vec2(Center.x, Center.y - 150.f));
+	ScoresTitleLabel.Render();
+	if (!ScoreLabels.empty())
 	{
-		
-		for (int i = 0; i < Scores.size() && i < CurrentScene->GetMaxScores(); ++i)
+		for (Label& ScoreLabel : ScoreLabels)
 		{
-			const int Score = Scores[i];
-			const int Position = i + 1;
-			std::string ScoreText = std::to_string(Position);
-			ScoreText += ". ";
-			ScoreText += std::to_string(Score);
-
-			glm::vec2 ScoreSize;
-			RenderText(Assets::Fonts::TextFontName, CurrentScorePos, ScoreText, TextOrient::Center, 1.0f, Colors::White, ScoreSize.x, ScoreSize.y);
+			ScoreLabel.SetPosition(CurrentScorePos);
+			ScoreLabel.Render();
 
 			CurrentScorePos.y += 35.f;
 		}
 	}
 	else
 	{
-		RenderText(Assets::Fonts::TextFontName, NoDataPos, NoDataText, TextOrient::Center, 1.0f, Colors::White, NoDataSize.x, NoDataSize.y);
+		NoDataLabel.SetPosition(CurrentScorePos);
+		NoDataLabel.Render();
 		CurrentScorePos.y += 35.f;
 	}
 
 	CurrentScorePos.y += 35.f;
-	glm::vec2 BackSize;
-	RenderText(Assets::Fonts::TextFontName, CurrentScorePos, BackText, TextOrient::Center, 1.0f, Colors::White, BackSize.x, BackSize.y);
-	RenderSelectArrows(BackText, CurrentScorePos, BackSize);
+	BackLabel.SetPosition(CurrentScorePos);
+	BackLabel.Render();
+	RenderSelectArrows(BackLabel);
+}
+
+void MainMenu::UpdateMuteLabel()
+{
+	const Game::SharedPtr CurrentScene = GetGame();
+	if (CurrentScene == nullptr)
+	{
+		return;
+	}
+
+	MuteLabel.SetText(CurrentScene->IsMuted() ? "MUTE: YES" : "MUTE: NO");
+}
+
+void MainMenu::UpdateScoreLabels()
+{
+	const Game::SharedPtr CurrentScene = GetGame();
+	if (CurrentScene == nullptr)
+	{
+		return;
+	}
+
+	const std::vector<int> Scores = CurrentScene->GetHighScores();
+	const int NumScores = std::min(static_cast<int>(Scores.size()), CurrentScene->GetMaxScores());
+	ScoreLabels.resize(NumScores, Label(Assets::Fonts::TextFontName, TextOrient::Center, 1.0f, Colors::White));
+	for (int i = 0; i < NumScores; ++i)
+	{
+		const int Position = i + 1;
+		std::string ScoreText = std::to_string(Position);
+		ScoreText += ". ";
+		ScoreText += std::to_string(Scores[i]);
+
+		ScoreLabels[i].SetText(ScoreText);
+	}
 }
 
 void MainMenu::OnChangeChoice() const
 {
+	InvalidateLayer();
 	PlayNavSound();
 }
 
@@ -232,9 +295,10 @@ void MainMenu::StartGame()
 void MainMenu::ShowScores()
 {
 	CurrentPanel = Panel::Scores;
+	InvalidateLayer();
 }
 
-void MainMenu::ToggleMute() const
+void MainMenu::ToggleMute()
 {
 	const GameSharedPtr Game = GetGame();
 	if (Game == nullptr)
@@ -243,6 +307,8 @@ void MainMenu::ToggleMute() const
 	}
 
 	Game->ToggleMute();
+	UpdateMuteLabel();
+	InvalidateLayer();
 }
 
 void MainMenu::QuitGame()
@@ -261,6 +327,15 @@ void MainMenu::QuitGame()
 void MainMenu::BackMenu()
 {
 	CurrentPanel = Panel::Main;
+	InvalidateLayer();
+}
+
+void MainMenu::InvalidateLayer() const
+{
+	if (Layer != nullptr)
+	{
+		Layer->Invalidate();
+	}
 }
 
 void MainMenu::PlayNavSound() const
@@ -276,24 +351,18 @@ void MainMenu::PlayNavSound() const
 	}
 }
 
-void MainMenu::RenderSelectArrows(const std::string& InText, const glm::vec2& OptionPos, const glm::vec2& OptionSize) const
+void MainMenu::RenderSelectArrows(const Label& Option)
 {
-	Font::SharedPtr Font = AssetManager::Get().GetFont(Assets::Fonts::TextFontName);
-	float FirstAdvance = 2.f;
-	if (Font != nullptr)
-	{
-		FirstAdvance += Font->GetCharacterAdvance(InText[0], 1.f);
-	}
-
-	const float LeftOffset = (OptionSize.x / 2.f) + FirstAdvance;
-	const float RightOffset = (OptionSize.x / 2.f);
+	const std::string& Text = Option.GetText();
+	const float FirstAdvance = 2.f + (Text.empty() ? 0.f : Option.GetCharacterAdvance(Text[0]));
 
-	const glm::vec2 LeftArrow(OptionPos.x - LeftOffset, OptionPos.y);
-	const glm::vec2 RightArrow(OptionPos.x + RightOffset, OptionPos.y);
+	const float LeftOffset = (Option.GetSize().x / 2.f) + FirstAdvance;
+	const float RightOffset = (Option.GetSize().x / 2.f);
 
-	const glm::vec4 Color(0.8f, 0.84f, 0.86f, 1.f);
+	const glm::vec2& OptionPos = Option.GetPosition();
+	LeftArrowLabel.SetPosition(glm::vec2(OptionPos.x - LeftOffset, OptionPos.y));
+	RightArrowLabel.SetPosition(glm::vec2(OptionPos.x + RightOffset, OptionPos.y));
 
-	float OutWidth, OutHeight;
-	RenderText(Assets::Fonts::TextFontName, LeftArrow, ">", TextOrient::Left, 1.0f, Color, OutWidth, OutHeight);
-	RenderText(Assets::Fonts::TextFontName, RightArrow, "<", TextOrient::Left, 1.0f, Color, OutWidth, OutHeight);
+	LeftArrowLabel.Render();
+	RightArrowLabel.Render();
 }
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "../../pk/ui/Widget.h"
+#include "../../pk/ui/Label.h"
+
+#include <vector>
+
+namespace pk
+{
+	class CachedLayer;
+}
 
 using namespace pk;
 
@@ -19,6 +27,7 @@ public:
 	typedef std::shared_ptr<MainMenu> SharedPtr;
 	typedef std::weak_ptr<Game> GameWeakPtr;
 	typedef std::shared_ptr<Game> GameSharedPtr;
+	typedef std::shared_ptr<CachedLayer> CachedLayerPtr;
 
 	static const int START_GAME_OPTION;
 	static const int SCORES_OPTION;
@@ -28,26 +37,35 @@ public:
 
 	MainMenu(const GameWeakPtr& InGame);
 
+	void Construct() override;
 	void Input(const InputHandler& Handler, const float Delta) override;
 	void Render() override;
 
+protected:
+	void OnActivate() override;
+
 private:
 	GameSharedPtr GetGame() const;
 
-	void RenderMain() const;
-	void RenderScores() const;
+	void RenderMain();
+	void RenderScores();
+
+	// Text that depends on the game is only rebuilt when it can have changed.
+	void UpdateMuteLabel();
+	void UpdateScoreLabels();
 
 	void OnChangeChoice() const;
 	void HandleChoice();
 	void StartGame();
 	void ShowScores();
-	void ToggleMute() const;
+	void ToggleMute();
 	void QuitGame();
 	void BackMenu();
+	void InvalidateLayer() const;
 
 	void PlayNavSound() const;
 
-	void RenderSelectArrows(const std::string& InText, const glm::vec2& OptionPos, const glm::vec2& OptionSize) const;
+	void RenderSelectArrows(const Label& Option);
 
 	int CurrentChoice;
 	int MaxChoice;
@@ -55,4 +73,21 @@ private:
 	GameWeakPtr GamePtr;
 
 	Panel CurrentPanel;
+
+	// Redrawn only when the choice, the panel or the mute state changes.
+	CachedLayerPtr Layer;
+
+	Label TitleLabel;
+	Label StartLabel;
+	Label ScoresLabel;
+	Label MuteLabel;
+	Label QuitLabel;
+
+	Label ScoresTitleLabel;
+	Label NoDataLabel;
+	Label BackLabel;
+	std::vector<Label> ScoreLabels;
+
+	Label LeftArrowLabel;
+	Label RightArrowLabel;
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "StatsOverlay.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "../../pk/core/render/Renderer.h"
+#include "../../pk/core/utils/Common.h"
+#include "../../pk/core/utils/Profiler.h"
+#include "../../pk/core/world/Scene.h"
+
+const float StatsOverlay::TEXT_SCALE = .6f;
+
+StatsOverlay::StatsOverlay(std::string InFontName)
+	: FontName(std::move(InFontName)), bProfilerWasEnabled(false)
+{
+}
+
+void StatsOverlay::Render()
+{
+	Widget::Render();
+
+	const Scene::SharedPtr CurrentScene = GetScene();
+	if (CurrentScene == nullptr)
+	{
+		return;
+	}
+
+	// Renderer counters are those of the last flushed frame, this one is still being queued.
+	const RenderStats Frame = Renderer::Get().GetStats();
+	const CullStats Culling = CurrentScene->GetCullStats();
+
+	// CPU scopes of the previous frame are complete, GPU ones lag by however many frames were in flight.
+	const Profiler& Timeline = Profiler::Get();
+	const int CpuFrame = Timeline.GetFrame() - 1;
+	const int GpuFrame = Timeline.GetLastGpuFrame();
+
+	std::stringstream FrameText, CullText, DrawText, CpuText, GpuText;
+	CpuText << std::fixed << std::setprecision(2) << "CPU ms:";
+	for (const char* Name : { "Update", "Render", "Flush", "Clean" })
+	{
+		CpuText << " " << Name << " " << std::max(0.0, Timeline.GetFrameTotal(Name, ProfileTrack::Cpu, CpuFrame));
+	}
+
+	GpuText << std::fixed << std::setprecision(2) << "GPU ms:";
+	for (int i = 0; i < NUM_GPU_PASSES; ++i)
+	{
+		const char* Name = GpuTimer::GetPassName(static_cast<GpuPass>(i));
+		GpuText << " " << Name << " " << std::max(0.0, Timeline.GetFrameTotal(Name, ProfileTrack::Gpu, GpuFrame));
+	}
+
+	FrameText << "FPS: " << static_cast<int>(CurrentScene->GetFps()) << "  " << CurrentScene->GetRenderWidth() << "x" << CurrentScene->GetRenderHeight();
+	CullText << "Actors: " << Culling.Visible << " visible, " << Culling.Offscreen << " culled";
+	DrawText << "Draws: " << Frame.DrawCalls << ", commands: " << Frame.Commands << ", state changes: " << Frame.StateChanges;
+
+	float OutWidth, OutHeight;
+	glm::vec2 Location(10.f, static_cast<float>(CurrentScene->GetScreenHeight()) - 10.f);
+	for (const std::string& Line : { GpuText.str(), CpuText.str(), DrawText.str(), CullText.str(), FrameText.str() })
+	{
+		RenderText(FontName, Location, Line, TextOrient::Left, TEXT_SCALE, Colors::White, OutWidth, OutHeight);
+		Location.y -= OutHeight + 4.f;
+	}
+}
+
+void StatsOverlay::OnActivate()
+{
+	Widget::OnActivate();
+	bProfilerWasEnabled = Profiler::Get().IsEnabled();
+	Profiler::Get().SetEnabled(true);
+}
+
+void StatsOverlay::OnDeactivate()
+{
+	Widget::OnDeactivate();
+	Profiler::Get().SetEnabled(bProfilerWasEnabled);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../../pk/ui/Widget.h"
+
+#include <string>
+
+using namespace pk;
+
+// Frame counters in the bottom left corner, toggled while playing to see what a frame costs.
+class StatsOverlay : public Widget
+{
+public:
+	static const float TEXT_SCALE;
+
+	StatsOverlay(std::string InFontName);
+
+	void Render() override;
+
+protected:
+	// The timing lines need the profiler, showing the overlay turns it on and hiding it restores the previous state.
+	void OnActivate() override;
+	void OnDeactivate() override;
+
+private:
+	std::string FontName;
+	bool bProfilerWasEnabled;
+};
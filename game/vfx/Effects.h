@@ -7,21 +7,30 @@ using namespace pk;
 class Explosion : public ParticlePattern::Base
 {
 public:
-	Explosion(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
-	void Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) override;
-
-	~Explosion() override = default;
-private:
-	void BuildCompass();
+	static const int NUM_DIRECTIONS = 8;
+	static const glm::vec3 COMPASS[NUM_DIRECTIONS];
 
-	std::vector<glm::vec3> Compass;
+	Explosion(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
+	void Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
 };
 
 class SpawnTexture : public ParticlePattern::Base
 {
 public:
 	SpawnTexture(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
-	void Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) override;
+	void Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
+};
 
-	~SpawnTexture() override = default;
-};
\ No newline at end of file
+inline void Explosion::Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+{
+	const int Amount = GetSpawnAmount();
+	for (int i = 0; i < Amount; ++i)
+	{
+		SpawnParticle(Target, Position, COMPASS[i % NUM_DIRECTIONS], OverrideScale);
+	}
+}
+
+inline void SpawnTexture::Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+{
+	SpawnParticle(Target, Position, glm::vec3(0.f), OverrideScale);
+}
@@ -0,0 +1,2 @@
+// stb_vorbis.c holds its implementation unless STB_VORBIS_HEADER_ONLY is defined.
+#include <stb_vorbis.c>
@@ -1,16 +1,35 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 
 #include <glad/glad.h>
 #include <stb_image.h>
 
 #include "pk/core/window/Window.h"
+#include "pk/core/asset/AssetManager.h"
+#include "pk/core/render/FrameWriter.h"
 #include "pk/core/utils/ClassSettingsReader.h"
+#include "pk/core/utils/Common.h"
+#include "pk/core/utils/Profiler.h"
+#include "pk/core/vfx/GpuParticles.h"
 #include "pk/Engine.h"
+#include "pk/sound/MixerBackend.h"
+#include "pk/sound/SoundEngine.h"
 
 #include "game/Assets.h"
+#include "game/actors/Alien.h"
+#include "game/actors/AlienFormation.h"
+#include "game/actors/Bunker.h"
 #include "game/scenes/Game.h"
+#include "game/vfx/Effects.h"
 
-Window::SharedPtr CreateWindow();
+Window::SharedPtr CreateWindow(bool bVisible);
+int RunAudioBenchmark();
+int RunWaveBenchmark();
+int RunVolleyBenchmark();
+int RunParticleValidation();
+int RunGoldenImages(const std::string& Directory, bool bUpdate);
 
 constexpr int DEFAULT_WINDOW_WIDTH = 800;
 constexpr int DEFAULT_WINDOW_HEIGHT = 600;
@@ -19,11 +38,49 @@ const std::string DEFAULT_WINDOW_TITLE = "Space Invaders";
 
 int main(int argc, char** argv)
 {
+	if (argc > 1 && std::string(argv[1]) == "--audio-bench")
+	{
+		return RunAudioBenchmark();
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--wave-bench")
+	{
+		return RunWaveBenchmark();
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--volley-bench")
+	{
+		return RunVolleyBenchmark();
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--particle-validate")
+	{
+		return RunParticleValidation();
+	}
+
+	if (argc > 2 && std::string(argv[1]) == "--golden")
+	{
+		return RunGoldenImages(argv[2], argc > 3 && std::string(argv[3]) == "--update");
+	}
+
+	// Every frame goes to disk as a numbered PNG, enough to assemble a video afterwards.
+	const bool bRecord = argc > 2 && std::string(argv[1]) == "--record";
+	// The last frames of the session go to a trace file with CPU scopes and GPU passes side by side.
+	const bool bProfile = argc > 2 && std::string(argv[1]) == "--profile";
+	// Development only, reloads configs, shaders and textures as they change on disk.
+	const bool bHotReload = std::find(argv + 1, argv + argc, std::string("--hot-reload")) != argv + argc;
+
 	Engine CurrentEngine;
+	Game::SharedPtr GamePtr;
 	try
 	{
-		Window::SharedPtr WindowPtr = CreateWindow();
-		Game::SharedPtr GamePtr = std::make_shared<Game>();
+		Window::SharedPtr WindowPtr = CreateWindow(true);
+		GamePtr = std::make_shared<Game>();
+		if (bHotReload)
+		{
+			GamePtr->SetHotReload(true);
+		}
+
 		CurrentEngine.SetWindow(WindowPtr);
 		CurrentEngine.SetCurrentScene(GamePtr);
 		CurrentEngine.Begin();
@@ -34,11 +91,40 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	FrameWriter Recorder;
+	if (bRecord)
+	{
+		Recorder.Start(argv[2], "frame_");
+		GamePtr->StartCapture(1, [&Recorder](CapturedFrame&& Frame) { Recorder.Write(std::move(Frame)); });
+	}
+
+	if (bProfile)
+	{
+		Profiler::Get().SetEnabled(true);
+	}
+
 	CurrentEngine.Run();
+
+	if (bProfile && Profiler::Get().ExportTrace(argv[2]))
+	{
+		std::cout << "[Profile] - Trace of the last " << Profiler::HISTORY_FRAMES << " frames written to " << argv[2] << "\n";
+	}
+
+	if (bRecord)
+	{
+		GamePtr->StopCapture();
+		Recorder.Stop();
+		std::cout << "[Record] - " << Recorder.GetNumWritten() << " frames written to " << argv[2] << "\n";
+		if (Recorder.GetNumDropped() > 0)
+		{
+			std::cout << "[Record] - " << Recorder.GetNumDropped() << " frames dropped, the encoder could not keep up\n";
+		}
+	}
+
 	return 0;
 }
 
-Window::SharedPtr CreateWindow()
+Window::SharedPtr CreateWindow(bool bVisible)
 {
 	int WindowWidth = DEFAULT_WINDOW_WIDTH, WindowHeight = DEFAULT_WINDOW_HEIGHT;
 	std::string WindowTitle = DEFAULT_WINDOW_TITLE;
@@ -58,9 +144,408 @@ Window::SharedPtr CreateWindow()
 	int IconWidth, IconHeight, IconChannels;
 	unsigned char* IconData = stbi_load(Assets::Textures::WindowIcon.c_str(), &IconWidth, &IconHeight, &IconChannels, 0);
 
-	Window::SharedPtr WindowPtr = std::make_shared<Window>(WindowWidth, WindowHeight, WindowTitle);
+	Window::SharedPtr WindowPtr = std::make_shared<Window>(WindowWidth, WindowHeight, WindowTitle, bVisible);
 	WindowPtr->SetIcon(IconData, IconWidth, IconHeight);
 
 	stbi_image_free(IconData);
 	return WindowPtr;
 }
+
+int RunAudioBenchmark()
+{
+	constexpr int BENCHMARK_SECONDS = 10;
+
+	MixerBackend Mixer(MixerOutput::Null);
+	Mixer.Initialize(SoundEngine::MAX_VOICES);
+
+	std::vector<std::string> Paths = String::GenerateStringsFromBase(Assets::Sounds::Shoot, 4);
+	const std::vector<std::string> MovePaths = String::GenerateStringsFromBase(Assets::Sounds::AlienMove, 4);
+	Paths.insert(Paths.end(), MovePaths.begin(), MovePaths.end());
+	Paths.push_back(Assets::Sounds::AlienExplosion);
+	Paths.push_back(Assets::Sounds::PlayerExplosion);
+
+	std::vector<int> Sounds;
+	for (const std::string& Path : Paths)
+	{
+		const int SoundIndex = Mixer.Load(Path, false);
+		if (SoundIndex >= 0)
+		{
+			Sounds.push_back(SoundIndex);
+		}
+	}
+
+	if (Sounds.empty())
+	{
+		std::cout << "[AudioBench] - No sound could be loaded\n";
+		return -1;
+	}
+
+	for (int Slot = 0; Slot < SoundEngine::MAX_VOICES; ++Slot)
+	{
+		Mixer.Play(Slot, Sounds[Slot % Sounds.size()], 0.25f, false, true);
+		Mixer.SetPitch(Slot, 0.5f + 0.05f * Slot);
+	}
+
+	std::vector<float> Buffer(static_cast<size_t>(Mixer.GetSampleRate()) * 2);
+	for (int Second = 0; Second < BENCHMARK_SECONDS; ++Second)
+	{
+		Mixer.Render(Buffer.data(), Mixer.GetSampleRate());
+	}
+
+	const MixerStats Stats = Mixer.GetStats();
+	std::cout << "[AudioBench] - " << SoundEngine::MAX_VOICES << " voices, " << BENCHMARK_SECONDS << "s of audio in " << Stats.MixMilliseconds << "ms\n";
+	std::cout << "[AudioBench] - " << Mixer.GetVoicesPerMillisecond() << " voices mixed per ms (" << Mixer.GetBlockFrames() << " frames per voice)\n";
+	std::cout << "[AudioBench] - Checksum " << std::hex << Mixer.GetChecksum() << std::dec << "\n";
+	return 0;
+}
+
+// No window, the scene lifecycle is driven by hand.
+class WaveBenchScene : public Scene
+{
+public:
+	void Flush()
+	{
+		AddPendingActors();
+		Destroyer();
+	}
+};
+
+int RunWaveBenchmark()
+{
+	constexpr int BENCHMARK_WAVES = 1000;
+	constexpr int ALIENS_PER_WAVE = 55;
+	constexpr int BUNKERS_PER_WAVE = 4;
+
+	const std::string AlienConfigs[] = { Assets::Config::SquidFile, Assets::Config::CrabFile, Assets::Config::OctopusFile };
+
+	const std::shared_ptr<WaveBenchScene> BenchScene = std::make_shared<WaveBenchScene>();
+	std::vector<Actor::SharedPtr> WaveActors;
+	for (int i = 0; i < ALIENS_PER_WAVE; ++i)
+	{
+		Alien::SharedPtr NewAlien = std::make_shared<Alien>(AlienType::Squid);
+		NewAlien->SetConfig(AlienConfigs[i % 3]);
+		WaveActors.push_back(NewAlien);
+	}
+
+	for (int i = 0; i < BUNKERS_PER_WAVE; ++i)
+	{
+		Bunker::SharedPtr NewBunker = std::make_shared<Bunker>();
+		NewBunker->SetConfig(Assets::Config::BunkerFile);
+		WaveActors.push_back(NewBunker);
+	}
+
+	for (const Actor::SharedPtr& WaveActor : WaveActors)
+	{
+		BenchScene->Add(WaveActor);
+	}
+
+	BenchScene->Flush();
+
+	auto RunWaves = [&BenchScene, &WaveActors](bool bActivate)
+	{
+		const auto Start = std::chrono::steady_clock::now();
+		for (int Wave = 0; Wave < BENCHMARK_WAVES; ++Wave)
+		{
+			for (const Actor::SharedPtr& WaveActor : WaveActors)
+			{
+				WaveActor->Destroy();
+			}
+
+			BenchScene->Flush();
+
+			for (const Actor::SharedPtr& WaveActor : WaveActors)
+			{
+				if (bActivate)
+				{
+					BenchScene->Activate(WaveActor);
+				}
+				else
+				{
+					BenchScene->Add(WaveActor);
+				}
+			}
+
+			BenchScene->Flush();
+		}
+
+		const std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+		return Elapsed.count() / BENCHMARK_WAVES;
+	};
+
+	const double AddMilliseconds = RunWaves(false);
+	const double ActivateMilliseconds = RunWaves(true);
+
+	std::cout << "[WaveBench] - " << WaveActors.size() << " actors, " << BENCHMARK_WAVES << " restarts\n";
+	std::cout << "[WaveBench] - Add " << AddMilliseconds << "ms per wave, Activate " << ActivateMilliseconds << "ms per wave\n";
+	std::cout << "[WaveBench] - " << BenchScene->GetNumActors() << " actors live\n";
+	return 0;
+}
+
+int RunVolleyBenchmark()
+{
+	constexpr int BENCHMARK_ROWS = 100;
+	constexpr int BENCHMARK_COLS = 100;
+	constexpr int BENCHMARK_VOLLEYS = 100000;
+	constexpr int SHOOTERS_PER_VOLLEY = 8;
+	constexpr unsigned int BENCHMARK_SEED = 1234;
+
+	const std::pair<VolleyPattern, std::string> Patterns[] = {
+		{ VolleyPattern::Random, "Random" },
+		{ VolleyPattern::Columns, "Columns" },
+		{ VolleyPattern::Burst, "Burst" },
+		{ VolleyPattern::Aimed, "Aimed" }
+	};
+
+	AlienFormation Formation;
+	Formation.Resize(BENCHMARK_ROWS, BENCHMARK_COLS);
+	Formation.ReviveAll();
+
+	// Same holes on every run: a third of the formation in seeded random kills, repeats included,
+	// so about 28% ends up dead. Volleys only select shooters, nobody dies while timing.
+	Random::REngine KillEngine(BENCHMARK_SEED);
+	for (int i = 0; i < Formation.GetNum() / 3; ++i)
+	{
+		Formation.Kill(Random::Get(KillEngine, 0, Formation.GetNum() - 1));
+	}
+
+	std::vector<int> Shooters;
+	Shooters.reserve(BENCHMARK_COLS);
+
+	std::cout << "[VolleyBench] - " << Formation.GetNumAlive() << " of " << Formation.GetNum() << " aliens alive, " << BENCHMARK_VOLLEYS << " volleys\n";
+	for (const std::pair<VolleyPattern, std::string>& Pattern : Patterns)
+	{
+		Random::REngine ShootEngine(BENCHMARK_SEED);
+		long long Checksum = 0;
+
+		const auto Start = std::chrono::steady_clock::now();
+		for (int Volley = 0; Volley < BENCHMARK_VOLLEYS; ++Volley)
+		{
+			Formation.SelectShooters(Pattern.first, SHOOTERS_PER_VOLLEY, Volley % BENCHMARK_COLS, ShootEngine, Shooters);
+			for (const int Shooter : Shooters)
+			{
+				Checksum += Shooter;
+			}
+		}
+
+		const std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+		std::cout << "[VolleyBench] - " << Pattern.second << " " << Elapsed.count() / BENCHMARK_VOLLEYS << "ns per volley, checksum " << Checksum << "\n";
+	}
+
+	return 0;
+}
+
+// Runs the same spawns through a CPU and a GPU emitter and compares the particles.
+// Meant for a software context as well, e.g. LIBGL_ALWAYS_SOFTWARE=1 on Mesa runs it on llvmpipe.
+int RunParticleValidation()
+{
+	constexpr int VALIDATION_FRAMES = 240;
+	constexpr int SPAWN_EVERY = 3;
+	constexpr int CHECK_EVERY = 30;
+	constexpr int PARTICLE_CAPACITY = 4096;
+	constexpr float FRAME_DELTA = 1.f / 60.f;
+	constexpr float TOLERANCE = 1e-3f;
+
+	Window::SharedPtr WindowPtr;
+	try
+	{
+		WindowPtr = CreateWindow(false);
+		AssetManager::Get().LoadFeedbackShader(Assets::Shaders::ParticleFeedbackName, Assets::Shaders::ParticleFeedbackVertexFile, Assets::Shaders::ParticleFeedbackGeometryFile, GpuParticles::FEEDBACK_VARYINGS);
+		AssetManager::Get().LoadShader(Assets::Shaders::ParticleGpuName, Assets::Shaders::ParticleGpuVertexFile, Assets::Shaders::ParticleGpuGeometryFile, Assets::Shaders::ParticleTextureFragmentFile);
+	}
+	catch (const std::runtime_error& Error)
+	{
+		std::cout << "[ParticleValidate] - Unable to set up GL: " << Error.what() << "\n";
+		return -1;
+	}
+
+	std::cout << "[ParticleValidate] - " << glGetString(GL_RENDERER) << "\n";
+
+	const Explosion Pattern(120.f, 1.5f, Explosion::NUM_DIRECTIONS, Colors::White);
+	Emitter<Explosion> CpuEmitter(PARTICLE_CAPACITY, 5.f, Assets::Shaders::ParticleTextureName, Assets::Textures::ExplosionName, Pattern);
+	Emitter<Explosion> GpuEmitter(PARTICLE_CAPACITY, 5.f, Assets::Shaders::ParticleTextureName, Assets::Textures::ExplosionName, Pattern);
+	// Data-driven emitters go through the type erased wrapper, it has to behave like the emitter it wraps.
+	AnyEmitter WrappedEmitter(PARTICLE_CAPACITY, 5.f, Assets::Shaders::ParticleTextureName, Assets::Textures::ExplosionName, Pattern);
+	CpuEmitter.SetOverflowPolicy(ParticleOverflow::Grow);
+	WrappedEmitter.SetOverflowPolicy(ParticleOverflow::Grow);
+	GpuEmitter.EnableGpuSimulation(PARTICLE_CAPACITY, Assets::Shaders::ParticleFeedbackName, Assets::Shaders::ParticleGpuName);
+
+	// Pool order differs between the two, particles are compared once sorted.
+	auto SortParticles = [](EmitterBase::ParticleList& Particles)
+	{
+		std::sort(Particles.begin(), Particles.end(), [](const Particle& A, const Particle& B)
+			{
+				if (A.Life != B.Life) return A.Life < B.Life;
+				if (A.Direction.x != B.Direction.x) return A.Direction.x < B.Direction.x;
+				if (A.Direction.y != B.Direction.y) return A.Direction.y < B.Direction.y;
+				return A.Position.x < B.Position.x;
+			}
+		);
+	};
+
+	EmitterBase::ParticleList CpuParticles, GpuReadBack;
+	bool bPassed = true;
+	for (int Frame = 1; Frame <= VALIDATION_FRAMES; ++Frame)
+	{
+		if (Frame % SPAWN_EVERY == 0)
+		{
+			const glm::vec3 Position(static_cast<float>(Frame * 7 % 800), static_cast<float>(Frame * 13 % 600), 0.f);
+			const float OverrideScale = (Frame % 2 == 0) ? 10.f : -1.f;
+			CpuEmitter.Spawn(Position, OverrideScale);
+			GpuEmitter.Spawn(Position, OverrideScale);
+			WrappedEmitter.Spawn(Position, OverrideScale);
+		}
+
+		CpuEmitter.Update(FRAME_DELTA);
+		GpuEmitter.Update(FRAME_DELTA);
+		WrappedEmitter.Update(FRAME_DELTA);
+
+		if (Frame % CHECK_EVERY != 0)
+		{
+			continue;
+		}
+
+		CpuEmitter.ReadBack(CpuParticles);
+		GpuEmitter.ReadBack(GpuReadBack);
+		SortParticles(CpuParticles);
+		SortParticles(GpuReadBack);
+
+		float MaxError = 0.f;
+		const bool bSameCount = CpuParticles.size() == GpuReadBack.size();
+		for (std::size_t i = 0; bSameCount && i < CpuParticles.size(); ++i)
+		{
+			const Particle& Cpu = CpuParticles[i];
+			const Particle& Gpu = GpuReadBack[i];
+			MaxError = std::max(MaxError, std::abs(Cpu.Life - Gpu.Life));
+			MaxError = std::max(MaxError, std::abs(Cpu.Color.a - Gpu.Color.a));
+			MaxError = std::max(MaxError, std::abs(Cpu.OverrideScale - Gpu.OverrideScale));
+			MaxError = std::max(MaxError, glm::length(Cpu.Position - Gpu.Position));
+			MaxError = std::max(MaxError, glm::length(Cpu.Direction - Gpu.Direction));
+		}
+
+		const EmitterStats CpuStats = CpuEmitter.GetStats();
+		const EmitterStats WrappedStats = WrappedEmitter.GetStats();
+		const bool bWrappedValid = WrappedStats.Live == CpuStats.Live && WrappedStats.HighWater == CpuStats.HighWater
+			&& WrappedStats.Dropped == CpuStats.Dropped && WrappedStats.Grown == CpuStats.Grown;
+
+		const bool bFrameValid = bSameCount && MaxError <= TOLERANCE && bWrappedValid;
+		bPassed = bPassed && bFrameValid;
+		std::cout << "[ParticleValidate] - Frame " << Frame << ": CPU " << CpuParticles.size() << ", GPU " << GpuReadBack.size()
+			<< ", wrapped " << WrappedStats.Live << " particles, max error " << MaxError << (bFrameValid ? "" : " MISMATCH") << "\n";
+	}
+
+	std::cout << "[ParticleValidate] - " << (bPassed ? "PASS" : "FAIL") << "\n";
+	return bPassed ? 0 : 1;
+}
+
+// Plays a fixed stretch of the game headless with a fixed seed and timestep, then compares sampled frames with reference PNGs.
+// --update rewrites the references instead, after an intended visual change.
+int RunGoldenImages(const std::string& Directory, bool bUpdate)
+{
+	constexpr int GOLDEN_FRAMES = 600;
+	constexpr int CAPTURE_EVERY = 60;
+	constexpr float FRAME_DELTA = 1.f / 60.f;
+	constexpr unsigned int GOLDEN_SEED = 1234;
+	// Drivers round blending differently, a channel may be that far off before its pixel counts as different.
+	constexpr int CHANNEL_TOLERANCE = 8;
+	constexpr float MAX_DIFFERENT_PIXELS = .001f;
+	const std::string GOLDEN_PREFIX = "golden_";
+	const std::string FAILED_PREFIX = "failed_";
+
+	// Before anything is spawned, the aliens' shoot engines take their seeds from it.
+	Random::SetSeed(GOLDEN_SEED);
+	SoundEngine::Get().SetBackend(std::make_unique<MixerBackend>(MixerOutput::Null));
+
+	Engine CurrentEngine;
+	Game::SharedPtr GamePtr;
+	try
+	{
+		Window::SharedPtr WindowPtr = CreateWindow(false);
+		GamePtr = std::make_shared<Game>();
+		CurrentEngine.SetWindow(WindowPtr);
+		CurrentEngine.SetCurrentScene(GamePtr);
+		CurrentEngine.Begin();
+	}
+	catch (const std::runtime_error& Error)
+	{
+		std::cout << "[Golden] - Unable to set up the game: " << Error.what() << "\n";
+		return -1;
+	}
+
+	std::cout << "[Golden] - " << glGetString(GL_RENDERER) << "\n";
+
+	GamePtr->SetOffscreen(true);
+	GamePtr->SetFixedDelta(FRAME_DELTA);
+	GamePtr->SetRenderScale(1.f);
+	GamePtr->SetDynamicResolution(false, ResolutionController::DEFAULT_FRAME_BUDGET, ResolutionController::DEFAULT_MIN_SCALE);
+
+	// The menu shows the local save, the run starts straight in game.
+	GamePtr->Play();
+
+	FrameCapture::FrameList Frames;
+	GamePtr->StartCapture(CAPTURE_EVERY, [&Frames](CapturedFrame&& Frame) { Frames.push_back(std::move(Frame)); });
+	for (int i = 0; i < GOLDEN_FRAMES; ++i)
+	{
+		GamePtr->Frame();
+	}
+
+	GamePtr->StopCapture();
+
+	bool bPassed = static_cast<int>(Frames.size()) == GOLDEN_FRAMES / CAPTURE_EVERY;
+	if (!bPassed)
+	{
+		std::cout << "[Golden] - Only " << Frames.size() << " of " << GOLDEN_FRAMES / CAPTURE_EVERY << " frames captured\n";
+	}
+
+	if (bUpdate)
+	{
+		File::CreateFolder(Directory);
+	}
+
+	for (const CapturedFrame& Frame : Frames)
+	{
+		const std::string Path = FrameWriter::GetFramePath(Directory, GOLDEN_PREFIX, Frame.Index);
+		if (bUpdate)
+		{
+			const bool bWritten = FrameWriter::WritePng(Path, Frame);
+			bPassed = bPassed && bWritten;
+			std::cout << "[Golden] - " << (bWritten ? "Wrote " : "Unable to write ") << Path << "\n";
+			continue;
+		}
+
+		CapturedFrame Reference;
+		if (!FrameWriter::ReadPng(Path, Reference) || Reference.Width != Frame.Width || Reference.Height != Frame.Height)
+		{
+			bPassed = false;
+			std::cout << "[Golden] - Frame " << Frame.Index << ": no " << Frame.Width << "x" << Frame.Height << " reference at " << Path << "\n";
+			continue;
+		}
+
+		int NumDifferent = 0;
+		int MaxError = 0;
+		for (std::size_t Pixel = 0; Pixel < Frame.Pixels.size(); Pixel += 4)
+		{
+			int PixelError = 0;
+			for (std::size_t Channel = 0; Channel < 4; ++Channel)
+			{
+				PixelError = std::max(PixelError, std::abs(Frame.Pixels[Pixel + Channel] - Reference.Pixels[Pixel + Channel]));
+			}
+
+			MaxError = std::max(MaxError, PixelError);
+			NumDifferent += PixelError > CHANNEL_TOLERANCE ? 1 : 0;
+		}
+
+		const float DifferentRatio = static_cast<float>(NumDifferent) / static_cast<float>(Frame.Width * Frame.Height);
+		const bool bFrameValid = DifferentRatio <= MAX_DIFFERENT_PIXELS;
+		bPassed = bPassed && bFrameValid;
+		std::cout << "[Golden] - Frame " << Frame.Index << ": " << NumDifferent << " pixels differ, max error " << MaxError << (bFrameValid ? "" : " MISMATCH") << "\n";
+
+		// Kept next to the reference for a side by side look.
+		if (!bFrameValid)
+		{
+			FrameWriter::WritePng(FrameWriter::GetFramePath(Directory, FAILED_PREFIX, Frame.Index), Frame);
+		}
+	}
+
+	std::cout << "[Golden] - " << (bPassed ? "PASS" : "FAIL") << "\n";
+	return bPassed ? 0 : 1;
+}
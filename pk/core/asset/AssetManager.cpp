@@ -23,6 +23,37 @@ Shader::SharedPtr AssetManager::LoadShader(const std::string& Name, const std::s
 	return NewShader;
 }
 
+Shader::SharedPtr AssetManager::LoadShader(const std::string& Name, const std::string& Vertex, const std::string& Geometry, const std::string& Fragment)
+{
+	Shader::SharedPtr FoundShader = GetShader(Name);
+	if (FoundShader != nullptr)
+	{
+		return FoundShader;
+	}
+
+	Shader::SharedPtr NewShader = std::make_shared<Shader>();
+	NewShader->Compile(Vertex, Geometry, Fragment);
+	Shaders.insert(ShaderPair(Name, NewShader));
+
+	return NewShader;
+}
+
+Shader::SharedPtr AssetManager::LoadFeedbackShader(const std::string& Name, const std::string& Vertex, const std::string& Geometry, const std::vector<std::string>& Varyings)
+{
+	Shader::SharedPtr FoundShader = GetShader(Name);
+	if (FoundShader != nullptr)
+	{
+		return FoundShader;
+	}
+
+	Shader::SharedPtr NewShader = std::make_shared<Shader>();
+	NewShader->SetFeedbackVaryings(Varyings);
+	NewShader->Compile(Vertex, Geometry, "");
+	Shaders.insert(ShaderPair(Name, NewShader));
+
+	return NewShader;
+}
+
 Texture::SharedPtr AssetManager::LoadTexture(const std::string& Name, const std::string& Path, int InFormat, int InWrapS, int InWrapT, int InMinFilter, int InMaxFilter)
 {
 	Texture::SharedPtr FoundTexture = GetTexture(Name);
@@ -61,7 +92,22 @@ AssetManager::SoundSharedPtr AssetManager::LoadSound(const std::string& Name, co
 	}
 
 	std::shared_ptr<SimpleSound> NewSound = std::make_shared<SimpleSound>(Path);
-	SoundEngine::Get().Load(Path);
+	SoundEngine::Get().Load(Path, Name, false);
+	Sounds.insert(SoundPair(Name, NewSound));
+
+	return NewSound;
+}
+
+AssetManager::SoundSharedPtr AssetManager::LoadMusic(const std::string& Name, const std::string& Path)
+{
+	SoundSharedPtr FoundSound = GetSound(Name);
+	if (FoundSound != nullptr)
+	{
+		return FoundSound;
+	}
+
+	std::shared_ptr<SimpleSound> NewSound = std::make_shared<SimpleSound>(Path);
+	SoundEngine::Get().Load(Path, Name, true);
 	Sounds.insert(SoundPair(Name, NewSound));
 
 	return NewSound;
@@ -79,7 +125,7 @@ AssetManager::SoundSharedPtr AssetManager::LoadSequenceSound(const std::string&
 	std::shared_ptr<SequenceSound> NewSound = std::make_shared<SequenceSound>(Paths);
 	for (const std::string& Path : Paths)
 	{
-		SoundEngine::Get().Load(Path);
+		SoundEngine::Get().Load(Path, Name, false);
 	}
 
 	Sounds.insert(SoundPair(Name, NewSound));
@@ -98,7 +144,7 @@ AssetManager::SoundSharedPtr AssetManager::LoadRandomSound(const std::string& Na
 	std::shared_ptr<RandomSound> NewSound = std::make_shared<RandomSound>(Paths);
 	for (const std::string& Path : Paths)
 	{
-		SoundEngine::Get().Load(Path);
+		SoundEngine::Get().Load(Path, Name, false);
 	}
 
 	Sounds.insert(SoundPair(Name, NewSound));
@@ -144,3 +190,32 @@ Shader::SharedPtr AssetManager::GetShader(const std::string& Name)
 
 	return Shaders[Name];
 }
+
+int AssetManager::ReloadShaders(const std::string& Path, const std::string& Content)
+{
+	int Reloaded = 0;
+	for (const ShaderMap::value_type& Pair : Shaders)
+	{
+		if (Pair.second->UsesFile(Path) && Pair.second->Reload(Path, Content))
+		{
+			Reloaded++;
+		}
+	}
+
+	return Reloaded;
+}
+
+int AssetManager::ReloadTextures(const std::string& Path, const unsigned char* Data, int Width, int Height, int Channels)
+{
+	int Reloaded = 0;
+	for (const TextureMap::value_type& Pair : Textures)
+	{
+		if (Pair.second->GetPath() == Path)
+		{
+			Pair.second->Reload(Data, Width, Height, Channels);
+			Reloaded++;
+		}
+	}
+
+	return Reloaded;
+}
@@ -35,9 +35,13 @@ namespace pk
 		}
 
 		Shader::SharedPtr LoadShader(const std::string& Name, const std::string& Vertex, const std::string& Fragment);
+		Shader::SharedPtr LoadShader(const std::string& Name, const std::string& Vertex, const std::string& Geometry, const std::string& Fragment);
+		// No fragment stage, the listed outputs are captured through transform feedback.
+		Shader::SharedPtr LoadFeedbackShader(const std::string& Name, const std::string& Vertex, const std::string& Geometry, const std::vector<std::string>& Varyings);
 		Texture::SharedPtr LoadTexture(const std::string& Name, const std::string& Path, int InFormat, int InWrapS, int InWrapT, int InMinFilter, int InMaxFilter);
 		Font::SharedPtr LoadFont(const std::string& Name, const std::string& Path, const std::string& ShaderName);
 		SoundSharedPtr LoadSound(const std::string& Name, const std::string& Path);
+		SoundSharedPtr LoadMusic(const std::string& Name, const std::string& Path);
 		SoundSharedPtr LoadSequenceSound(const std::string& Name, const std::vector<std::string>& Paths);
 		SoundSharedPtr LoadRandomSound(const std::string& Name, const std::vector<std::string>& Paths);
 
@@ -46,6 +50,9 @@ namespace pk
 		Font::SharedPtr GetFont(const std::string& Name);
 		SoundSharedPtr GetSound(const std::string& Name);
 
+		int ReloadShaders(const std::string& Path, const std::string& Content);
+		int ReloadTextures(const std::string& Path, const unsigned char* Data, int Width, int Height, int Channels);
+
 	private:
 		ShaderMap Shaders;
 		TextureMap Textures;
@@ -1,6 +1,9 @@
 #include "Font.h"
 #include "Shader.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
 #include <glad/glad.h>
 
 #include "AssetManager.h"
@@ -8,6 +11,8 @@
 
 using namespace pk;
 
+const int Font::ATLAS_WIDTH = 512;
+
 Font::Font(std::string InPath, std::string InName, std::string InTextShader)
 	: Path(std::move(InPath)), Name(std::move(InName)), TextShader(std::move(InTextShader)), Size(14)
 {
@@ -69,6 +74,15 @@ void Font::Render(const std::string& Text, const glm::vec2& Position, float Scal
     Renderer::Get().RenderText(Text, GetShader(), Characters, Position, Scale, Color);
 }
 
+void Font::BuildVertices(const std::string& Text, const glm::vec2& Position, float Scale, const glm::vec4& Color, std::vector<StreamVertex>& OutVertices) const
+{
+    OutVertices.resize(Text.size() * 6);
+    if (!Text.empty())
+    {
+        Renderer::WriteGlyphs(Text.data(), static_cast<int>(Text.size()), Characters, Position, Scale, Color, OutVertices.data());
+    }
+}
+
 void Font::GetTextSize(const std::string& Text, float Scale, float& OutHSize, float& OutVSize) const
 {
     OutHSize = 0;
@@ -97,9 +111,26 @@ Font::CharacterMap Font::GetCharacterMap() const
     return Characters;
 }
 
+unsigned int Font::GetAtlasId() const
+{
+    return AtlasId;
+}
+
 void Font::LoadCharacters(FT_Face& Face, int InWrapMode, int InFilterMode)
 {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    struct GlyphBitmap
+    {
+        char Code;
+        Character Glyph;
+        glm::ivec2 Origin;
+        std::vector<unsigned char> Pixels;
+    };
+
+    // Glyphs are packed in rows into one atlas, so any string is drawn from a single texture.
+    constexpr int Padding = 1;
+    std::vector<GlyphBitmap> Bitmaps;
+    glm::ivec2 Cursor(Padding, Padding);
+    int RowHeight = 0;
 
     for (unsigned char c = 0; c < 128; c++)
     {
@@ -109,35 +140,76 @@ void Font::LoadCharacters(FT_Face& Face, int InWrapMode, int InFilterMode)
             continue;
         }
 
-        // generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            Face->glyph->bitmap.width,
-            Face->glyph->bitmap.rows,
+        const FT_Bitmap& Bitmap = Face->glyph->bitmap;
+        const int Width = static_cast<int>(Bitmap.width);
+        const int Rows = static_cast<int>(Bitmap.rows);
+        if (Cursor.x + Width + Padding > ATLAS_WIDTH)
+        {
+            Cursor = glm::ivec2(Padding, Cursor.y + RowHeight + Padding);
+            RowHeight = 0;
+        }
+
+        GlyphBitmap Entry;
+        Entry.Code = static_cast<char>(c);
+        Entry.Origin = Cursor;
+        Entry.Glyph = {
             0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            Face->glyph->bitmap.buffer
-        );
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, InWrapMode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, InWrapMode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, InFilterMode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, InFilterMode);
-        // now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(Face->glyph->bitmap.width, Face->glyph->bitmap.rows),
+            glm::ivec2(Width, Rows),
             glm::ivec2(Face->glyph->bitmap_left, Face->glyph->bitmap_top),
-            Face->glyph->advance.x
+            static_cast<unsigned int>(Face->glyph->advance.x),
+            glm::vec2(0.f),
+            glm::vec2(0.f)
         };
 
-        Characters.insert(std::pair<char, Character>(c, character));
+        // FreeType rows may be padded, copy them tight.
+        Entry.Pixels.resize(Width * Rows);
+        for (int Row = 0; Row < Rows; ++Row)
+        {
+            std::memcpy(&Entry.Pixels[Row * Width], Bitmap.buffer + Row * Bitmap.pitch, Width);
+        }
+
+        Bitmaps.push_back(std::move(Entry));
+        Cursor.x += Width + Padding;
+        RowHeight = std::max(RowHeight, Rows);
+    }
+
+    int AtlasHeight = 1;
+    while (AtlasHeight < Cursor.y + RowHeight + Padding)
+    {
+        AtlasHeight *= 2;
     }
-}
 
+    if (AtlasId == 0)
+    {
+        glGenTextures(1, &AtlasId);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    glBindTexture(GL_TEXTURE_2D, AtlasId);
+
+    const std::vector<unsigned char> Blank(ATLAS_WIDTH * AtlasHeight, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, ATLAS_WIDTH, AtlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, Blank.data());
+    // set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, InWrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, InWrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, InFilterMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, InFilterMode);
+
+    const glm::vec2 AtlasSize(static_cast<float>(ATLAS_WIDTH), static_cast<float>(AtlasHeight));
+    for (GlyphBitmap& Entry : Bitmaps)
+    {
+        const glm::ivec2 GlyphSize = Entry.Glyph.Size;
+        if (GlyphSize.x > 0 && GlyphSize.y > 0)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, Entry.Origin.x, Entry.Origin.y, GlyphSize.x, GlyphSize.y, GL_RED, GL_UNSIGNED_BYTE, Entry.Pixels.data());
+        }
+
+        // now store character for later use
+        Entry.Glyph.TextureID = AtlasId;
+        Entry.Glyph.UvMin = glm::vec2(Entry.Origin) / AtlasSize;
+        Entry.Glyph.UvMax = glm::vec2(Entry.Origin + GlyphSize) / AtlasSize;
+        Characters.insert(std::pair<char, Character>(Entry.Code, Entry.Glyph));
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "Shader.h"
 
@@ -13,11 +14,15 @@
 
 namespace pk
 {
+	struct StreamVertex;
+
 	struct Character {
-		unsigned int TextureID;  // ID handle of the glyph texture
+		unsigned int TextureID;  // ID handle of the font atlas
 		glm::ivec2   Size;       // Size of glyph
 		glm::ivec2   Bearing;    // Offset from baseline to left/top of glyph
 		unsigned int Advance;    // Offset to advance to next glyph
+		glm::vec2    UvMin;      // Glyph rectangle inside the atlas
+		glm::vec2    UvMax;
 	};
 
 	class Font
@@ -26,6 +31,8 @@ namespace pk
 		typedef std::shared_ptr<Font> SharedPtr;
 		typedef std::map<char, Character> CharacterMap;
 
+		static const int ATLAS_WIDTH;
+
 		Font(std::string InPath, std::string InName, std::string InTextShader);
 
 		std::string GetName() const;
@@ -36,10 +43,13 @@ namespace pk
 
 		void Load(unsigned int InSize, int InWrapMode, int InFilterMode);
 		void Render(const std::string& Text, const glm::vec2& Position, float Scale, const glm::vec4& Color) const;
+		// Lays the text out once into OutVertices, for callers that draw the same string over many frames.
+		void BuildVertices(const std::string& Text, const glm::vec2& Position, float Scale, const glm::vec4& Color, std::vector<StreamVertex>& OutVertices) const;
 		void GetTextSize(const std::string& Text, float Scale, float& OutHSize, float& OutVSize) const;
 		float GetCharacterAdvance(char InCharacter, float Scale) const;
 
 		CharacterMap GetCharacterMap() const;
+		unsigned int GetAtlasId() const;
 
 		class LoadError : public std::runtime_error
 		{
@@ -55,6 +65,7 @@ namespace pk
 		unsigned int Size;
 
 		CharacterMap Characters;
+		unsigned int AtlasId = 0;
 
 		glm::mat4 Projection;
 
@@ -0,0 +1,172 @@
+#include "HotReload.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stb_image.h>
+
+#include "AssetManager.h"
+#include "../utils/ClassSettingsReader.h"
+#include "../utils/Common.h"
+
+using namespace pk;
+
+const int HotReload::DEFAULT_MAX_RELOADS_PER_FRAME = 2;
+
+PendingReload::PendingReload()
+	: Type(ReloadType::Config), Width(0), Height(0), Channels(0)
+{
+}
+
+HotReload::HotReload()
+	: MaxReloadsPerFrame(DEFAULT_MAX_RELOADS_PER_FRAME)
+{
+}
+
+void HotReload::Start(const std::string& InRootPath)
+{
+	Watcher.Start(InRootPath, [this](const std::string& Path) { OnFileChanged(Path); });
+	std::cout << "[HotReload] - Watching " << Watcher.GetRootPath() << "\n";
+}
+
+void HotReload::Stop()
+{
+	Watcher.Stop();
+
+	std::lock_guard<std::mutex> Lock(ReadyMutex);
+	ReadyReloads.clear();
+}
+
+bool HotReload::IsRunning() const
+{
+	return Watcher.IsRunning();
+}
+
+void HotReload::SetMaxReloadsPerFrame(int InMaxReloads)
+{
+	MaxReloadsPerFrame = std::max(1, InMaxReloads);
+}
+
+int HotReload::GetMaxReloadsPerFrame() const
+{
+	return MaxReloadsPerFrame;
+}
+
+void HotReload::Update(PathList& OutReloadedPaths)
+{
+	for (int i = 0; i < MaxReloadsPerFrame; ++i)
+	{
+		PendingReload Reload;
+		{
+			std::lock_guard<std::mutex> Lock(ReadyMutex);
+			if (ReadyReloads.empty())
+			{
+				return;
+			}
+
+			Reload = std::move(ReadyReloads.front());
+			ReadyReloads.pop_front();
+		}
+
+		if (Apply(Reload))
+		{
+			std::cout << "[HotReload] - Reloaded " << Reload.Path << "\n";
+			OutReloadedPaths.push_back(Reload.Path);
+		}
+	}
+}
+
+HotReload::~HotReload()
+{
+	Stop();
+}
+
+void HotReload::OnFileChanged(const std::string& Path)
+{
+	PendingReload Reload;
+	if (!Prepare(Path, Reload))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> Lock(ReadyMutex);
+	ReadyReloads.erase(
+		std::remove_if(ReadyReloads.begin(), ReadyReloads.end(), [&Path](const PendingReload& Queued) { return Queued.Path == Path; }),
+		ReadyReloads.end()
+	);
+
+	ReadyReloads.push_back(std::move(Reload));
+}
+
+bool HotReload::Prepare(const std::string& Path, PendingReload& OutReload) const
+{
+	const std::string Extension = GetExtension(Path);
+	OutReload.Path = Path;
+
+	if (Extension == "txt")
+	{
+		OutReload.Type = ReloadType::Config;
+		OutReload.Settings = ClassSettingsReader::ReadFile(Path);
+		return OutReload.Settings != nullptr;
+	}
+
+	if (Extension == "vert" || Extension == "frag")
+	{
+		OutReload.Type = ReloadType::Shader;
+		try
+		{
+			OutReload.Content = File::ReadAll(Path);
+		}
+		catch (const std::ifstream::failure& Error)
+		{
+			std::cout << "[HotReload] - Unable to read " << Path << " " << Error.what() << "\n";
+			return false;
+		}
+
+		return !OutReload.Content.empty();
+	}
+
+	if (Extension == "png" || Extension == "jpg")
+	{
+		OutReload.Type = ReloadType::Texture;
+		unsigned char* Data = stbi_load(Path.c_str(), &OutReload.Width, &OutReload.Height, &OutReload.Channels, 0);
+		if (Data == nullptr)
+		{
+			std::cout << "[HotReload] - Unable to decode " << Path << "\n";
+			return false;
+		}
+
+		const size_t Size = static_cast<size_t>(OutReload.Width) * OutReload.Height * OutReload.Channels;
+		OutReload.Pixels.assign(Data, Data + Size);
+		stbi_image_free(Data);
+		return true;
+	}
+
+	return false;
+}
+
+bool HotReload::Apply(PendingReload& Reload) const
+{
+	switch (Reload.Type)
+	{
+	case ReloadType::Config:
+		return ClassSettingsReader::Replace(Reload.Path, Reload.Settings);
+	case ReloadType::Shader:
+		return AssetManager::Get().ReloadShaders(Reload.Path, Reload.Content) > 0;
+	case ReloadType::Texture:
+		return AssetManager::Get().ReloadTextures(Reload.Path, Reload.Pixels.data(), Reload.Width, Reload.Height, Reload.Channels) > 0;
+	}
+
+	return false;
+}
+
+std::string HotReload::GetExtension(const std::string& Path)
+{
+	const size_t Dot = Path.find_last_of('.');
+	if (Dot == std::string::npos)
+	{
+		return "";
+	}
+
+	return String::ToLower(Path.substr(Dot + 1));
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../utils/ClassSettings.h"
+#include "../utils/FileWatcher.h"
+
+namespace pk
+{
+	enum class ReloadType : std::uint8_t
+	{
+		Config,
+		Shader,
+		Texture
+	};
+
+	struct PendingReload
+	{
+		ReloadType Type;
+		std::string Path;
+
+		ClassSettings::SharedConstPtr Settings;
+		std::string Content;
+		std::vector<unsigned char> Pixels;
+		int Width;
+		int Height;
+		int Channels;
+
+		PendingReload();
+	};
+
+	class HotReload
+	{
+	public:
+		typedef std::vector<std::string> PathList;
+
+		static const int DEFAULT_MAX_RELOADS_PER_FRAME;
+
+		static HotReload& Get()
+		{
+			static HotReload Instance;
+			return Instance;
+		}
+
+		HotReload(const HotReload& InHotReload) = delete;
+		void operator=(const HotReload& InHotReload) = delete;
+
+		void Start(const std::string& InRootPath);
+		void Stop();
+		bool IsRunning() const;
+
+		void SetMaxReloadsPerFrame(int InMaxReloads);
+		int GetMaxReloadsPerFrame() const;
+
+		// Main thread only: applies a bounded amount of prepared reloads and reports which paths changed.
+		void Update(PathList& OutReloadedPaths);
+
+		~HotReload();
+
+	private:
+		HotReload();
+
+		void OnFileChanged(const std::string& Path);
+		bool Prepare(const std::string& Path, PendingReload& OutReload) const;
+		bool Apply(PendingReload& Reload) const;
+
+		static std::string GetExtension(const std::string& Path);
+
+		int MaxReloadsPerFrame;
+
+		FileWatcher Watcher;
+
+		std::mutex ReadyMutex;
+		std::deque<PendingReload> ReadyReloads;
+	};
+}
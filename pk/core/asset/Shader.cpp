@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 
 #include <fstream>
+#include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "../utils/Common.h"
@@ -29,19 +30,67 @@ unsigned int Shader::GetShaderId() const
 }
 
 void Shader::Compile(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+{
+    Compile(vertexShaderPath, "", fragmentShaderPath);
+}
+
+void Shader::Compile(const std::string& vertexShaderPath, const std::string& geometryShaderPath, const std::string& fragmentShaderPath)
 {
     bIsCompiled = false;
 
-    Initialize(vertexShaderPath, fragmentShaderPath);
+    Initialize(vertexShaderPath, geometryShaderPath, fragmentShaderPath);
 
     bIsCompiled = true;
 }
 
+void Shader::SetFeedbackVaryings(const std::vector<std::string>& varyings)
+{
+    feedbackVaryings = varyings;
+}
+
 void Shader::Use() const
 {
     glUseProgram(shaderId);
 }
 
+bool Shader::UsesFile(const std::string& path) const
+{
+    if (path.empty())
+    {
+        return false;
+    }
+
+    return path == vertexPath || path == geometryPath || path == fragmentPath;
+}
+
+bool Shader::Reload(const std::string& path, const std::string& content)
+{
+    if (!UsesFile(path))
+    {
+        return false;
+    }
+
+    const std::string newVertex = (path == vertexPath) ? content : vertexSource;
+    const std::string newGeometry = (path == geometryPath) ? content : geometrySource;
+    const std::string newFragment = (path == fragmentPath) ? content : fragmentSource;
+
+    unsigned int newProgram;
+    try {
+        newProgram = Link(newVertex, newGeometry, newFragment);
+    }
+    catch (const ShaderCompileError& e) {
+        std::cout << e.what() << "\n[Shader] - Keeping previous program for " << path << "\n";
+        return false;
+    }
+
+    glDeleteProgram(shaderId);
+    shaderId = newProgram;
+    vertexSource = newVertex;
+    geometrySource = newGeometry;
+    fragmentSource = newFragment;
+    return true;
+}
+
 void Shader::SetBool(const std::string& name, const bool value) const
 {
     const int location = GetUniformLocation(name);
@@ -102,31 +151,93 @@ void Shader::SetMatrix(const std::string& name, const glm::mat4& matrix) const
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
-void Shader::Initialize(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+void Shader::Initialize(const std::string& vertexShaderPath, const std::string& geometryShaderPath, const std::string& fragmentShaderPath)
+{
+    vertexPath = vertexShaderPath;
+    geometryPath = geometryShaderPath;
+    fragmentPath = fragmentShaderPath;
+    vertexSource = GetShaderContent(vertexShaderPath);
+    geometrySource = geometryPath.empty() ? "" : GetShaderContent(geometryShaderPath);
+    fragmentSource = fragmentPath.empty() ? "" : GetShaderContent(fragmentShaderPath);
+
+    shaderId = Link(vertexSource, geometrySource, fragmentSource);
+}
+
+unsigned int Shader::Link(const std::string& vertexContent, const std::string& geometryContent, const std::string& fragmentContent)
 {
-    const std::string vertexShader = GetShaderContent(vertexShaderPath);
-    const std::string fragmentShader = GetShaderContent(fragmentShaderPath);
+    const unsigned int vertexShaderId = CompileShader(GL_VERTEX_SHADER, vertexContent);
+    unsigned int geometryShaderId = 0;
+    unsigned int fragmentShaderId = 0;
+    try {
+        if (!geometryContent.empty())
+        {
+            geometryShaderId = CompileShader(GL_GEOMETRY_SHADER, geometryContent);
+        }
+
+        if (!fragmentContent.empty())
+        {
+            fragmentShaderId = CompileShader(GL_FRAGMENT_SHADER, fragmentContent);
+        }
+    }
+    catch (const ShaderCompileError&) {
+        glDeleteShader(vertexShaderId);
+        if (geometryShaderId != 0)
+        {
+            glDeleteShader(geometryShaderId);
+        }
+        throw;
+    }
 
-    const unsigned int vertexShaderId = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    const unsigned int fragmentShaderId = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    const unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShaderId);
+    if (geometryShaderId != 0)
+    {
+        glAttachShader(program, geometryShaderId);
+    }
 
-    shaderId = glCreateProgram();
-    glAttachShader(shaderId, vertexShaderId);
-    glAttachShader(shaderId, fragmentShaderId);
-    glLinkProgram(shaderId);
+    if (fragmentShaderId != 0)
+    {
+        glAttachShader(program, fragmentShaderId);
+    }
+
+    // Varyings have to be named before linking.
+    if (!feedbackVaryings.empty())
+    {
+        std::vector<const char*> varyingNames;
+        varyingNames.reserve(feedbackVaryings.size());
+        for (const std::string& varying : feedbackVaryings)
+        {
+            varyingNames.push_back(varying.c_str());
+        }
+
+        glTransformFeedbackVaryings(program, static_cast<GLsizei>(varyingNames.size()), varyingNames.data(), GL_INTERLEAVED_ATTRIBS);
+    }
+
+    glLinkProgram(program);
+
+    glDeleteShader(vertexShaderId);
+    if (geometryShaderId != 0)
+    {
+        glDeleteShader(geometryShaderId);
+    }
+
+    if (fragmentShaderId != 0)
+    {
+        glDeleteShader(fragmentShaderId);
+    }
 
     int success;
     char infoLog[512];
-    glGetProgramiv(shaderId, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
-        glGetProgramInfoLog(shaderId, 512, NULL, infoLog);
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        glDeleteProgram(program);
         std::string error = "[Shader] - Linking failed: ";
         error += infoLog;
         throw ShaderCompileError(error);
     }
 
-    glDeleteShader(vertexShaderId);
-    glDeleteShader(fragmentShaderId);
+    return program;
 }
 
 std::string Shader::GetShaderContent(const std::string& shaderFile) const
@@ -157,6 +268,7 @@ unsigned int Shader::CompileShader(const unsigned int type, const std::string& c
     if (!success)
     {
         glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        glDeleteShader(shader);
         std::string error = "[Shader] - Compilation failed: ";
         error += infoLog;
         throw ShaderCompileError(error);
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <glm/glm.hpp>
 
@@ -19,8 +20,16 @@ namespace pk
 		unsigned int GetShaderId() const;
 
 		void Compile(const std::string& vertexShader, const std::string& fragmentShader);
+		// An empty path skips that stage, feedback only programs have no fragment stage.
+		void Compile(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader);
+		// Outputs captured by transform feedback, kept so every reload links them again.
+		void SetFeedbackVaryings(const std::vector<std::string>& varyings);
 		void Use() const;
 
+		bool UsesFile(const std::string& path) const;
+		// Rebuilds the program with new content for one of its stages, the previous program survives a failed build.
+		bool Reload(const std::string& path, const std::string& content);
+
 		void SetBool(const std::string& name, const bool value) const;
 		void SetInt(const std::string& name, const int value) const;
 		void SetFloat(const std::string& name, const float value) const;
@@ -38,7 +47,8 @@ namespace pk
 		};
 
 	private:
-		void Initialize(const std::string&, const std::string&);
+		void Initialize(const std::string&, const std::string&, const std::string&);
+		unsigned int Link(const std::string& vertexContent, const std::string& geometryContent, const std::string& fragmentContent);
 
 		std::string GetShaderContent(const std::string&) const;
 		unsigned int CompileShader(const unsigned int type, const std::string& content);
@@ -47,5 +57,13 @@ namespace pk
 
 		unsigned int shaderId;
 		bool bIsCompiled;
+
+		std::string vertexPath;
+		std::string geometryPath;
+		std::string fragmentPath;
+		std::string vertexSource;
+		std::string geometrySource;
+		std::string fragmentSource;
+		std::vector<std::string> feedbackVaryings;
 	};
 }
\ No newline at end of file
@@ -11,17 +11,12 @@ Texture::Texture(std::string InPath, int InFormat, int InWrapS, int InWrapT, int
 {
 	glGenTextures(1, &Id);
 	Bind();
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, WrapS);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, WrapT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, MinFilter);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, MaxFilter);
+	ApplyParameters();
 
 	unsigned char* Data = stbi_load(Path.c_str(), &Width, &Height, &Channels, 0);
 	if (Data)
 	{
-		glTexImage2D(GL_TEXTURE_2D, 0, Format, Width, Height, 0, Format, GL_UNSIGNED_BYTE, Data);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		Upload(Data);
 	} else
 	{
 		std::string ErrorMsg("Unable to load texture ");
@@ -32,6 +27,17 @@ Texture::Texture(std::string InPath, int InFormat, int InWrapS, int InWrapT, int
 	stbi_image_free(Data);
 }
 
+Texture::Texture(int InWidth, int InHeight, int InFormat, int InWrapS, int InWrapT, int InMinFilter, int InMaxFilter)
+	: Width(InWidth), Height(InHeight), Channels(InFormat == GL_RGBA ? 4 : 3),
+		Format(InFormat), WrapS(InWrapS), WrapT(InWrapT), MinFilter(InMinFilter), MaxFilter(InMaxFilter)
+{
+	glGenTextures(1, &Id);
+	Bind();
+	ApplyParameters();
+	glTexImage2D(GL_TEXTURE_2D, 0, Format, Width, Height, 0, Format, GL_UNSIGNED_BYTE, nullptr);
+	UnBind();
+}
+
 unsigned int Texture::GetId() const
 {
 	return Id;
@@ -61,3 +67,74 @@ void Texture::UnBind() const
 {
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
+
+void Texture::Reload(const unsigned char* Data, int InWidth, int InHeight, int InChannels)
+{
+	if (Data == nullptr)
+	{
+		return;
+	}
+
+	Width = InWidth;
+	Height = InHeight;
+	Channels = InChannels;
+	// Keeping the old format would read the wrong amount of data per pixel, Upload re-creates the storage in the new one.
+	Format = GetChannelFormat(Channels, Format);
+
+	Bind();
+	Upload(Data);
+}
+
+void Texture::UpdateRows(const unsigned char* Data, int FirstRow, int NumRows) const
+{
+	if (Data == nullptr || NumRows <= 0 || FirstRow < 0 || FirstRow + NumRows > Height)
+	{
+		return;
+	}
+
+	// Rows are tightly packed, put back whatever alignment the caller had set.
+	GLint OldAlignment;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &OldAlignment);
+
+	Bind();
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, FirstRow, Width, NumRows, Format, GL_UNSIGNED_BYTE, Data);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, OldAlignment);
+	UnBind();
+}
+
+void Texture::Resize(int InWidth, int InHeight)
+{
+	Width = InWidth;
+	Height = InHeight;
+
+	Bind();
+	glTexImage2D(GL_TEXTURE_2D, 0, Format, Width, Height, 0, Format, GL_UNSIGNED_BYTE, nullptr);
+	UnBind();
+}
+
+void Texture::Upload(const unsigned char* Data) const
+{
+	glTexImage2D(GL_TEXTURE_2D, 0, Format, Width, Height, 0, Format, GL_UNSIGNED_BYTE, Data);
+	glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+int Texture::GetChannelFormat(int InChannels, int Fallback)
+{
+	switch (InChannels)
+	{
+	case 1: return GL_RED;
+	case 2: return GL_RG;
+	case 3: return GL_RGB;
+	case 4: return GL_RGBA;
+	default: return Fallback;
+	}
+}
+
+void Texture::ApplyParameters() const
+{
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, WrapS);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, WrapT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, MinFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, MaxFilter);
+}
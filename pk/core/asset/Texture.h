@@ -12,6 +12,8 @@ namespace pk
 		typedef std::shared_ptr<Texture> SharedPtr;
 
 		Texture(std::string InPath, int InFormat, int InWrapS, int InWrapT, int InMinFilter, int InMaxFilter);
+		// Blank texture with no file behind it, the owner fills it through UpdateRows.
+		Texture(int InWidth, int InHeight, int InFormat, int InWrapS, int InWrapT, int InMinFilter, int InMaxFilter);
 
 		unsigned int GetId() const;
 		std::string GetPath() const;
@@ -21,12 +23,24 @@ namespace pk
 		void Bind() const;
 		void UnBind() const;
 
+		// Pixels are expected to be already decoded, so the caller can do the expensive part off the render thread.
+		void Reload(const unsigned char* Data, int InWidth, int InHeight, int InChannels);
+		// Data starts at FirstRow and holds NumRows full rows, the rest of the texture is left as is.
+		void UpdateRows(const unsigned char* Data, int FirstRow, int NumRows) const;
+		// Reallocates a blank texture under the same name, the content is undefined until drawn or uploaded.
+		void Resize(int InWidth, int InHeight);
+
 		class LoadError : public std::runtime_error
 		{
 			using std::runtime_error::runtime_error;
 		};
 
 	private:
+		void Upload(const unsigned char* Data) const;
+		void ApplyParameters() const;
+
+		static int GetChannelFormat(int InChannels, int Fallback);
+
 		unsigned int Id;
 		std::string Path;
 
@@ -1,11 +1,19 @@
 #pragma once
 
+#include "../utils/Common.h"
+
 namespace pk
 {
 	class IDamageable
 	{
 	public:
 		virtual bool TakeDamage(float InDamage) = 0;
+		// Compound actors read the hit part from the collision result.
+		virtual bool TakeDamage(float InDamage, const CollisionResult& /*Result*/)
+		{
+			return TakeDamage(InDamage);
+		}
+
 		virtual ~IDamageable() = default;
 	};
 }
\ No newline at end of file
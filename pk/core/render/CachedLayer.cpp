@@ -0,0 +1,86 @@
+#include "CachedLayer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Renderer.h"
+
+using namespace pk;
+
+CachedLayer::CachedLayer()
+	: bStatic(true), bDirty(true), NumRedraws(0)
+{
+}
+
+void CachedLayer::SetStatic(bool bInStatic)
+{
+	if (bStatic == bInStatic)
+	{
+		return;
+	}
+
+	bStatic = bInStatic;
+	bDirty = true;
+}
+
+bool CachedLayer::IsStatic() const
+{
+	return bStatic;
+}
+
+void CachedLayer::Invalidate()
+{
+	bDirty = true;
+}
+
+bool CachedLayer::IsDirty() const
+{
+	return bDirty;
+}
+
+void CachedLayer::Render(const ShaderPtr& CompositeShader, const DrawFunction& Draw)
+{
+	Renderer& FrameRenderer = Renderer::Get();
+	if (!bStatic)
+	{
+		Draw();
+		return;
+	}
+
+	const int PixelWidth = FrameRenderer.GetPixelWidth();
+	const int PixelHeight = FrameRenderer.GetPixelHeight();
+	if (Target == nullptr)
+	{
+		Target = std::make_unique<RenderTarget>(PixelWidth, PixelHeight);
+		bDirty = true;
+	}
+	else if (Target->GetWidth() != PixelWidth || Target->GetHeight() != PixelHeight)
+	{
+		Target->Resize(PixelWidth, PixelHeight);
+		bDirty = true;
+	}
+
+	if (bDirty)
+	{
+		FrameRenderer.BeginTarget(*Target);
+		Draw();
+		FrameRenderer.EndTarget();
+		bDirty = false;
+		NumRedraws++;
+	}
+
+	// Texture rows start at the bottom, the negative height flips them back under the y-down projection.
+	const glm::vec2 ViewSize = FrameRenderer.GetViewSize();
+	glm::mat4 Model = glm::translate(glm::mat4(1.f), glm::vec3(ViewSize.x / 2.f, ViewSize.y / 2.f, 0.f));
+	Model = glm::scale(Model, glm::vec3(ViewSize.x, -ViewSize.y, 1.f));
+
+	// The target already holds color times alpha.
+	const BlendMode OldBlend = FrameRenderer.GetBlendMode();
+	FrameRenderer.SetBlendMode(BlendMode::Premultiplied);
+	FrameRenderer.RenderSprite(CompositeShader, Target->GetTexture(), Model, glm::vec3(1.f));
+	FrameRenderer.SetBlendMode(OldBlend);
+}
+
+int CachedLayer::GetNumRedraws() const
+{
+	return NumRedraws;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "RenderTarget.h"
+
+namespace pk
+{
+	class Shader;
+
+	// Content that rarely changes, drawn once into an offscreen target and then composited as a single quad.
+	// Owners call Invalidate when what they draw changes, the next Render redraws it.
+	// The target follows the renderer's frame size, a resolution change redraws the layer on its own.
+	class CachedLayer
+	{
+	public:
+		typedef std::shared_ptr<CachedLayer> SharedPtr;
+		typedef std::shared_ptr<Shader> ShaderPtr;
+		typedef std::function<void()> DrawFunction;
+
+		CachedLayer();
+
+		// A layer that isn't static draws straight into the frame every time, nothing is cached.
+		void SetStatic(bool bInStatic);
+		bool IsStatic() const;
+
+		void Invalidate();
+		bool IsDirty() const;
+
+		// Redraws through Draw if dirty, then queues the cached texture with the composite shader.
+		void Render(const ShaderPtr& CompositeShader, const DrawFunction& Draw);
+
+		int GetNumRedraws() const;
+
+	private:
+		// Created on first render, owners may be built before the GL context.
+		std::unique_ptr<RenderTarget> Target;
+		bool bStatic;
+		bool bDirty;
+		int NumRedraws;
+	};
+}
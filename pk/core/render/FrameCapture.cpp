@@ -0,0 +1,162 @@
+#include "FrameCapture.h"
+
+#include <cstring>
+#include <glad/glad.h>
+
+using namespace pk;
+
+// Finish gives up on a read the GPU hasn't completed in that long, in nanoseconds.
+static constexpr GLuint64 FINISH_TIMEOUT = 1000000000;
+
+CapturedFrame::CapturedFrame()
+	: Index(0), Width(0), Height(0)
+{
+}
+
+FrameCapture::PendingRead::PendingRead()
+	: BufferId(0), Fence(nullptr), Capacity(0), Index(0), Width(0), Height(0)
+{
+}
+
+FrameCapture::FrameCapture()
+	: Oldest(0), NumPending(0), NumDropped(0)
+{
+}
+
+bool FrameCapture::Request(unsigned int Framebuffer, int X, int Y, int Width, int Height, int Index)
+{
+	if (NumPending == NUM_BUFFERS || Width <= 0 || Height <= 0)
+	{
+		NumDropped++;
+		return false;
+	}
+
+	PendingRead& Read = Reads[(Oldest + NumPending) % NUM_BUFFERS];
+	if (Read.BufferId == 0)
+	{
+		glGenBuffers(1, &Read.BufferId);
+	}
+
+	const int Bytes = Width * Height * 4;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, Read.BufferId);
+	if (Bytes > Read.Capacity)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, Bytes, nullptr, GL_STREAM_READ);
+		Read.Capacity = Bytes;
+	}
+
+	int Bound = 0;
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &Bound);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, Framebuffer);
+
+	// With a pack buffer bound the pointer is an offset into it, the call only queues the copy.
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(X, Y, Width, Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<unsigned int>(Bound));
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	Read.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	Read.Index = Index;
+	Read.Width = Width;
+	Read.Height = Height;
+	NumPending++;
+
+	// Without a swap nothing else may flush, the fence has to reach the GPU for a polling Collect to ever see it.
+	glFlush();
+	return true;
+}
+
+int FrameCapture::Collect(FrameList& OutFrames)
+{
+	return Drain(OutFrames, false);
+}
+
+int FrameCapture::Finish(FrameList& OutFrames)
+{
+	return Drain(OutFrames, true);
+}
+
+int FrameCapture::GetNumPending() const
+{
+	return NumPending;
+}
+
+int FrameCapture::GetNumDropped() const
+{
+	return NumDropped;
+}
+
+FrameCapture::~FrameCapture()
+{
+	for (PendingRead& Read : Reads)
+	{
+		if (Read.Fence != nullptr)
+		{
+			glDeleteSync(static_cast<GLsync>(Read.Fence));
+		}
+
+		if (Read.BufferId != 0)
+		{
+			glDeleteBuffers(1, &Read.BufferId);
+		}
+	}
+}
+
+int FrameCapture::Drain(FrameList& OutFrames, bool bWait)
+{
+	int NumCollected = 0;
+	while (NumPending > 0)
+	{
+		PendingRead& Read = Reads[Oldest];
+		const GLenum Status = glClientWaitSync(static_cast<GLsync>(Read.Fence), 0, bWait ? FINISH_TIMEOUT : 0);
+
+		// Reads complete in order, a newer one can't be ready before this one.
+		if (Status == GL_TIMEOUT_EXPIRED && !bWait)
+		{
+			break;
+		}
+
+		if (Status == GL_ALREADY_SIGNALED || Status == GL_CONDITION_SATISFIED)
+		{
+			OutFrames.emplace_back();
+			ReadBack(Read, OutFrames.back());
+			NumCollected++;
+		}
+		else
+		{
+			NumDropped++;
+		}
+
+		glDeleteSync(static_cast<GLsync>(Read.Fence));
+		Read.Fence = nullptr;
+		Oldest = (Oldest + 1) % NUM_BUFFERS;
+		NumPending--;
+	}
+
+	return NumCollected;
+}
+
+void FrameCapture::ReadBack(const PendingRead& Read, CapturedFrame& OutFrame) const
+{
+	const int RowBytes = Read.Width * 4;
+	OutFrame.Index = Read.Index;
+	OutFrame.Width = Read.Width;
+	OutFrame.Height = Read.Height;
+	OutFrame.Pixels.resize(static_cast<std::size_t>(RowBytes) * Read.Height);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, Read.BufferId);
+	const unsigned char* Source = static_cast<const unsigned char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, RowBytes * Read.Height, GL_MAP_READ_BIT));
+	if (Source != nullptr)
+	{
+		// GL rows start at the bottom.
+		for (int Row = 0; Row < Read.Height; ++Row)
+		{
+			std::memcpy(OutFrame.Pixels.data() + static_cast<std::size_t>(Row) * RowBytes, Source + static_cast<std::size_t>(Read.Height - 1 - Row) * RowBytes, RowBytes);
+		}
+
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+namespace pk
+{
+	// RGBA8 pixels of one read back frame, the first row is the top of the image.
+	struct CapturedFrame
+	{
+		int Index;
+		int Width;
+		int Height;
+		std::vector<unsigned char> Pixels;
+
+		CapturedFrame();
+	};
+
+	// Reads framebuffers back through a ring of pixel buffers, the frame asking for a copy never waits for it.
+	// A fence per read tells when the copy landed, it is collected a couple of frames later.
+	class FrameCapture
+	{
+	public:
+		typedef std::vector<CapturedFrame> FrameList;
+
+		static const int NUM_BUFFERS = 3;
+
+		// Buffers are created on the first request, a GL context must be current from then on.
+		FrameCapture();
+
+		FrameCapture(const FrameCapture& InCapture) = delete;
+		void operator=(const FrameCapture& InCapture) = delete;
+
+		// Queues a copy of a rect of the framebuffer's color buffer, dropped if every buffer is still in flight.
+		bool Request(unsigned int Framebuffer, int X, int Y, int Width, int Height, int Index);
+		// Appends the reads the GPU already finished, oldest first, never waits.
+		int Collect(FrameList& OutFrames);
+		// Waits for every read still in flight, for the end of a capture.
+		int Finish(FrameList& OutFrames);
+
+		int GetNumPending() const;
+		int GetNumDropped() const;
+
+		~FrameCapture();
+
+	private:
+		struct PendingRead
+		{
+			unsigned int BufferId;
+			// GLsync handle, stored opaque so the header stays free of GL.
+			void* Fence;
+			int Capacity;
+			int Index;
+			int Width;
+			int Height;
+
+			PendingRead();
+		};
+
+		int Drain(FrameList& OutFrames, bool bWait);
+		void ReadBack(const PendingRead& Read, CapturedFrame& OutFrame) const;
+
+		PendingRead Reads[NUM_BUFFERS];
+		int Oldest;
+		int NumPending;
+		int NumDropped;
+	};
+}
@@ -0,0 +1,172 @@
+#include "FrameWriter.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+#include "../utils/Common.h"
+
+using namespace pk;
+
+const int FrameWriter::MAX_QUEUED_FRAMES = 8;
+
+FrameWriter::FrameWriter()
+	: bStopping(false), bRunning(false), NumWritten(0), NumFailed(0), NumDropped(0)
+{
+}
+
+void FrameWriter::Start(const std::string& InDirectory, const std::string& InPrefix)
+{
+	if (IsRunning())
+	{
+		return;
+	}
+
+	Directory = InDirectory;
+	if (!Directory.empty() && Directory.back() != '/')
+	{
+		Directory += '/';
+	}
+
+	Prefix = InPrefix;
+	File::CreateFolder(Directory);
+
+	bStopping = false;
+	bRunning = true;
+	Worker = std::thread(&FrameWriter::Run, this);
+}
+
+void FrameWriter::Stop()
+{
+	{
+		std::lock_guard<std::mutex> Lock(QueueMutex);
+		bStopping = true;
+	}
+
+	QueueCondition.notify_one();
+	if (Worker.joinable())
+	{
+		Worker.join();
+	}
+
+	bRunning = false;
+}
+
+bool FrameWriter::IsRunning() const
+{
+	return bRunning;
+}
+
+bool FrameWriter::Write(CapturedFrame&& Frame)
+{
+	if (!IsRunning())
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(QueueMutex);
+		if (static_cast<int>(Queue.size()) >= MAX_QUEUED_FRAMES)
+		{
+			NumDropped++;
+			return false;
+		}
+
+		Queue.push_back(std::move(Frame));
+	}
+
+	QueueCondition.notify_one();
+	return true;
+}
+
+int FrameWriter::GetNumWritten() const
+{
+	return NumWritten;
+}
+
+int FrameWriter::GetNumFailed() const
+{
+	return NumFailed;
+}
+
+int FrameWriter::GetNumDropped() const
+{
+	return NumDropped;
+}
+
+std::string FrameWriter::GetFramePath(const std::string& Directory, const std::string& Prefix, int Index)
+{
+	std::ostringstream Path;
+	Path << Directory;
+	if (!Directory.empty() && Directory.back() != '/')
+	{
+		Path << '/';
+	}
+
+	Path << Prefix << std::setw(6) << std::setfill('0') << Index << ".png";
+	return Path.str();
+}
+
+bool FrameWriter::WritePng(const std::string& Path, const CapturedFrame& Frame)
+{
+	if (Frame.Pixels.empty())
+	{
+		return false;
+	}
+
+	return stbi_write_png(Path.c_str(), Frame.Width, Frame.Height, 4, Frame.Pixels.data(), Frame.Width * 4) != 0;
+}
+
+bool FrameWriter::ReadPng(const std::string& Path, CapturedFrame& OutFrame)
+{
+	int Width, Height, Channels;
+	unsigned char* Data = stbi_load(Path.c_str(), &Width, &Height, &Channels, 4);
+	if (Data == nullptr)
+	{
+		return false;
+	}
+
+	OutFrame.Width = Width;
+	OutFrame.Height = Height;
+	OutFrame.Pixels.assign(Data, Data + static_cast<std::size_t>(Width) * Height * 4);
+	stbi_image_free(Data);
+	return true;
+}
+
+FrameWriter::~FrameWriter()
+{
+	Stop();
+}
+
+void FrameWriter::Run()
+{
+	while (true)
+	{
+		CapturedFrame Frame;
+		{
+			std::unique_lock<std::mutex> Lock(QueueMutex);
+			QueueCondition.wait(Lock, [this]() { return bStopping || !Queue.empty(); });
+
+			// Stopping still drains the queue first.
+			if (Queue.empty())
+			{
+				return;
+			}
+
+			Frame = std::move(Queue.front());
+			Queue.pop_front();
+		}
+
+		if (WritePng(GetFramePath(Directory, Prefix, Frame.Index), Frame))
+		{
+			NumWritten++;
+		}
+		else
+		{
+			NumFailed++;
+			std::cout << "[FrameWriter] - Unable to write frame " << Frame.Index << "\n";
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "FrameCapture.h"
+
+namespace pk
+{
+	// Encodes captured frames to PNG files on a worker thread, the frame loop only hands them over.
+	class FrameWriter
+	{
+	public:
+		// Frames waiting for the encoder, a slower disk drops frames past this instead of growing without bound.
+		static const int MAX_QUEUED_FRAMES;
+
+		FrameWriter();
+		FrameWriter(const FrameWriter& InWriter) = delete;
+		void operator=(const FrameWriter& InWriter) = delete;
+
+		// Frames land in InDirectory as InPrefix followed by their zero padded index, the folder is created if missing.
+		void Start(const std::string& InDirectory, const std::string& InPrefix);
+		// Returns once everything queued is on disk.
+		void Stop();
+		bool IsRunning() const;
+
+		// Returns false when the frame was dropped because the queue is full.
+		bool Write(CapturedFrame&& Frame);
+
+		int GetNumWritten() const;
+		int GetNumFailed() const;
+		int GetNumDropped() const;
+
+		static std::string GetFramePath(const std::string& Directory, const std::string& Prefix, int Index);
+		// Synchronous versions, for the odd reference image.
+		static bool WritePng(const std::string& Path, const CapturedFrame& Frame);
+		static bool ReadPng(const std::string& Path, CapturedFrame& OutFrame);
+
+		~FrameWriter();
+
+	private:
+		void Run();
+
+		std::string Directory;
+		std::string Prefix;
+
+		std::thread Worker;
+		std::mutex QueueMutex;
+		std::condition_variable QueueCondition;
+		std::deque<CapturedFrame> Queue;
+		bool bStopping;
+
+		std::atomic<bool> bRunning;
+		std::atomic<int> NumWritten;
+		std::atomic<int> NumFailed;
+		std::atomic<int> NumDropped;
+	};
+}
@@ -0,0 +1,175 @@
+#include "GpuTimer.h"
+
+#include <algorithm>
+#include <glad/glad.h>
+
+#include "../utils/Profiler.h"
+
+using namespace pk;
+
+static const char* const PASS_NAMES[NUM_GPU_PASSES] = { "Sprites", "Particles", "Text", "Composite" };
+
+GpuTimer::FrameQueries::FrameQueries()
+	: QueryIds(), Passes(), Issued(), NumQueries(0), Frame(0), bCreated(false)
+{
+}
+
+const char* GpuTimer::GetPassName(GpuPass Pass)
+{
+	return PASS_NAMES[static_cast<int>(Pass)];
+}
+
+GpuTimer::GpuTimer()
+	: Current(-1), Oldest(0), NumPending(0), NumDropped(0), bRunning(false), RunningPass(GpuPass::Sprites)
+{
+}
+
+void GpuTimer::BeginFrame(int FrameIndex)
+{
+	End();
+
+	// A frame that issued nothing gives its set back right away.
+	if (Current >= 0 && Frames[Current].NumQueries > 0)
+	{
+		NumPending++;
+	}
+
+	Current = -1;
+	Collect();
+
+	if (!Profiler::Get().IsEnabled())
+	{
+		return;
+	}
+
+	if (NumPending == NUM_FRAMES)
+	{
+		NumDropped++;
+		return;
+	}
+
+	Current = (Oldest + NumPending) % NUM_FRAMES;
+	FrameQueries& Queries = Frames[Current];
+	if (!Queries.bCreated)
+	{
+		glGenQueries(MAX_QUERIES, Queries.QueryIds);
+		Queries.bCreated = true;
+	}
+
+	Queries.NumQueries = 0;
+	Queries.Frame = FrameIndex;
+}
+
+void GpuTimer::Begin(GpuPass Pass)
+{
+	if (Current < 0 || (bRunning && RunningPass == Pass))
+	{
+		return;
+	}
+
+	End();
+
+	FrameQueries& Queries = Frames[Current];
+	if (Queries.NumQueries == MAX_QUERIES)
+	{
+		return;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, Queries.QueryIds[Queries.NumQueries]);
+	Queries.Passes[Queries.NumQueries] = Pass;
+	Queries.Issued[Queries.NumQueries] = Profiler::Get().Now();
+	bRunning = true;
+	RunningPass = Pass;
+}
+
+void GpuTimer::End()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	glEndQuery(GL_TIME_ELAPSED);
+	Frames[Current].NumQueries++;
+	bRunning = false;
+}
+
+int GpuTimer::GetNumDropped() const
+{
+	return NumDropped;
+}
+
+GpuTimer::~GpuTimer()
+{
+	for (FrameQueries& Queries : Frames)
+	{
+		if (Queries.bCreated)
+		{
+			glDeleteQueries(MAX_QUERIES, Queries.QueryIds);
+		}
+	}
+}
+
+void GpuTimer::Collect()
+{
+	while (NumPending > 0)
+	{
+		const FrameQueries& Queries = Frames[Oldest];
+
+		// Queries finish in order, the last one being available means the whole frame is.
+		GLuint bAvailable = GL_FALSE;
+		glGetQueryObjectuiv(Queries.QueryIds[Queries.NumQueries - 1], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		if (bAvailable == GL_FALSE)
+		{
+			break;
+		}
+
+		Report(Queries);
+		Oldest = (Oldest + 1) % NUM_FRAMES;
+		NumPending--;
+	}
+}
+
+void GpuTimer::Report(const FrameQueries& Queries) const
+{
+	double Durations[NUM_GPU_PASSES] = {};
+	double FirstIssued[NUM_GPU_PASSES] = {};
+	bool bSeen[NUM_GPU_PASSES] = {};
+
+	for (int i = 0; i < Queries.NumQueries; ++i)
+	{
+		GLuint64 Elapsed = 0;
+		glGetQueryObjectui64v(Queries.QueryIds[i], GL_QUERY_RESULT, &Elapsed);
+
+		const int Pass = static_cast<int>(Queries.Passes[i]);
+		Durations[Pass] += static_cast<double>(Elapsed) / 1000000.0;
+		if (!bSeen[Pass])
+		{
+			FirstIssued[Pass] = Queries.Issued[i];
+			bSeen[Pass] = true;
+		}
+	}
+
+	int Order[NUM_GPU_PASSES];
+	for (int i = 0; i < NUM_GPU_PASSES; ++i)
+	{
+		Order[i] = i;
+	}
+
+	std::sort(Order, Order + NUM_GPU_PASSES, [&FirstIssued](int A, int B) { return FirstIssued[A] < FirstIssued[B]; });
+
+	// The queries only measure durations. Each pass is placed where the CPU issued it, after the one before it,
+	// which is close enough to line it up against the CPU scopes of its frame.
+	double Cursor = 0.0;
+	for (const int Pass : Order)
+	{
+		if (!bSeen[Pass])
+		{
+			continue;
+		}
+
+		const double Start = std::max(FirstIssued[Pass], Cursor);
+		Profiler::Get().AddEvent(PASS_NAMES[Pass], ProfileTrack::Gpu, Queries.Frame, Start, Durations[Pass]);
+		Cursor = Start + Durations[Pass];
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pk
+{
+	enum class GpuPass : std::uint8_t
+	{
+		Sprites,
+		Particles,
+		Text,
+		Composite
+	};
+
+	constexpr int NUM_GPU_PASSES = static_cast<int>(GpuPass::Composite) + 1;
+
+	// Times render passes with GL_TIME_ELAPSED queries and hands the results to the profiler.
+	// Each frame records into its own set of queries, read NUM_FRAMES frames later so the CPU never waits on them.
+	class GpuTimer
+	{
+	public:
+		static const int NUM_FRAMES = 4;
+		// Pass changes timed per frame, later ones in the same frame go untimed.
+		static const int MAX_QUERIES = 64;
+
+		static const char* GetPassName(GpuPass Pass);
+
+		// Queries are created on first use, a GL context must be current from then on.
+		GpuTimer();
+
+		GpuTimer(const GpuTimer& InTimer) = delete;
+		void operator=(const GpuTimer& InTimer) = delete;
+
+		// Closes the previous frame, reports the finished ones and starts recording if the profiler is on.
+		// A frame finding every set still in flight is not timed.
+		void BeginFrame(int FrameIndex);
+		// Consecutive work of the same pass shares the running query.
+		void Begin(GpuPass Pass);
+		void End();
+
+		int GetNumDropped() const;
+
+		~GpuTimer();
+
+	private:
+		struct FrameQueries
+		{
+			unsigned int QueryIds[MAX_QUERIES];
+			GpuPass Passes[MAX_QUERIES];
+			// CPU time each query was issued at, in profiler milliseconds.
+			double Issued[MAX_QUERIES];
+			int NumQueries;
+			int Frame;
+			bool bCreated;
+
+			FrameQueries();
+		};
+
+		void Collect();
+		void Report(const FrameQueries& Queries) const;
+
+		FrameQueries Frames[NUM_FRAMES];
+		// Set being recorded, -1 while the frame is untimed.
+		int Current;
+		int Oldest;
+		int NumPending;
+		int NumDropped;
+
+		bool bRunning;
+		GpuPass RunningPass;
+	};
+}
@@ -0,0 +1,52 @@
+#include "InstanceBuffer.h"
+
+#include <glad/glad.h>
+
+using namespace pk;
+
+InstanceBuffer::InstanceBuffer()
+	: BufferId(0), Count(0), Capacity(0)
+{
+}
+
+void InstanceBuffer::Upload(const std::vector<glm::vec2>& Offsets)
+{
+	// Created on first upload, owners may be built before the GL context.
+	if (BufferId == 0)
+	{
+		glGenBuffers(1, &BufferId);
+	}
+
+	Count = static_cast<int>(Offsets.size());
+
+	glBindBuffer(GL_ARRAY_BUFFER, BufferId);
+	if (Count > Capacity)
+	{
+		glBufferData(GL_ARRAY_BUFFER, Count * sizeof(glm::vec2), Offsets.data(), GL_DYNAMIC_DRAW);
+		Capacity = Count;
+	}
+	else if (Count > 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0, Count * sizeof(glm::vec2), Offsets.data());
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+unsigned int InstanceBuffer::GetBufferId() const
+{
+	return BufferId;
+}
+
+int InstanceBuffer::GetCount() const
+{
+	return Count;
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+	if (BufferId != 0)
+	{
+		glDeleteBuffers(1, &BufferId);
+	}
+}
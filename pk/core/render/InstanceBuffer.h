@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace pk
+{
+	// Per-instance sprite offsets, uploaded only when the owner changes them.
+	class InstanceBuffer
+	{
+	public:
+		InstanceBuffer();
+
+		InstanceBuffer(const InstanceBuffer& InBuffer) = delete;
+		void operator=(const InstanceBuffer& InBuffer) = delete;
+
+		void Upload(const std::vector<glm::vec2>& Offsets);
+
+		unsigned int GetBufferId() const;
+		int GetCount() const;
+
+		~InstanceBuffer();
+
+	private:
+		unsigned int BufferId;
+		int Count;
+		int Capacity;
+	};
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "RenderLayer.h"
+#include "RenderState.h"
+
+namespace pk
+{
+	class Shader;
+	struct Particle;
+	struct Character;
+
+	enum class RenderCommandType : std::uint8_t
+	{
+		Sprite,
+		SpriteInstanced,
+		Particles,
+		ParticleFeedback,
+		Text,
+		// Vertices built ahead of time by the caller, copied to the stream as they are.
+		Prebuilt
+	};
+
+	// Layout of everything written to the stream buffer: position and uv, then color.
+	struct StreamVertex
+	{
+		glm::vec4 Vertex;
+		glm::vec4 Color;
+	};
+
+	// One deferred draw, only the fields its type reads are filled.
+	// Pointers must stay valid until the queue is flushed at the end of the frame.
+	struct RenderCommand
+	{
+		RenderCommandType Type;
+		BlendMode Blend;
+		const Shader* CommandShader;
+		unsigned int TextureId;
+		// Instance buffer for instanced sprites.
+		unsigned int Buffer;
+		unsigned int VertexArray;
+		// Instance range, offset and length in the renderer's text arena, or the number of GPU particles.
+		int First;
+		int Count;
+		float Scale;
+		glm::vec2 Position;
+		glm::vec4 Color;
+		glm::mat4 Model;
+		const std::vector<Particle>* Particles;
+		const std::map<char, Character>* Characters;
+		const std::vector<StreamVertex>* Vertices;
+	};
+
+	struct RenderStats
+	{
+		int Commands;
+		int StateChanges;
+		int SkippedChanges;
+		int DrawCalls;
+		int StreamBytes;
+		int SyncWaits;
+		// Times something was drawn into an offscreen target instead of the frame.
+		int TargetPasses;
+		// Layers whose commands didn't arrive in key order and had to be sorted.
+		int SortedLayers;
+
+		RenderStats()
+			: Commands(0), StateChanges(0), SkippedChanges(0), DrawCalls(0), StreamBytes(0), SyncWaits(0), TargetPasses(0), SortedLayers(0)
+		{
+		}
+	};
+}
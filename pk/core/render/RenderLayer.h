@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pk
+{
+	// Coarse draw order, a layer is drawn entirely before the next one.
+	enum class RenderLayer : std::uint8_t
+	{
+		Background,
+		Bunkers,
+		Actors,
+		Projectiles,
+		Effects,
+		Ui
+	};
+
+	constexpr int NUM_RENDER_LAYERS = static_cast<int>(RenderLayer::Ui) + 1;
+}
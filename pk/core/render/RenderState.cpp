@@ -0,0 +1,105 @@
+#include "RenderState.h"
+
+#include <glad/glad.h>
+
+using namespace pk;
+
+// No GL name can take this value, so the first bind after Invalidate always goes through.
+static constexpr unsigned int UNKNOWN_BINDING = ~0u;
+
+RenderState::RenderState()
+	: Program(UNKNOWN_BINDING), VertexArray(UNKNOWN_BINDING), Texture(UNKNOWN_BINDING), Blend(UNKNOWN_BINDING),
+		NumChanges(0), NumSkipped(0)
+{
+}
+
+void RenderState::UseProgram(unsigned int InProgram)
+{
+	if (Track(Program, InProgram))
+	{
+		glUseProgram(InProgram);
+	}
+}
+
+void RenderState::BindVertexArray(unsigned int InVertexArray)
+{
+	if (Track(VertexArray, InVertexArray))
+	{
+		glBindVertexArray(InVertexArray);
+	}
+}
+
+void RenderState::BindTexture(unsigned int InTexture)
+{
+	if (Track(Texture, InTexture))
+	{
+		glBindTexture(GL_TEXTURE_2D, InTexture);
+	}
+}
+
+void RenderState::SetBlendMode(BlendMode Mode)
+{
+	if (!Track(Blend, static_cast<unsigned int>(Mode)))
+	{
+		return;
+	}
+
+	if (Mode == BlendMode::Opaque)
+	{
+		glDisable(GL_BLEND);
+		return;
+	}
+
+	// Alpha is blended apart from color so offscreen targets end up premultiplied with the right coverage.
+	glEnable(GL_BLEND);
+	switch (Mode)
+	{
+	case BlendMode::Additive:
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
+		break;
+	case BlendMode::Premultiplied:
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+	case BlendMode::Alpha:
+	default:
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+	}
+}
+
+void RenderState::Invalidate()
+{
+	Program = UNKNOWN_BINDING;
+	VertexArray = UNKNOWN_BINDING;
+	Texture = UNKNOWN_BINDING;
+	Blend = UNKNOWN_BINDING;
+}
+
+int RenderState::GetNumChanges() const
+{
+	return NumChanges;
+}
+
+int RenderState::GetNumSkipped() const
+{
+	return NumSkipped;
+}
+
+void RenderState::ResetCounters()
+{
+	NumChanges = 0;
+	NumSkipped = 0;
+}
+
+bool RenderState::Track(unsigned int& Cached, unsigned int Value)
+{
+	if (Cached == Value)
+	{
+		NumSkipped++;
+		return false;
+	}
+
+	Cached = Value;
+	NumChanges++;
+	return true;
+}
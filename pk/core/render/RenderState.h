@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pk
+{
+	enum class BlendMode : std::uint8_t
+	{
+		Opaque,
+		Alpha,
+		Additive,
+		// Source color already multiplied by its alpha, what cached layers are composited with.
+		Premultiplied
+	};
+
+	// Mirror of the GL bindings the renderer touches, a bind is only issued when the value changes.
+	class RenderState
+	{
+	public:
+		RenderState();
+
+		void UseProgram(unsigned int Program);
+		void BindVertexArray(unsigned int VertexArray);
+		// Texture unit 0, the only one sprites, particles and text sample from.
+		void BindTexture(unsigned int Texture);
+		void SetBlendMode(BlendMode Mode);
+
+		// Forgets every cached binding, for when GL may have been touched outside the tracker.
+		void Invalidate();
+
+		int GetNumChanges() const;
+		int GetNumSkipped() const;
+		void ResetCounters();
+
+	private:
+		bool Track(unsigned int& Cached, unsigned int Value);
+
+		unsigned int Program;
+		unsigned int VertexArray;
+		unsigned int Texture;
+		unsigned int Blend;
+
+		int NumChanges;
+		int NumSkipped;
+	};
+}
@@ -0,0 +1,70 @@
+#include "RenderTarget.h"
+
+#include <algorithm>
+#include <iostream>
+#include <glad/glad.h>
+
+#include "../asset/Texture.h"
+
+using namespace pk;
+
+RenderTarget::RenderTarget(int InWidth, int InHeight)
+	: FramebufferId(0)
+{
+	// Sampled one texel per pixel, nearest keeps the composited copy exact.
+	ColorTexture = std::make_shared<Texture>(std::max(1, InWidth), std::max(1, InHeight), GL_RGBA, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, GL_NEAREST, GL_NEAREST);
+
+	int Bound = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &Bound);
+
+	glGenFramebuffers(1, &FramebufferId);
+	glBindFramebuffer(GL_FRAMEBUFFER, FramebufferId);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ColorTexture->GetId(), 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "[RenderTarget] - Framebuffer is incomplete.\n";
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned int>(Bound));
+}
+
+void RenderTarget::Resize(int InWidth, int InHeight)
+{
+	InWidth = std::max(1, InWidth);
+	InHeight = std::max(1, InHeight);
+	if (InWidth == GetWidth() && InHeight == GetHeight())
+	{
+		return;
+	}
+
+	// The attachment follows the texture name, nothing to re-attach.
+	ColorTexture->Resize(InWidth, InHeight);
+}
+
+unsigned int RenderTarget::GetFramebufferId() const
+{
+	return FramebufferId;
+}
+
+RenderTarget::TexturePtr RenderTarget::GetTexture() const
+{
+	return ColorTexture;
+}
+
+int RenderTarget::GetWidth() const
+{
+	return ColorTexture->GetWidth();
+}
+
+int RenderTarget::GetHeight() const
+{
+	return ColorTexture->GetHeight();
+}
+
+RenderTarget::~RenderTarget()
+{
+	if (FramebufferId != 0)
+	{
+		glDeleteFramebuffers(1, &FramebufferId);
+	}
+}
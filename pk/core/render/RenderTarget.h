@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+namespace pk
+{
+	class Texture;
+
+	// Framebuffer with a single RGBA color texture, what is drawn into it can be sampled like any sprite.
+	class RenderTarget
+	{
+	public:
+		typedef std::shared_ptr<Texture> TexturePtr;
+
+		// Needs a current GL context.
+		RenderTarget(int InWidth, int InHeight);
+
+		RenderTarget(const RenderTarget& InTarget) = delete;
+		void operator=(const RenderTarget& InTarget) = delete;
+
+		// Keeps the framebuffer and texture names, the content is lost.
+		void Resize(int InWidth, int InHeight);
+
+		unsigned int GetFramebufferId() const;
+		TexturePtr GetTexture() const;
+		int GetWidth() const;
+		int GetHeight() const;
+
+		~RenderTarget();
+
+	private:
+		unsigned int FramebufferId;
+		TexturePtr ColorTexture;
+	};
+}
@@ -1,19 +1,34 @@
 #include "Renderer.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
 #include <glad/glad.h>
 
 #include "../vfx/Emitter.h"
 #include "../asset/Font.h"
 #include "../asset/Shader.h"
 #include "../asset/Texture.h"
+#include "InstanceBuffer.h"
+#include "RenderTarget.h"
 
 using namespace pk;
 
+// Key layout from the top: shader 12 bits, texture 12, depth 12, command index 20. The layer is the bucket.
+static constexpr int SHADER_SHIFT = 44;
+static constexpr int TEXTURE_SHIFT = 32;
+static constexpr int DEPTH_SHIFT = 20;
+static constexpr std::uint64_t FIELD_MASK = 0xFFF;
+static constexpr std::uint64_t INDEX_MASK = 0xFFFFF;
+
+const int Renderer::MAX_COMMANDS = static_cast<int>(INDEX_MASK) + 1;
+
 Renderer::Renderer()
-	: SpriteQuadId(-1), TextQuadId(-1), TextBufferId(-1), LastShaderId(-1)
+	: InstancedQuadId(-1), StreamVertexArray(-1), Stream(StreamBuffer::DEFAULT_SEGMENT_SIZE),
+		Layer(RenderLayer::Actors), Blend(BlendMode::Alpha), ViewSize(1.f), PixelWidth(1), PixelHeight(1), Target(nullptr), bTargetCleared(false), FrameFramebuffer(0), FrameViewport{ 0, 0, 0, 0 }
 {
 	InitializeSpriteQuad();
-	InitializeTextQuad();
+	InitializeStream();
 }
 
 void Renderer::InitializeSpriteQuad()
@@ -30,6 +45,7 @@ void Renderer::InitializeSpriteQuad()
 		1, 2, 3 
 	};
 
+	// Only instanced draws still use the static quad, the per-instance offset buffer is attached at draw time.
 	unsigned int VAO = 0;
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
@@ -46,27 +62,28 @@ void Renderer::InitializeSpriteQuad()
 
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
 	glEnableVertexAttribArray(0);
-
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
 	glBindVertexArray(0);
 
-	SpriteQuadId = VAO;
+	InstancedQuadId = VAO;
 }
 
-void Renderer::InitializeTextQuad()
+void Renderer::InitializeStream()
 {
-	unsigned int VAO, VBO;
+	unsigned int VAO;
 	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
 	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+	// Orphaning keeps the buffer name, so the attributes set here stay valid.
+	glBindBuffer(GL_ARRAY_BUFFER, Stream.GetBufferId());
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(StreamVertex), (void*)offsetof(StreamVertex, Vertex));
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(StreamVertex), (void*)offsetof(StreamVertex, Color));
+	glEnableVertexAttribArray(1);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 
-	TextQuadId = VAO;
-	TextBufferId = VBO;
+	StreamVertexArray = VAO;
 }
 
 void Renderer::RenderSprite(const ShaderPtr& Shader, const TexturePtr& Texture, const glm::mat4& Model, const glm::vec3& Color)
@@ -76,139 +93,519 @@ void Renderer::RenderSprite(const ShaderPtr& Shader, const TexturePtr& Texture,
 		return;
 	}
 
-	glBindVertexArray(SpriteQuadId);
+	RenderCommand& Command = Submit(RenderCommandType::Sprite, Shader, Texture, Model[3].z);
+	Command.Model = Model;
+	Command.Color = glm::vec4(Color, 1.f);
+}
 
-	if (LastShaderId != Shader->GetShaderId())
+void Renderer::RenderSpriteInstanced(const ShaderPtr& Shader, const TexturePtr& Texture, const glm::mat4& Model, const InstanceBuffer& Instances, int First, int Count)
+{
+	if (Shader == nullptr || Instances.GetBufferId() == 0 || Count <= 0)
 	{
-		LastShaderId = Shader->GetShaderId();
-		Shader->Use();
+		return;
 	}
 
-	Shader->SetFloat("spriteColor", Color);
-	Shader->SetMatrix("model", Model);
+	RenderCommand& Command = Submit(RenderCommandType::SpriteInstanced, Shader, Texture, Model[3].z);
+	Command.Model = Model;
+	Command.Buffer = Instances.GetBufferId();
+	Command.First = First;
+	Command.Count = Count;
+}
 
-	if (Texture != nullptr)
+void Renderer::RenderParticleVfx(const ParticleList& Particles, const ShaderPtr& Shader, const TexturePtr& Texture, float Scale)
+{
+	if (Shader == nullptr || Particles.empty())
 	{
-		glActiveTexture(GL_TEXTURE0);
-		Texture->Bind();
+		return;
 	}
 
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+	RenderCommand& Command = Submit(RenderCommandType::Particles, Shader, Texture, 0.f);
+	Command.Particles = &Particles;
+	Command.Scale = Scale;
+}
 
-	if (Texture != nullptr)
+void Renderer::RenderParticleFeedback(const ShaderPtr& Shader, const TexturePtr& Texture, unsigned int VertexArray, int Count, float Scale)
+{
+	if (Shader == nullptr || Count <= 0)
 	{
-		Texture->UnBind();
+		return;
 	}
+
+	RenderCommand& Command = Submit(RenderCommandType::ParticleFeedback, Shader, Texture, 0.f);
+	Command.VertexArray = VertexArray;
+	Command.Count = Count;
+	Command.Scale = Scale;
 }
 
-void Renderer::RenderParticleVfx(const ParticleList& Particles, 
-                                 const ShaderPtr& Shader, const TexturePtr& Texture, float Scale)
+void Renderer::RenderText(const std::string& Text, const ShaderPtr& Shader, const CharacterMap& Characters,
+	const glm::vec2& Position, float Scale, const glm::vec4& Color)
 {
-	if (Shader == nullptr)
+	if (Shader == nullptr || Text.empty())
+	{
+		return;
+	}
+
+	// Every glyph of a font shares its atlas, keying on it lets strings of one font draw together.
+	const unsigned int AtlasId = Characters.empty() ? 0 : Characters.begin()->second.TextureID;
+	RenderCommand& Command = Submit(RenderCommandType::Text, Shader, nullptr, 0.f);
+	Command.TextureId = AtlasId;
+	Keys[static_cast<int>(Layer)].back() |= (AtlasId & FIELD_MASK) << TEXTURE_SHIFT;
+	Command.Characters = &Characters;
+	Command.Position = Position;
+	Command.Scale = Scale;
+	Command.Color = Color;
+	Command.First = static_cast<int>(TextArena.size());
+	Command.Count = static_cast<int>(Text.size());
+	TextArena += Text;
+}
+
+void Renderer::RenderVertices(const ShaderPtr& Shader, unsigned int TextureId, const VertexList& Vertices)
+{
+	if (Shader == nullptr || Vertices.empty())
+	{
+		return;
+	}
+
+	RenderCommand& Command = Submit(RenderCommandType::Prebuilt, Shader, nullptr, 0.f);
+	Command.TextureId = TextureId;
+	Keys[static_cast<int>(Layer)].back() |= (TextureId & FIELD_MASK) << TEXTURE_SHIFT;
+	Command.Vertices = &Vertices;
+}
+
+void Renderer::SetLayer(RenderLayer InLayer)
+{
+	Layer = InLayer;
+}
+
+void Renderer::SetBlendMode(BlendMode InBlend)
+{
+	Blend = InBlend;
+}
+
+RenderLayer Renderer::GetLayer() const
+{
+	return Layer;
+}
+
+BlendMode Renderer::GetBlendMode() const
+{
+	return Blend;
+}
+
+void Renderer::SetFrameSize(const glm::vec2& InViewSize, int InPixelWidth, int InPixelHeight)
+{
+	ViewSize = InViewSize;
+	PixelWidth = std::max(1, InPixelWidth);
+	PixelHeight = std::max(1, InPixelHeight);
+}
+
+glm::vec2 Renderer::GetViewSize() const
+{
+	return ViewSize;
+}
+
+int Renderer::GetPixelWidth() const
+{
+	return PixelWidth;
+}
+
+int Renderer::GetPixelHeight() const
+{
+	return PixelHeight;
+}
+
+void Renderer::BeginTarget(RenderTarget& InTarget)
+{
+	if (Target != nullptr)
 	{
+		std::cout << "[Renderer] - Targets can't be nested, EndTarget was not called.\n";
 		return;
 	}
 
-	if (LastShaderId != Shader->GetShaderId())
+	Target = &InTarget;
+	bTargetCleared = false;
+	// The frame itself may be going to an offscreen target, that is where drawing resumes.
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &FrameFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, FrameViewport);
+
+	Commands.swap(FrameCommands);
+	Keys.swap(FrameKeys);
+	TextArena.swap(FrameTextArena);
+}
+
+void Renderer::EndTarget()
+{
+	if (Target == nullptr)
 	{
-		LastShaderId = Shader->GetShaderId();
-		Shader->Use();
+		return;
 	}
 
-	glBindVertexArray(SpriteQuadId);
+	DrawTargetQueue();
+	Target = nullptr;
 
-	if (Texture != nullptr)
+	Commands.swap(FrameCommands);
+	Keys.swap(FrameKeys);
+	TextArena.swap(FrameTextArena);
+}
+
+void Renderer::Flush()
+{
+	DrawQueue();
+
+	const StreamStats Streamed = Stream.GetStats();
+	FrameStats.StateChanges = State.GetNumChanges();
+	FrameStats.SkippedChanges = State.GetNumSkipped();
+	FrameStats.StreamBytes = Streamed.BytesUploaded;
+	FrameStats.SyncWaits = Streamed.SyncWaits;
+	LastStats = FrameStats;
+
+	FrameStats = RenderStats();
+	State.ResetCounters();
+	Stream.ResetStats();
+}
+
+void Renderer::BeginFrame(int FrameIndex)
+{
+	Timer.BeginFrame(FrameIndex);
+}
+
+void Renderer::BeginGpuPass(GpuPass Pass)
+{
+	Timer.Begin(Pass);
+}
+
+void Renderer::EndGpuPass()
+{
+	Timer.End();
+}
+
+void Renderer::UseShader(const ShaderPtr& Shader)
+{
+	if (Shader == nullptr)
 	{
-		glActiveTexture(GL_TEXTURE0);
-		Texture->Bind();
+		return;
 	}
 
-	for (const Particle::SharedPtr& CurrentParticle : Particles)
+	State.UseProgram(Shader->GetShaderId());
+}
+
+RenderStats Renderer::GetStats() const
+{
+	return LastStats;
+}
+
+RenderCommand& Renderer::Submit(RenderCommandType Type, const ShaderPtr& Shader, const TexturePtr& Texture, float Depth)
+{
+	// A full queue is drawn early, only the ordering across the two halves is lost.
+	if (static_cast<int>(Commands.size()) >= MAX_COMMANDS)
 	{
-		if (CurrentParticle->Life <= 0.f)
+		if (Target != nullptr)
+		{
+			DrawTargetQueue();
+		}
+		else
 		{
-			continue;
+			DrawQueue();
 		}
+	}
 
-		float CurrentScale = Scale;
-		if (CurrentParticle->OverrideScale >= 0.f)
+	const unsigned int TextureId = Texture != nullptr ? Texture->GetId() : 0;
+	const float NormalizedDepth = std::clamp((Depth + 1.f) * .5f, 0.f, 1.f);
+	const std::uint64_t DepthBits = static_cast<std::uint64_t>(NormalizedDepth * static_cast<float>(FIELD_MASK));
+
+	Keys[static_cast<int>(Layer)].push_back(
+		((Shader->GetShaderId() & FIELD_MASK) << SHADER_SHIFT) |
+		((TextureId & FIELD_MASK) << TEXTURE_SHIFT) |
+		(DepthBits << DEPTH_SHIFT) |
+		static_cast<std::uint64_t>(Commands.size())
+	);
+
+	Commands.emplace_back();
+	RenderCommand& Command = Commands.back();
+	Command.Type = Type;
+	Command.Blend = Blend;
+	Command.CommandShader = Shader.get();
+	Command.TextureId = TextureId;
+	FrameStats.Commands++;
+	return Command;
+}
+
+void Renderer::DrawQueue()
+{
+	if (Commands.empty())
+	{
+		return;
+	}
+
+	// Uploads, hot reloads and feedback passes bind behind the tracker's back, so each frame starts clean.
+	State.Invalidate();
+	glActiveTexture(GL_TEXTURE0);
+
+	// Buckets come from scene layers that rarely mix textures, most of them are already in order.
+	for (std::vector<std::uint64_t>& LayerKeys : Keys)
+	{
+		if (!std::is_sorted(LayerKeys.begin(), LayerKeys.end()))
 		{
-			CurrentScale = CurrentParticle->OverrideScale;
+			std::sort(LayerKeys.begin(), LayerKeys.end());
+			FrameStats.SortedLayers++;
 		}
+	}
 
-		Shader->SetFloat("position", CurrentParticle->Position);
-		Shader->SetFloat("color", CurrentParticle->Color);
-		Shader->SetFloat("scale", CurrentScale);
+	BuildDrawItems();
 
-		glDrawArrays(GL_TRIANGLES, 0, 6);
+	const int BaseVertex = Stream.GetBaseOffset() / static_cast<int>(sizeof(StreamVertex));
+	for (const DrawItem& Item : Items)
+	{
+		Timer.Begin(GetGpuPass(Item.Command->Type));
+		Execute(Item, BaseVertex);
 	}
 
-	if (Texture != nullptr)
+	Timer.End();
+
+	// A bound VAO would capture element buffer binds made before the next flush.
+	State.BindVertexArray(0);
+	Stream.End();
+
+	Commands.clear();
+	for (std::vector<std::uint64_t>& LayerKeys : Keys)
 	{
-		Texture->UnBind();
+		LayerKeys.clear();
 	}
 
-	glBindVertexArray(0);
+	Items.clear();
+	TextArena.clear();
 }
 
-void Renderer::RenderText(const std::string& Text, const ShaderPtr& Shader, const CharacterMap& Characters, 
-	const glm::vec2& Position, float Scale, const glm::vec4& Color)
+void Renderer::DrawTargetQueue()
 {
-	if (Shader == nullptr)
+	glBindFramebuffer(GL_FRAMEBUFFER, Target->GetFramebufferId());
+	glViewport(0, 0, Target->GetWidth(), Target->GetHeight());
+
+	// A queue drawn early inside a target must not wipe what the first half left.
+	if (!bTargetCleared)
 	{
-		return;
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		bTargetCleared = true;
+	}
+
+	DrawQueue();
+	FrameStats.TargetPasses++;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned int>(FrameFramebuffer));
+	glViewport(FrameViewport[0], FrameViewport[1], FrameViewport[2], FrameViewport[3]);
+}
+
+void Renderer::BuildDrawItems()
+{
+	Stream.Begin();
+
+	// Layers follow each other in the stream too, the last batch of a layer may merge with the first of the next.
+	for (const std::vector<std::uint64_t>& LayerKeys : Keys)
+	{
+		for (const std::uint64_t Key : LayerKeys)
+		{
+			const RenderCommand& Command = Commands[Key & INDEX_MASK];
+			const int NumVertices = CountVertices(Command);
+			if (NumVertices == 0)
+			{
+				Items.push_back({ &Command, 0, 0 });
+				continue;
+			}
+
+			int Offset;
+			StreamVertex* Vertices = static_cast<StreamVertex*>(Stream.Allocate(NumVertices * sizeof(StreamVertex), Offset));
+			switch (Command.Type)
+			{
+			case RenderCommandType::Sprite:
+				WriteSprite(Command, Vertices);
+				break;
+			case RenderCommandType::Particles:
+				WriteParticles(Command, Vertices);
+				break;
+			case RenderCommandType::Text:
+				WriteText(Command, Vertices);
+				break;
+			case RenderCommandType::Prebuilt:
+				std::copy(Command.Vertices->begin(), Command.Vertices->end(), Vertices);
+				break;
+			default:
+				break;
+			}
+
+			// Vertices are allocated in key order, so a mergeable neighbour is always right before this one.
+			DrawItem* Last = Items.empty() ? nullptr : &Items.back();
+			if (Last != nullptr && Last->NumVertices > 0 && Last->Command->CommandShader == Command.CommandShader &&
+				Last->Command->TextureId == Command.TextureId && Last->Command->Blend == Command.Blend)
+			{
+				Last->NumVertices += NumVertices;
+				continue;
+			}
+
+			Items.push_back({ &Command, Offset / static_cast<int>(sizeof(StreamVertex)), NumVertices });
+		}
 	}
 
-	if (LastShaderId != Shader->GetShaderId())
+	Stream.Upload();
+}
+
+int Renderer::CountVertices(const RenderCommand& Command) const
+{
+	switch (Command.Type)
 	{
-		LastShaderId = Shader->GetShaderId();
-		Shader->Use();
+	case RenderCommandType::Sprite:
+		return 6;
+	case RenderCommandType::Particles:
+		return static_cast<int>(Command.Particles->size()) * 6;
+	case RenderCommandType::Text:
+		return Command.Count * 6;
+	case RenderCommandType::Prebuilt:
+		return static_cast<int>(Command.Vertices->size());
+	default:
+		return 0;
 	}
+}
 
-	Shader->SetColor("textColor", Color);
+// Two triangles over the unit quad centered on the origin, uv is the corner shifted by half.
+static const glm::vec2 QUAD_CORNERS[6] = {
+	glm::vec2(-.5f, -.5f), glm::vec2(.5f, -.5f), glm::vec2(.5f, .5f),
+	glm::vec2(-.5f, -.5f), glm::vec2(.5f, .5f), glm::vec2(-.5f, .5f)
+};
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindVertexArray(TextQuadId);
+void Renderer::WriteSprite(const RenderCommand& Command, StreamVertex* OutVertices) const
+{
+	const glm::mat4& Model = Command.Model;
+	for (int i = 0; i < 6; ++i)
+	{
+		const glm::vec2& Corner = QUAD_CORNERS[i];
+		const glm::vec4 Position = Model[0] * Corner.x + Model[1] * Corner.y + Model[3];
+		OutVertices[i].Vertex = glm::vec4(Position.x, Position.y, Corner.x + .5f, Corner.y + .5f);
+		OutVertices[i].Color = Command.Color;
+	}
+}
 
-	// iterate through all characters
+void Renderer::WriteParticles(const RenderCommand& Command, StreamVertex* OutVertices) const
+{
+	// Emitters only hand over live particles.
+	for (const Particle& CurrentParticle : *Command.Particles)
+	{
+		const float Scale = CurrentParticle.OverrideScale >= 0.f ? CurrentParticle.OverrideScale : Command.Scale;
+		for (int i = 0; i < 6; ++i)
+		{
+			const glm::vec2& Corner = QUAD_CORNERS[i];
+			const glm::vec2 Position = Corner * Scale + glm::vec2(CurrentParticle.Position.x, CurrentParticle.Position.y);
+			OutVertices->Vertex = glm::vec4(Position.x, Position.y, Corner.x + .5f, Corner.y + .5f);
+			OutVertices->Color = CurrentParticle.Color;
+			++OutVertices;
+		}
+	}
+}
+
+void Renderer::WriteText(const RenderCommand& Command, StreamVertex* OutVertices) const
+{
+	WriteGlyphs(TextArena.data() + Command.First, Command.Count, *Command.Characters, Command.Position, Command.Scale, Command.Color, OutVertices);
+}
+
+void Renderer::WriteGlyphs(const char* Text, int Count, const CharacterMap& Characters, const glm::vec2& Position, float Scale, const glm::vec4& Color, StreamVertex* OutVertices)
+{
 	float x = Position.x;
 	float y = Position.y;
 
-	Character MaxChar = Characters.at('H');
+	const Character& MaxChar = Characters.at('H');
 
-	for (const char c : Text)
+	for (int i = 0; i < Count; ++i)
 	{
-		Character Glyph = Characters.at(c);
+		const Character& Glyph = Characters.at(Text[i]);
 
 		float xpos = x + Glyph.Bearing.x * Scale;
 		float ypos = y + (MaxChar.Bearing.y - Glyph.Bearing.y) * Scale;
 
 		float w = Glyph.Size.x * Scale;
 		float h = Glyph.Size.y * Scale;
-		// update VBO for each character
-		float vertices[6][4] = {
-			{ xpos,     ypos + h,   0.0f, 1.0f },
-			{ xpos + w, ypos,       1.0f, 0.0f },
-			{ xpos,     ypos,       0.0f, 0.0f },
-
-			{ xpos,     ypos + h,   0.0f, 1.0f },
-			{ xpos + w, ypos + h,   1.0f, 1.0f },
-			{ xpos + w, ypos,       1.0f, 0.0f }
+
+		const glm::vec2& Min = Glyph.UvMin;
+		const glm::vec2& Max = Glyph.UvMax;
+		const StreamVertex GlyphVertices[6] = {
+			{ glm::vec4(xpos,     ypos + h, Min.x, Max.y), Color },
+			{ glm::vec4(xpos + w, ypos,     Max.x, Min.y), Color },
+			{ glm::vec4(xpos,     ypos,     Min.x, Min.y), Color },
+
+			{ glm::vec4(xpos,     ypos + h, Min.x, Max.y), Color },
+			{ glm::vec4(xpos + w, ypos + h, Max.x, Max.y), Color },
+			{ glm::vec4(xpos + w, ypos,     Max.x, Min.y), Color }
 		};
-		// render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, Glyph.TextureID);
-		// update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, TextBufferId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		// render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
+		std::copy(GlyphVertices, GlyphVertices + 6, OutVertices);
+		OutVertices += 6;
 
 		x += (Glyph.Advance >> 6) * Scale;
 	}
+}
 
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+void Renderer::Execute(const DrawItem& Item, int BaseVertex)
+{
+	const RenderCommand& Command = *Item.Command;
+	State.UseProgram(Command.CommandShader->GetShaderId());
+	State.BindTexture(Command.TextureId);
+	State.SetBlendMode(Command.Blend);
+
+	if (Item.NumVertices > 0)
+	{
+		State.BindVertexArray(StreamVertexArray);
+		glDrawArrays(GL_TRIANGLES, BaseVertex + Item.FirstVertex, Item.NumVertices);
+		FrameStats.DrawCalls++;
+		return;
+	}
+
+	switch (Command.Type)
+	{
+	case RenderCommandType::SpriteInstanced:
+		ExecuteSpriteInstanced(Command);
+		break;
+	case RenderCommandType::ParticleFeedback:
+		ExecuteParticleFeedback(Command);
+		break;
+	default:
+		break;
+	}
+}
+
+void Renderer::ExecuteSpriteInstanced(const RenderCommand& Command)
+{
+	State.BindVertexArray(InstancedQuadId);
+
+	Command.CommandShader->SetMatrix("model", Command.Model);
+
+	glBindBuffer(GL_ARRAY_BUFFER, Command.Buffer);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), reinterpret_cast<void*>(Command.First * sizeof(glm::vec2)));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, Command.Count);
+	FrameStats.DrawCalls++;
+}
+
+void Renderer::ExecuteParticleFeedback(const RenderCommand& Command)
+{
+	State.BindVertexArray(Command.VertexArray);
+
+	Command.CommandShader->SetFloat("scale", Command.Scale);
+
+	glDrawArrays(GL_POINTS, 0, Command.Count);
+	FrameStats.DrawCalls++;
 }
 
+GpuPass Renderer::GetGpuPass(RenderCommandType Type)
+{
+	switch (Type)
+	{
+	case RenderCommandType::Particles:
+	case RenderCommandType::ParticleFeedback:
+		return GpuPass::Particles;
+	case RenderCommandType::Text:
+	case RenderCommandType::Prebuilt:
+		return GpuPass::Text;
+	case RenderCommandType::Sprite:
+	case RenderCommandType::SpriteInstanced:
+	default:
+		return GpuPass::Sprites;
+	}
+}
@@ -1,26 +1,41 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
 
+#include "GpuTimer.h"
+#include "RenderCommand.h"
+#include "RenderState.h"
+#include "StreamBuffer.h"
 
 namespace pk
 {
 	class Shader;
 	class Texture;
+	class InstanceBuffer;
+	class RenderTarget;
 	struct Particle;
 	struct Character;
 
+	// Render calls only queue a command in the bucket of the current layer. Flush draws the buckets in layer order,
+	// each one sorted by shader, texture and depth through the state tracker, unless it already arrived in that order.
+	// Sprites, particles and text are written to the stream buffer, neighbours sharing shader and texture draw together.
 	class Renderer
 	{
 	public:
 		typedef std::shared_ptr<Shader> ShaderPtr;
 		typedef std::shared_ptr<Texture> TexturePtr;
-		typedef std::vector<std::shared_ptr<Particle>> ParticleList;
+		typedef std::vector<Particle> ParticleList;
 		typedef std::map<char, Character> CharacterMap;
+		typedef std::vector<StreamVertex> VertexList;
+		typedef std::array<std::vector<std::uint64_t>, NUM_RENDER_LAYERS> LayerKeyList;
+
+		static const int MAX_COMMANDS;
 
 		static Renderer& Get()
 		{
@@ -29,17 +44,108 @@ namespace pk
 		}
 
 		void RenderSprite(const ShaderPtr& Shader, const TexturePtr& Texture, const glm::mat4& Model, const glm::vec3& Color);
+		// One draw for the offsets in [First, First + Count), each added to the model's translation.
+		void RenderSpriteInstanced(const ShaderPtr& Shader, const TexturePtr& Texture, const glm::mat4& Model, const InstanceBuffer& Instances, int First, int Count);
+		// Particles are read at flush time, the list must not change before then.
 		void RenderParticleVfx(const ParticleList& Particles, const ShaderPtr& Shader, const TexturePtr& Texture, float Scale);
+		// Draws the first Count points of a vertex array filled by transform feedback, the shader expands each into a quad.
+		void RenderParticleFeedback(const ShaderPtr& Shader, const TexturePtr& Texture, unsigned int VertexArray, int Count, float Scale);
 		void RenderText(const std::string& Text, const ShaderPtr& Shader, const CharacterMap& Characters, const glm::vec2& Position, float Scale, const glm::vec4& Color);
+		// Draws vertices the caller keeps around between frames, like a laid out label. They are read at flush time.
+		void RenderVertices(const ShaderPtr& Shader, unsigned int TextureId, const VertexList& Vertices);
+
+		// Two triangles per glyph starting at Position, OutVertices must have room for Count * 6.
+		static void WriteGlyphs(const char* Text, int Count, const CharacterMap& Characters, const glm::vec2& Position, float Scale, const glm::vec4& Color, StreamVertex* OutVertices);
+
+		// Commands submitted from now on go to this layer and blend this way.
+		void SetLayer(RenderLayer InLayer);
+		void SetBlendMode(BlendMode InBlend);
+		RenderLayer GetLayer() const;
+		BlendMode GetBlendMode() const;
+
+		// ViewSize is the space the projection covers, the pixel size what the frame is drawn to.
+		// They differ when the scene renders below native resolution.
+		void SetFrameSize(const glm::vec2& InViewSize, int InPixelWidth, int InPixelHeight);
+		glm::vec2 GetViewSize() const;
+		int GetPixelWidth() const;
+		int GetPixelHeight() const;
+
+		// Commands submitted until EndTarget are drawn into the target, the frame's queue is set aside meanwhile.
+		// Positions stay in the projection's space, a target the size of the frame keeps them one to one.
+		void BeginTarget(RenderTarget& InTarget);
+		// Clears the target and draws its commands right away, then goes back to the frame's queue.
+		void EndTarget();
+
+		// Draws and clears the queue, called once per frame after everything has been submitted.
+		void Flush();
+
+		// Starts the frame's GPU timings, the ones of a few frames back reach the profiler here.
+		void BeginFrame(int FrameIndex);
+		// For GL work done outside the queue, like presenting the frame. Queued draws are timed by the renderer.
+		void BeginGpuPass(GpuPass Pass);
+		void EndGpuPass();
+
+		// Binds through the state tracker, anything outside the renderer that needs a program must use this.
+		void UseShader(const ShaderPtr& Shader);
+
+		// Counters of the last flushed frame.
+		RenderStats GetStats() const;
 
 	private:
+		// Streamed commands that ended up next to each other after sorting share one draw.
+		struct DrawItem
+		{
+			const RenderCommand* Command;
+			int FirstVertex;
+			int NumVertices;
+		};
+
 		Renderer();
 		void InitializeSpriteQuad();
-		void InitializeTextQuad();
+		void InitializeStream();
+
+		RenderCommand& Submit(RenderCommandType Type, const ShaderPtr& Shader, const TexturePtr& Texture, float Depth);
+		void DrawQueue();
+		void DrawTargetQueue();
+		void BuildDrawItems();
+		int CountVertices(const RenderCommand& Command) const;
+		void WriteSprite(const RenderCommand& Command, StreamVertex* OutVertices) const;
+		void WriteParticles(const RenderCommand& Command, StreamVertex* OutVertices) const;
+		void WriteText(const RenderCommand& Command, StreamVertex* OutVertices) const;
+		void Execute(const DrawItem& Item, int BaseVertex);
+		void ExecuteSpriteInstanced(const RenderCommand& Command);
+		void ExecuteParticleFeedback(const RenderCommand& Command);
+		static GpuPass GetGpuPass(RenderCommandType Type);
+
+		unsigned int InstancedQuadId;
+		unsigned int StreamVertexArray;
+		StreamBuffer Stream;
+
+		RenderLayer Layer;
+		BlendMode Blend;
+
+		glm::vec2 ViewSize;
+		int PixelWidth;
+		int PixelHeight;
+
+		std::vector<RenderCommand> Commands;
+		// Sort keys per layer, the low bits hold the command index so equal keys keep submission order.
+		LayerKeyList Keys;
+		std::vector<DrawItem> Items;
+		std::string TextArena;
+
+		// Only set between BeginTarget and EndTarget.
+		RenderTarget* Target;
+		bool bTargetCleared;
+		int FrameFramebuffer;
+		int FrameViewport[4];
+		std::vector<RenderCommand> FrameCommands;
+		LayerKeyList FrameKeys;
+		std::string FrameTextArena;
 
-		unsigned int SpriteQuadId;
-		unsigned int TextQuadId;
-		unsigned int TextBufferId;
-		unsigned int LastShaderId;
+		RenderState State;
+		GpuTimer Timer;
+		RenderStats FrameStats;
+		RenderStats LastStats;
 	};
-}
\ No newline at end of file
+}
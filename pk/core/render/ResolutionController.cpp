@@ -0,0 +1,78 @@
+#include "ResolutionController.h"
+
+#include <algorithm>
+
+using namespace pk;
+
+const float ResolutionController::DEFAULT_FRAME_BUDGET = 1.f / 55.f;
+const float ResolutionController::DEFAULT_MIN_SCALE = .5f;
+const float ResolutionController::SCALE_STEP = .1f;
+const float ResolutionController::HEADROOM = .75f;
+const int ResolutionController::SETTLE_FRAMES = 30;
+
+// Weight of the newest frame in the running average.
+static constexpr float AVERAGE_WEIGHT = .1f;
+
+ResolutionController::ResolutionController()
+	: FrameBudget(DEFAULT_FRAME_BUDGET), MinScale(DEFAULT_MIN_SCALE), MaxScale(1.f), Scale(1.f),
+		AverageFrameTime(0.f), FramesSinceChange(0)
+{
+}
+
+void ResolutionController::Configure(float InFrameBudget, float InMinScale, float InMaxScale)
+{
+	FrameBudget = std::max(0.001f, InFrameBudget);
+	MaxScale = std::clamp(InMaxScale, .1f, 1.f);
+	MinScale = std::clamp(InMinScale, .1f, MaxScale);
+	Scale = std::clamp(Scale, MinScale, MaxScale);
+}
+
+void ResolutionController::Reset(float InScale)
+{
+	Scale = std::clamp(InScale, MinScale, MaxScale);
+	AverageFrameTime = 0.f;
+	FramesSinceChange = 0;
+}
+
+void ResolutionController::SetMaxScale(float InMaxScale)
+{
+	Configure(FrameBudget, MinScale, InMaxScale);
+}
+
+float ResolutionController::Update(float FrameTime)
+{
+	AverageFrameTime = AverageFrameTime <= 0.f ? FrameTime : AverageFrameTime + (FrameTime - AverageFrameTime) * AVERAGE_WEIGHT;
+
+	if (++FramesSinceChange < SETTLE_FRAMES)
+	{
+		return Scale;
+	}
+
+	float NewScale = Scale;
+	if (AverageFrameTime > FrameBudget)
+	{
+		NewScale = std::max(MinScale, Scale - SCALE_STEP);
+	}
+	else if (AverageFrameTime < FrameBudget * HEADROOM)
+	{
+		NewScale = std::min(MaxScale, Scale + SCALE_STEP);
+	}
+
+	if (NewScale != Scale)
+	{
+		Scale = NewScale;
+		FramesSinceChange = 0;
+	}
+
+	return Scale;
+}
+
+float ResolutionController::GetScale() const
+{
+	return Scale;
+}
+
+float ResolutionController::GetAverageFrameTime() const
+{
+	return AverageFrameTime;
+}
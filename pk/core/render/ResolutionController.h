@@ -0,0 +1,38 @@
+#pragma once
+
+namespace pk
+{
+	// Steps the render scale down while the averaged frame time is over budget and back up once there is headroom.
+	// Every change waits SETTLE_FRAMES, so a single spike or the target reallocation itself can't make it oscillate.
+	class ResolutionController
+	{
+	public:
+		static const float DEFAULT_FRAME_BUDGET;
+		static const float DEFAULT_MIN_SCALE;
+		static const float SCALE_STEP;
+		static const float HEADROOM;
+		static const int SETTLE_FRAMES;
+
+		ResolutionController();
+
+		// Budget in seconds, the scale never leaves [InMinScale, InMaxScale].
+		void Configure(float InFrameBudget, float InMinScale, float InMaxScale);
+		void Reset(float InScale);
+		// Keeps the budget and the floor, the current scale is clamped under the new ceiling.
+		void SetMaxScale(float InMaxScale);
+
+		// Feeds the last frame time in seconds, returns the scale for the next frame.
+		float Update(float FrameTime);
+
+		float GetScale() const;
+		float GetAverageFrameTime() const;
+
+	private:
+		float FrameBudget;
+		float MinScale;
+		float MaxScale;
+		float Scale;
+		float AverageFrameTime;
+		int FramesSinceChange;
+	};
+}
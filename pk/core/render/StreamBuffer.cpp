@@ -0,0 +1,154 @@
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glad/glad.h>
+
+using namespace pk;
+
+const int StreamBuffer::DEFAULT_SEGMENT_SIZE = 256 * 1024;
+
+// Segments start on this boundary so vertex offsets stay whole vertices.
+static constexpr int SEGMENT_ALIGNMENT = 256;
+
+StreamBuffer::StreamBuffer(int InSegmentSize)
+	: BufferId(0), SegmentSize(0), Segment(0), Fences{}
+{
+	SegmentSize = std::max(SEGMENT_ALIGNMENT, (InSegmentSize + SEGMENT_ALIGNMENT - 1) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT);
+	Staging.reserve(SegmentSize);
+
+	glGenBuffers(1, &BufferId);
+	Orphan();
+}
+
+void StreamBuffer::Begin()
+{
+	Segment = (Segment + 1) % NUM_SEGMENTS;
+	Staging.clear();
+
+	GLsync Fence = static_cast<GLsync>(Fences[Segment]);
+	if (Fence == nullptr)
+	{
+		return;
+	}
+
+	// A zero timeout only polls, a segment the GPU hasn't finished is dropped rather than waited on.
+	const GLenum Status = glClientWaitSync(Fence, 0, 0);
+	if (Status == GL_TIMEOUT_EXPIRED || Status == GL_WAIT_FAILED)
+	{
+		Stats.SyncWaits++;
+		Orphan();
+		return;
+	}
+
+	glDeleteSync(Fence);
+	Fences[Segment] = nullptr;
+}
+
+void* StreamBuffer::Allocate(int Bytes, int& OutOffset)
+{
+	OutOffset = static_cast<int>(Staging.size());
+	Staging.resize(Staging.size() + Bytes);
+	Stats.Allocations++;
+	return Staging.data() + OutOffset;
+}
+
+void StreamBuffer::Upload()
+{
+	const int Bytes = static_cast<int>(Staging.size());
+	if (Bytes == 0)
+	{
+		return;
+	}
+
+	if (Bytes > SegmentSize)
+	{
+		while (SegmentSize < Bytes)
+		{
+			SegmentSize *= 2;
+		}
+
+		Stats.Grown++;
+		Segment = 0;
+		Orphan();
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, BufferId);
+	// Unsynchronized is safe, the fence check in Begin made sure the GPU is done with this range.
+	void* Target = glMapBufferRange(GL_ARRAY_BUFFER, GetBaseOffset(), Bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (Target != nullptr)
+	{
+		std::memcpy(Target, Staging.data(), Bytes);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+	else
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, GetBaseOffset(), Bytes, Staging.data());
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	Stats.BytesUploaded += Bytes;
+}
+
+void StreamBuffer::End()
+{
+	if (Staging.empty())
+	{
+		return;
+	}
+
+	Fences[Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+unsigned int StreamBuffer::GetBufferId() const
+{
+	return BufferId;
+}
+
+int StreamBuffer::GetBaseOffset() const
+{
+	return Segment * SegmentSize;
+}
+
+int StreamBuffer::GetSegmentSize() const
+{
+	return SegmentSize;
+}
+
+StreamStats StreamBuffer::GetStats() const
+{
+	return Stats;
+}
+
+void StreamBuffer::ResetStats()
+{
+	Stats = StreamStats();
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	DeleteFences();
+	glDeleteBuffers(1, &BufferId);
+}
+
+void StreamBuffer::Orphan()
+{
+	// New storage under the same name, the driver keeps the old one alive until pending draws are done.
+	glBindBuffer(GL_ARRAY_BUFFER, BufferId);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(SegmentSize) * NUM_SEGMENTS, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	DeleteFences();
+}
+
+void StreamBuffer::DeleteFences()
+{
+	for (void*& Fence : Fences)
+	{
+		if (Fence != nullptr)
+		{
+			glDeleteSync(static_cast<GLsync>(Fence));
+			Fence = nullptr;
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+namespace pk
+{
+	struct StreamStats
+	{
+		int BytesUploaded;
+		int Allocations;
+		// Segments still read by the GPU when their turn came, each one orphaned instead of waited on.
+		int SyncWaits;
+		int Grown;
+
+		StreamStats()
+			: BytesUploaded(0), Allocations(0), SyncWaits(0), Grown(0)
+		{
+		}
+	};
+
+	// One vertex buffer split in NUM_SEGMENTS, a flush writes its dynamic geometry into the next segment.
+	// A fence per segment tells when the GPU is done with it, so writes never land on data still being drawn.
+	class StreamBuffer
+	{
+	public:
+		static const int NUM_SEGMENTS = 3;
+		static const int DEFAULT_SEGMENT_SIZE;
+
+		// Needs a current GL context.
+		explicit StreamBuffer(int InSegmentSize);
+
+		StreamBuffer(const StreamBuffer& InBuffer) = delete;
+		void operator=(const StreamBuffer& InBuffer) = delete;
+
+		// Moves to the next segment, orphaning the storage if the GPU still reads it.
+		void Begin();
+		// Room for Bytes, returned offsets are relative to GetBaseOffset once Upload is done.
+		void* Allocate(int Bytes, int& OutOffset);
+		// Copies everything allocated since Begin into the segment, growing every segment if it doesn't fit.
+		void Upload();
+		// Fences the segment, to be called after the last draw reading it.
+		void End();
+
+		unsigned int GetBufferId() const;
+		int GetBaseOffset() const;
+		int GetSegmentSize() const;
+
+		// Counters since the last ResetStats.
+		StreamStats GetStats() const;
+		void ResetStats();
+
+		~StreamBuffer();
+
+	private:
+		void Orphan();
+		void DeleteFences();
+
+		unsigned int BufferId;
+		int SegmentSize;
+		int Segment;
+
+		// GLsync handles, stored opaque so the header stays free of GL.
+		void* Fences[NUM_SEGMENTS];
+
+		std::vector<unsigned char> Staging;
+		StreamStats Stats;
+	};
+}
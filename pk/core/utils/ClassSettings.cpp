@@ -1,79 +1,172 @@
 #include "ClassSettings.h"
 
-#include <sstream>
-#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <charconv>
+#include <iostream>
 
 using namespace pk;
 
 ClassSettings::ClassSettings() = default;
 
-ClassSettings::ClassSettings(const SettingsMap& InMap)
-	: Map(InMap)
+void ClassSettings::Parse(std::string_view Content, const std::string& Source)
 {
+	while (!Content.empty())
+	{
+		const size_t LineEnd = Content.find('\n');
+		const std::string_view Line = Trim(Content.substr(0, LineEnd));
+		Content = (LineEnd == std::string_view::npos) ? std::string_view() : Content.substr(LineEnd + 1);
+
+		if (Line.empty() || Line.front() == '#')
+		{
+			continue;
+		}
+
+		const size_t Separator = Line.find('=');
+		if (Separator == std::string_view::npos)
+		{
+			std::cout << "[ClassSettings] - Skipping malformed line in " << Source << ": " << Line << "\n";
+			continue;
+		}
+
+		const std::string_view Name = Trim(Line.substr(0, Separator));
+		const KeyHash Id = Hash(Name);
+		if (const Entry* Existing = FindEntry(Id))
+		{
+			// A repeated key keeps its first value, a different name on the same hash would read back the wrong one.
+			if (Existing->Name != Name)
+			{
+				std::cout << "[ClassSettings] - " << Source << ": " << Name << " has the same hash as " << Existing->Name << ", rename one of them. Ignoring " << Name << ".\n";
+			}
+
+			continue;
+		}
+
+		const std::string_view Raw = Trim(Line.substr(Separator + 1));
+		Set(Id, Name, ParseValue(Raw), Raw);
+	}
 }
 
-void ClassSettings::SetMap(const SettingsMap& InMap)
+bool ClassSettings::Validate(const Schema& InSchema, const std::string& Source)
 {
-	Map = InMap;
+	bool bValid = true;
+	for (const SchemaEntry& Field : InSchema)
+	{
+		const KeyHash Id = Hash(Field.Name);
+		const Entry* Found = FindEntry(Id);
+		// Any text is a valid string, the string getters read the raw text.
+		if (Found == nullptr || Field.Type == ValueType::String)
+		{
+			continue;
+		}
+
+		Value Coerced;
+		if (Coerce(Found->Data, Field.Type, Coerced))
+		{
+			Set(Id, Found->Name, std::move(Coerced), Found->Raw);
+			continue;
+		}
+
+		std::cout << "[ClassSettings] - " << Source << ": " << Field.Name << " is not a valid " << GetTypeName(Field.Type) << ", using default.\n";
+		Entries.erase(std::find_if(Entries.begin(), Entries.end(), [Id](const Entry& Current) { return Current.Id == Id; }));
+		bValid = false;
+	}
+
+	return bValid;
 }
 
 bool ClassSettings::Exists(const Key& InKey) const
 {
-	return Map.count(InKey) > 0;
+	return Find(InKey.Id) != nullptr;
+}
+
+int ClassSettings::Num() const
+{
+	return static_cast<int>(Entries.size());
 }
 
 bool ClassSettings::Get(const Key& InKey, const int Default, int& OutValue) const
 {
-	if (!Exists(InKey))
+	OutValue = Default;
+	const Value* Found = Find(InKey.Id);
+	if (Found == nullptr)
 	{
-		OutValue = Default;
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	OutValue = std::stoi(TempValue);
-	return true;
+	if (const int* Int = std::get_if<int>(Found))
+	{
+		OutValue = *Int;
+		return true;
+	}
+
+	if (const float* Float = std::get_if<float>(Found))
+	{
+		OutValue = static_cast<int>(*Float);
+		return true;
+	}
+
+	return false;
 }
 
 bool ClassSettings::Get(const Key& InKey, const float Default, float& OutValue) const
 {
-	if (!Exists(InKey))
+	OutValue = Default;
+	const Value* Found = Find(InKey.Id);
+	if (Found == nullptr)
 	{
-		OutValue = Default;
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	OutValue = std::stof(TempValue);
-	return true;
+	if (const float* Float = std::get_if<float>(Found))
+	{
+		OutValue = *Float;
+		return true;
+	}
+
+	if (const int* Int = std::get_if<int>(Found))
+	{
+		OutValue = static_cast<float>(*Int);
+		return true;
+	}
+
+	return false;
 }
 
-bool ClassSettings::Get(const Key& InKey, const std::string& Default, Value& OutValue) const
+bool ClassSettings::Get(const Key& InKey, const std::string& Default, std::string& OutValue) const
 {
-	if (!Exists(InKey))
+	const Entry* Found = FindEntry(InKey.Id);
+	if (Found == nullptr)
 	{
 		OutValue = Default;
 		return false;
 	}
 
-	OutValue = Map.at(InKey);
+	OutValue = Found->Raw;
 	return true;
 }
 
 bool ClassSettings::Get(const Key& InKey, IntList& OutList) const
 {
-	if (!Exists(InKey))
+	const Value* Found = Find(InKey.Id);
+	if (Found == nullptr || CountNumbers(*Found) <= 0)
 	{
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	StringList TempList = Split(TempValue);
-
 	OutList.clear();
-	for (const Value& Element : TempList)
+	if (const IntList* Ints = std::get_if<IntList>(Found))
+	{
+		OutList = *Ints;
+	}
+	else if (const FloatList* Floats = std::get_if<FloatList>(Found))
 	{
-		OutList.push_back(std::stoi(Element));
+		OutList.assign(Floats->begin(), Floats->end());
+	}
+	else
+	{
+		float Values[4];
+		const int Count = AsFloats(*Found, Values, 4);
+		OutList.assign(Values, Values + Count);
 	}
 
 	return true;
@@ -81,18 +174,26 @@ bool ClassSettings::Get(const Key& InKey, IntList& OutList) const
 
 bool ClassSettings::Get(const Key& InKey, FloatList& OutList) const
 {
-	if (!Exists(InKey))
+	const Value* Found = Find(InKey.Id);
+	if (Found == nullptr || CountNumbers(*Found) <= 0)
 	{
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	StringList TempList = Split(TempValue);
-
 	OutList.clear();
-	for (const Value& Element : TempList)
+	if (const FloatList* Floats = std::get_if<FloatList>(Found))
 	{
-		OutList.push_back(std::stof(Element));
+		OutList = *Floats;
+	}
+	else if (const IntList* Ints = std::get_if<IntList>(Found))
+	{
+		OutList.assign(Ints->begin(), Ints->end());
+	}
+	else
+	{
+		float Values[4];
+		const int Count = AsFloats(*Found, Values, 4);
+		OutList.assign(Values, Values + Count);
 	}
 
 	return true;
@@ -100,105 +201,305 @@ bool ClassSettings::Get(const Key& InKey, FloatList& OutList) const
 
 bool ClassSettings::Get(const Key& InKey, StringList& OutList) const
 {
-	if (!Exists(InKey))
+	const Entry* Found = FindEntry(InKey.Id);
+	if (Found == nullptr)
 	{
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
 	OutList.clear();
-	OutList = Split(TempValue);
+	std::string_view Remaining(Found->Raw);
+	while (true)
+	{
+		const size_t Comma = Remaining.find(',');
+		OutList.emplace_back(Trim(Remaining.substr(0, Comma)));
+		if (Comma == std::string_view::npos)
+		{
+			break;
+		}
+
+		Remaining = Remaining.substr(Comma + 1);
+	}
+
 	return true;
 }
 
 bool ClassSettings::Get(const Key& InKey, Vec2& OutVec) const
 {
-	if (!Exists(InKey))
+	const Value* Found = Find(InKey.Id);
+	float Values[4];
+	if (Found == nullptr || AsFloats(*Found, Values, 4) < 2)
 	{
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	const StringList Splitted = Split(TempValue);
-	if (Splitted.size() < 2)
+	OutVec = Vec2(Values[0], Values[1]);
+	return true;
+}
+
+bool ClassSettings::Get(const Key& InKey, Vec3& OutVec) const
+{
+	const Value* Found = Find(InKey.Id);
+	float Values[4];
+	if (Found == nullptr || AsFloats(*Found, Values, 4) < 3)
 	{
 		return false;
 	}
 
-	const FloatList Floats = AsFloat(Splitted);
-	OutVec.x = Floats[0];
-	OutVec.y = Floats[1];
-
+	OutVec = Vec3(Values[0], Values[1], Values[2]);
 	return true;
 }
 
-bool ClassSettings::Get(const Key& InKey, Vec3& OutVec) const
+bool ClassSettings::Get(const Key& InKey, Vec4& OutVec) const
 {
-	if (!Exists(InKey))
+	const Value* Found = Find(InKey.Id);
+	float Values[4];
+	if (Found == nullptr || AsFloats(*Found, Values, 4) < 4)
 	{
 		return false;
 	}
 
-	const Value TempValue = Map.at(InKey);
-	const StringList Splitted = Split(TempValue);
-	if (Splitted.size() < 3)
+	OutVec = Vec4(Values[0], Values[1], Values[2], Values[3]);
+	return true;
+}
+
+const char* ClassSettings::GetTypeName(ValueType Type)
+{
+	switch (Type)
+	{
+	case ValueType::Int: return "int";
+	case ValueType::Float: return "float";
+	case ValueType::Vec2: return "vec2";
+	case ValueType::Vec3: return "vec3";
+	case ValueType::Vec4: return "vec4";
+	case ValueType::IntList: return "int list";
+	case ValueType::FloatList: return "float list";
+	case ValueType::String: return "string";
+	}
+
+	return "unknown";
+}
+
+const ClassSettings::Value* ClassSettings::Find(KeyHash Id) const
+{
+	const Entry* Found = FindEntry(Id);
+	return (Found != nullptr) ? &Found->Data : nullptr;
+}
+
+const ClassSettings::Entry* ClassSettings::FindEntry(KeyHash Id) const
+{
+	const auto Found = std::lower_bound(Entries.begin(), Entries.end(), Id,
+		[](const Entry& Current, KeyHash Searched) { return Current.Id < Searched; });
+
+	if (Found == Entries.end() || Found->Id != Id)
 	{
-		return false;
+		return nullptr;
 	}
 
-	const FloatList Floats = AsFloat(Splitted);
-	OutVec.x = Floats[0];
-	OutVec.y = Floats[1];
-	OutVec.z = Floats[2];
+	return &*Found;
+}
 
-	return true;
+void ClassSettings::Set(KeyHash Id, std::string_view Name, Value&& InValue, std::string_view Raw)
+{
+	const auto Found = std::lower_bound(Entries.begin(), Entries.end(), Id,
+		[](const Entry& Current, KeyHash Searched) { return Current.Id < Searched; });
+
+	if (Found != Entries.end() && Found->Id == Id)
+	{
+		Found->Data = std::move(InValue);
+		return;
+	}
+
+	Entries.insert(Found, Entry{ Id, std::string(Name), std::move(InValue), std::string(Raw) });
 }
 
-bool ClassSettings::Get(const Key& InKey, Vec4& OutVec) const
+ClassSettings::Value ClassSettings::ParseValue(std::string_view Raw)
 {
-	if (!Exists(InKey))
+	Raw = Trim(Raw);
+
+	FloatList Numbers;
+	IntList Integers;
+	bool bAllIntegers = true;
+	std::string_view Remaining(Raw);
+	while (!Raw.empty())
 	{
-		return false;
+		const size_t Comma = Remaining.find(',');
+		float Number;
+		int Integer;
+		bool bInteger;
+		if (!ParseNumber(Trim(Remaining.substr(0, Comma)), Number, Integer, bInteger))
+		{
+			return std::string(Raw);
+		}
+
+		Numbers.push_back(Number);
+		Integers.push_back(Integer);
+		bAllIntegers = bAllIntegers && bInteger;
+		if (Comma == std::string_view::npos)
+		{
+			break;
+		}
+
+		Remaining = Remaining.substr(Comma + 1);
 	}
 
-	const Value TempValue = Map.at(InKey);
-	const StringList Splitted = Split(TempValue);
-	if (Splitted.size() < 4)
+	switch (Numbers.size())
 	{
-		return false;
+	case 0: return std::string(Raw);
+	case 1:
+		if (bAllIntegers)
+		{
+			return Integers[0];
+		}
+
+		return Numbers[0];
+	case 2: return Vec2(Numbers[0], Numbers[1]);
+	case 3: return Vec3(Numbers[0], Numbers[1], Numbers[2]);
+	case 4: return Vec4(Numbers[0], Numbers[1], Numbers[2], Numbers[3]);
+	default:
+		if (bAllIntegers)
+		{
+			return Integers;
+		}
+
+		return Numbers;
 	}
+}
 
-	const FloatList Floats = AsFloat(Splitted);
-	OutVec.x = Floats[0];
-	OutVec.y = Floats[1];
-	OutVec.z = Floats[2];
-	OutVec.w = Floats[3];
+std::string_view ClassSettings::Trim(std::string_view Raw)
+{
+	const char* Blanks = " \t\r\n";
+	const size_t Start = Raw.find_first_not_of(Blanks);
+	if (Start == std::string_view::npos)
+	{
+		return std::string_view();
+	}
 
-	return true;
+	const size_t End = Raw.find_last_not_of(Blanks);
+	return Raw.substr(Start, End - Start + 1);
 }
 
-ClassSettings::StringList ClassSettings::Split(const Value& InValue)
+bool ClassSettings::ParseNumber(std::string_view Raw, float& OutFloat, int& OutInt, bool& bOutInteger)
 {
-	std::stringstream Stream(InValue);
-	StringList Result;
+	if (!Raw.empty() && Raw.front() == '+')
+	{
+		Raw.remove_prefix(1);
+	}
+
+	if (Raw.empty())
+	{
+		return false;
+	}
 
-	while (Stream.good())
+	const char* End = Raw.data() + Raw.size();
+	bOutInteger = Raw.find_first_of(".eE") == std::string_view::npos;
+	if (bOutInteger)
 	{
-		Value Element;
-		std::getline(Stream, Element, ',');
-		Result.push_back(Element);
+		// Out of range reports std::errc::result_out_of_range, the value is then kept as text.
+		const std::from_chars_result Result = std::from_chars(Raw.data(), End, OutInt);
+		OutFloat = static_cast<float>(OutInt);
+		return Result.ec == std::errc() && Result.ptr == End;
 	}
 
-	return Result;
+	OutInt = 0;
+	const std::from_chars_result Result = std::from_chars(Raw.data(), End, OutFloat);
+	return Result.ec == std::errc() && Result.ptr == End;
 }
 
-ClassSettings::FloatList ClassSettings::AsFloat(const StringList& InList)
+int ClassSettings::AsFloats(const Value& InValue, float* OutValues, int MaxValues)
 {
-	FloatList OutList;
-	for (const std::string& Element : InList)
+	const int Count = CountNumbers(InValue);
+	const int ToCopy = std::min(Count, MaxValues);
+	for (int i = 0; i < ToCopy; ++i)
+	{
+		switch (InValue.index())
+		{
+		case 0: OutValues[i] = static_cast<float>(std::get<int>(InValue)); break;
+		case 1: OutValues[i] = std::get<float>(InValue); break;
+		case 2: OutValues[i] = std::get<Vec2>(InValue)[i]; break;
+		case 3: OutValues[i] = std::get<Vec3>(InValue)[i]; break;
+		case 4: OutValues[i] = std::get<Vec4>(InValue)[i]; break;
+		case 5: OutValues[i] = static_cast<float>(std::get<IntList>(InValue)[i]); break;
+		case 6: OutValues[i] = std::get<FloatList>(InValue)[i]; break;
+		default: break;
+		}
+	}
+
+	return Count;
+}
+
+int ClassSettings::CountNumbers(const Value& InValue)
+{
+	switch (InValue.index())
+	{
+	case 0:
+	case 1: return 1;
+	case 2: return 2;
+	case 3: return 3;
+	case 4: return 4;
+	case 5: return static_cast<int>(std::get<IntList>(InValue).size());
+	case 6: return static_cast<int>(std::get<FloatList>(InValue).size());
+	default: return 0;
+	}
+}
+
+bool ClassSettings::Coerce(const Value& InValue, ValueType Type, Value& OutValue)
+{
+	const int Count = CountNumbers(InValue);
+	float Values[4];
+	AsFloats(InValue, Values, 4);
+
+	switch (Type)
 	{
-		OutList.push_back(std::stof(Element));
+	case ValueType::Int:
+		if (Count != 1 || !std::holds_alternative<int>(InValue)) { return false; }
+		OutValue = InValue;
+		return true;
+	case ValueType::Float:
+		if (Count != 1) { return false; }
+		OutValue = Values[0];
+		return true;
+	case ValueType::Vec2:
+		if (Count != 2) { return false; }
+		OutValue = Vec2(Values[0], Values[1]);
+		return true;
+	case ValueType::Vec3:
+		if (Count != 3) { return false; }
+		OutValue = Vec3(Values[0], Values[1], Values[2]);
+		return true;
+	case ValueType::Vec4:
+		if (Count != 4) { return false; }
+		OutValue = Vec4(Values[0], Values[1], Values[2], Values[3]);
+		return true;
+	case ValueType::IntList:
+		if (Count <= 0 || std::holds_alternative<FloatList>(InValue)) { return false; }
+		if (const IntList* Ints = std::get_if<IntList>(&InValue))
+		{
+			OutValue = *Ints;
+		}
+		else
+		{
+			OutValue = IntList(Values, Values + std::min(Count, 4));
+		}
+		return true;
+	case ValueType::FloatList:
+		if (Count <= 0) { return false; }
+		if (const FloatList* Floats = std::get_if<FloatList>(&InValue))
+		{
+			OutValue = *Floats;
+		}
+		else if (const IntList* Ints = std::get_if<IntList>(&InValue))
+		{
+			OutValue = FloatList(Ints->begin(), Ints->end());
+		}
+		else
+		{
+			OutValue = FloatList(Values, Values + std::min(Count, 4));
+		}
+		return true;
+	default:
+		break;
 	}
 
-	return OutList;
+	return false;
 }
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 #include <glm/detail/type_vec.hpp>
 
@@ -14,26 +16,81 @@ namespace pk
 		typedef std::shared_ptr<ClassSettings> SharedPtr;
 		typedef std::shared_ptr<const ClassSettings> SharedConstPtr;
 
-		typedef std::string Key;
-		typedef std::string Value;
+		typedef std::uint32_t KeyHash;
 		typedef std::vector<int> IntList;
 		typedef std::vector<float> FloatList;
-		typedef std::vector<Value> StringList;
+		typedef std::vector<std::string> StringList;
 		typedef glm::vec2 Vec2;
 		typedef glm::vec3 Vec3;
 		typedef glm::vec4 Vec4;
-		typedef std::map<Key, Value> SettingsMap;
+		typedef std::variant<int, float, Vec2, Vec3, Vec4, IntList, FloatList, std::string> Value;
+
+		enum class ValueType : std::uint8_t
+		{
+			Int,
+			Float,
+			Vec2,
+			Vec3,
+			Vec4,
+			IntList,
+			FloatList,
+			String
+		};
+
+		// FNV-1a, usable in constant expressions so literal keys cost nothing at runtime.
+		static constexpr KeyHash Hash(std::string_view InName)
+		{
+			KeyHash Result = 2166136261u;
+			for (const char Char : InName)
+			{
+				Result = (Result ^ static_cast<unsigned char>(Char)) * 16777619u;
+			}
+
+			return Result;
+		}
+
+		struct Key
+		{
+			KeyHash Id;
+
+			constexpr Key(const char* InName) : Id(Hash(InName)) {}
+			constexpr Key(std::string_view InName) : Id(Hash(InName)) {}
+			Key(const std::string& InName) : Id(Hash(InName)) {}
+		};
+
+		struct SchemaEntry
+		{
+			const char* Name;
+			ValueType Type;
+		};
+
+		typedef std::vector<SchemaEntry> Schema;
+
+		struct Entry
+		{
+			KeyHash Id;
+			// Kept to tell a repeated key from a different one hashing the same.
+			std::string Name;
+			Value Data;
+			// Trimmed text after '=', the string getters read it so numeric looking strings survive parsing.
+			std::string Raw;
+		};
+
+		typedef std::vector<Entry> EntryList;
 
 		ClassSettings();
-		ClassSettings(const SettingsMap& InMap);
 
-		void SetMap(const SettingsMap& InMap);
+		// Parses "Key=Value" lines once, values are stored already typed next to their raw text.
+		void Parse(std::string_view Content, const std::string& Source);
+		// Coerces known keys to the declared type and drops the ones that do not fit, returns false on any mismatch.
+		bool Validate(const Schema& InSchema, const std::string& Source);
 
 		bool Exists(const Key& InKey) const;
+		int Num() const;
 
 		bool Get(const Key& InKey, const int Default, int& OutValue) const;
 		bool Get(const Key& InKey, const float Default, float& OutValue) const;
-		bool Get(const Key& InKey, const std::string& Default, Value& OutValue) const;
+		bool Get(const Key& InKey, const std::string& Default, std::string& OutValue) const;
 
 		bool Get(const Key& InKey, IntList& OutList) const;
 		bool Get(const Key& InKey, FloatList& OutList) const;
@@ -43,10 +100,21 @@ namespace pk
 		bool Get(const Key& InKey, Vec3& OutVec) const;
 		bool Get(const Key& InKey, Vec4& OutVec) const;
 
+		static const char* GetTypeName(ValueType Type);
+
 	private:
-		static StringList Split(const Value& InValue);
-		static FloatList AsFloat(const StringList& InList);
+		const Value* Find(KeyHash Id) const;
+		const Entry* FindEntry(KeyHash Id) const;
+		void Set(KeyHash Id, std::string_view Name, Value&& InValue, std::string_view Raw);
+
+		static Value ParseValue(std::string_view Raw);
+		static std::string_view Trim(std::string_view Raw);
+		// Tokens without '.', 'e' or 'E' are read as int, an out of range one fails instead of losing precision.
+		static bool ParseNumber(std::string_view Raw, float& OutFloat, int& OutInt, bool& bOutInteger);
+		static int AsFloats(const Value& InValue, float* OutValues, int MaxValues);
+		static int CountNumbers(const Value& InValue);
+		static bool Coerce(const Value& InValue, ValueType Type, Value& OutValue);
 
-		SettingsMap Map;
+		EntryList Entries;
 	};
-}
\ No newline at end of file
+}
@@ -1,12 +1,13 @@
 #include "ClassSettingsReader.h"
 
-#include <fstream>
 #include <iostream>
-#include <sstream>
+
+#include "MappedFile.h"
 
 using namespace pk;
 
 ClassSettingsReader::Map ClassSettingsReader::AllSettings{};
+ClassSettingsReader::SchemaMap ClassSettingsReader::AllSchemas{};
 
 ClassSettings::SharedConstPtr ClassSettingsReader::Load(const Map::key_type& InPath)
 {
@@ -15,7 +16,7 @@ ClassSettings::SharedConstPtr ClassSettingsReader::Load(const Map::key_type& InP
 		return Get(InPath);
 	}
 
-	ClassSettings::SharedConstPtr NewSettings = ReadFile(InPath);
+	ClassSettings::SharedConstPtr NewSettings = Validated(InPath, ReadFile(InPath));
     if (NewSettings == nullptr)
     {
         return nullptr;
@@ -25,6 +26,17 @@ ClassSettings::SharedConstPtr ClassSettingsReader::Load(const Map::key_type& InP
 	return NewSettings;
 }
 
+ClassSettings::SharedConstPtr ClassSettingsReader::Load(const Map::key_type& InPath, const ClassSettings::Schema& InSchema)
+{
+    if (Exists(InPath))
+    {
+        return Get(InPath);
+    }
+
+    AllSchemas[InPath] = InSchema;
+    return Load(InPath);
+}
+
 ClassSettings::SharedConstPtr ClassSettingsReader::Get(const Map::key_type& InPath)
 {
     if (!Exists(InPath))
@@ -40,45 +52,45 @@ bool ClassSettingsReader::Exists(const Map::key_type& InPath)
     return AllSettings.count(InPath) > 0;
 }
 
-ClassSettings::SharedConstPtr ClassSettingsReader::ReadFile(const std::string& InPath)
+bool ClassSettingsReader::Replace(const Map::key_type& InPath, const ClassSettings::SharedConstPtr& InSettings)
 {
-	ClassSettings::SharedPtr NewSettings = std::make_shared<ClassSettings>();
-    ClassSettings::SettingsMap NewSettingsMap;
-
-    std::ifstream Handler;
-    Handler.exceptions(std::ifstream::badbit);
-
-    try {
-        Handler.open(InPath);
-        std::string Line;
-        while (std::getline(Handler, Line))
-        {
-            if (Line.empty())
-            {
-                continue;
-            }
-
-            SettingPair NewPair = Split(Line);
-            NewSettingsMap.insert(NewPair);
-        }
-    }
-    catch (const std::ifstream::failure& e) {
-        std::cout << "[ClassSettingsReader] - Error reading setting file: " << InPath << " " << e.what() << "\n";
-        return nullptr;
+    if (!Exists(InPath) || InSettings == nullptr)
+    {
+        return false;
     }
 
-    NewSettings->SetMap(NewSettingsMap);
-	return NewSettings;
+    AllSettings[InPath] = Validated(InPath, InSettings);
+    return true;
 }
 
-ClassSettingsReader::SettingPair ClassSettingsReader::Split(const std::string& Line)
+void ClassSettingsReader::Invalidate(const Map::key_type& InPath)
 {
-    SettingPair Pair;
-    std::stringstream Stream(Line);
+    AllSettings.erase(InPath);
+}
 
-    std::getline(Stream, Pair.first, '=');
-    std::getline(Stream, Pair.second, '=');
+ClassSettings::SharedConstPtr ClassSettingsReader::Validated(const Map::key_type& InPath, const ClassSettings::SharedConstPtr& InSettings)
+{
+    const SchemaMap::const_iterator Found = AllSchemas.find(InPath);
+    if (InSettings == nullptr || Found == AllSchemas.end())
+    {
+        return InSettings;
+    }
 
-    return Pair;
+    ClassSettings::SharedPtr Copy = std::make_shared<ClassSettings>(*InSettings);
+    Copy->Validate(Found->second, InPath);
+    return Copy;
 }
 
+ClassSettings::SharedConstPtr ClassSettingsReader::ReadFile(const std::string& InPath)
+{
+    MappedFile File(InPath);
+    if (!File.IsOpen())
+    {
+        std::cout << "[ClassSettingsReader] - Error reading setting file: " << InPath << "\n";
+        return nullptr;
+    }
+
+    ClassSettings::SharedPtr NewSettings = std::make_shared<ClassSettings>();
+    NewSettings->Parse(File.GetView(), InPath);
+    return NewSettings;
+}
@@ -10,15 +10,25 @@ namespace pk
 	public:
 		typedef std::map<std::string, ClassSettings::SharedConstPtr> Map;
 		typedef std::pair<Map::key_type, ClassSettings::SharedConstPtr> MapPair;
-		typedef std::pair<ClassSettings::Key, ClassSettings::Value> SettingPair;
+		typedef std::map<std::string, ClassSettings::Schema> SchemaMap;
 
 		static ClassSettings::SharedConstPtr Load(const Map::key_type& InPath);
+		// Same as Load, but every read of this path (hot reloads included) is validated against the schema.
+		static ClassSettings::SharedConstPtr Load(const Map::key_type& InPath, const ClassSettings::Schema& InSchema);
 		static ClassSettings::SharedConstPtr Get(const Map::key_type& InPath);
 		static bool Exists(const Map::key_type& InPath);
-	private:
+
+		// Replaces an already loaded entry, returns false if nobody ever loaded that path.
+		static bool Replace(const Map::key_type& InPath, const ClassSettings::SharedConstPtr& InSettings);
+		static void Invalidate(const Map::key_type& InPath);
+
+		// Does not touch the cache, safe to call from a worker thread.
 		static ClassSettings::SharedConstPtr ReadFile(const std::string& InPath);
-		static SettingPair Split(const std::string& Line);
+
+	private:
+		static ClassSettings::SharedConstPtr Validated(const Map::key_type& InPath, const ClassSettings::SharedConstPtr& InSettings);
 
 		static Map AllSettings;
+		static SchemaMap AllSchemas;
 	};
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ namespace pk
 		const glm::vec4 Red(1.f, 0.f, 0.f, 1.f);
 		const glm::vec4 Green(0.f, 1.f, 0.f, 1.f);
 		const glm::vec4 LightBlack(0.14f, 0.15f, 0.15f, 1.f);
+		const glm::vec4 LightGray(0.8f, 0.84f, 0.86f, 1.f);
 	}
 
 	namespace File
@@ -75,5 +76,12 @@ namespace pk
 	{
 		bool bHit;
 		glm::vec3 ImpactLocation;
+		// Part of a compound actor that was hit, -1 for plain actors.
+		int HitIndex;
+
+		CollisionResult()
+			: bHit(false), ImpactLocation(0.f), HitIndex(-1)
+		{
+		}
 	};
 }
\ No newline at end of file
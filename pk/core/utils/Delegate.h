@@ -0,0 +1,306 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pk
+{
+	template <typename Signature>
+	class Delegate;
+
+	// Type-erased callable stored inline: binding, copying and invoking never touch the heap.
+	template <typename Ret, typename... Args>
+	class Delegate<Ret(Args...)>
+	{
+	public:
+		static const std::size_t STORAGE_SIZE = 4 * sizeof(void*);
+
+		Delegate()
+			: Ops(nullptr)
+		{
+		}
+
+		Delegate(std::nullptr_t)
+			: Ops(nullptr)
+		{
+		}
+
+		template <typename Function, typename = typename std::enable_if<!std::is_same<typename std::decay<Function>::type, Delegate>::value>::type>
+		Delegate(Function&& InFunction)
+			: Ops(nullptr)
+		{
+			Bind(std::forward<Function>(InFunction));
+		}
+
+		Delegate(const Delegate& InDelegate)
+			: Ops(InDelegate.Ops)
+		{
+			if (Ops != nullptr)
+			{
+				Ops->Copy(Storage, InDelegate.Storage);
+			}
+		}
+
+		Delegate(Delegate&& InDelegate) noexcept
+			: Ops(InDelegate.Ops)
+		{
+			if (Ops != nullptr)
+			{
+				Ops->Move(Storage, InDelegate.Storage);
+				InDelegate.Reset();
+			}
+		}
+
+		Delegate& operator=(const Delegate& InDelegate)
+		{
+			if (this != &InDelegate)
+			{
+				Reset();
+				Ops = InDelegate.Ops;
+				if (Ops != nullptr)
+				{
+					Ops->Copy(Storage, InDelegate.Storage);
+				}
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(Delegate&& InDelegate) noexcept
+		{
+			if (this != &InDelegate)
+			{
+				Reset();
+				Ops = InDelegate.Ops;
+				if (Ops != nullptr)
+				{
+					Ops->Move(Storage, InDelegate.Storage);
+					InDelegate.Reset();
+				}
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t)
+		{
+			Reset();
+			return *this;
+		}
+
+		// Calling an unbound delegate is a bug, check IsBound first when binding is optional.
+		Ret operator()(Args... InArgs) const
+		{
+			assert(Ops != nullptr && "Delegate: called while unbound");
+			return Ops->Invoke(Storage, std::forward<Args>(InArgs)...);
+		}
+
+		explicit operator bool() const
+		{
+			return Ops != nullptr;
+		}
+
+		bool IsBound() const
+		{
+			return Ops != nullptr;
+		}
+
+		void Reset()
+		{
+			if (Ops != nullptr)
+			{
+				Ops->Destroy(Storage);
+				Ops = nullptr;
+			}
+		}
+
+		~Delegate()
+		{
+			Reset();
+		}
+
+	private:
+		struct Operations
+		{
+			Ret(*Invoke)(const void* Storage, Args&&... InArgs);
+			void (*Copy)(void* Dest, const void* Source);
+			void (*Move)(void* Dest, void* Source);
+			void (*Destroy)(void* Storage);
+		};
+
+		template <typename Function>
+		struct Table
+		{
+			static Ret Invoke(const void* InStorage, Args&&... InArgs)
+			{
+				return (*static_cast<Function*>(const_cast<void*>(InStorage)))(std::forward<Args>(InArgs)...);
+			}
+
+			static void Copy(void* Dest, const void* Source)
+			{
+				new (Dest) Function(*static_cast<const Function*>(Source));
+			}
+
+			static void Move(void* Dest, void* Source)
+			{
+				new (Dest) Function(std::move(*static_cast<Function*>(Source)));
+			}
+
+			static void Destroy(void* InStorage)
+			{
+				static_cast<Function*>(InStorage)->~Function();
+			}
+
+			static const Operations Ops;
+		};
+
+		template <typename Function>
+		void Bind(Function&& InFunction)
+		{
+			typedef typename std::decay<Function>::type Stored;
+			static_assert(sizeof(Stored) <= STORAGE_SIZE, "Delegate: callable too big for the inline storage, capture less.");
+			static_assert(alignof(Stored) <= alignof(std::max_align_t), "Delegate: callable is over-aligned.");
+
+			new (Storage) Stored(std::forward<Function>(InFunction));
+			Ops = &Table<Stored>::Ops;
+		}
+
+		alignas(std::max_align_t) unsigned char Storage[STORAGE_SIZE];
+		const Operations* Ops;
+	};
+
+	template <typename Ret, typename... Args>
+	template <typename Function>
+	const typename Delegate<Ret(Args...)>::Operations Delegate<Ret(Args...)>::Table<Function>::Ops = {
+		&Delegate<Ret(Args...)>::Table<Function>::Invoke,
+		&Delegate<Ret(Args...)>::Table<Function>::Copy,
+		&Delegate<Ret(Args...)>::Table<Function>::Move,
+		&Delegate<Ret(Args...)>::Table<Function>::Destroy
+	};
+
+	struct DelegateHandle
+	{
+		std::uint32_t Index;
+		std::uint32_t Generation;
+
+		DelegateHandle()
+			: Index(0), Generation(0)
+		{
+		}
+
+		bool IsValid() const
+		{
+			return Generation != 0;
+		}
+
+		void Invalidate()
+		{
+			Index = 0;
+			Generation = 0;
+		}
+	};
+
+	template <typename Signature, std::size_t MaxBindings>
+	class MulticastDelegate;
+
+	// Fixed number of subscribers kept inline, handles stay valid until removed.
+	template <typename... Args, std::size_t MaxBindings>
+	class MulticastDelegate<void(Args...), MaxBindings>
+	{
+	public:
+		typedef Delegate<void(Args...)> DelegateType;
+
+		MulticastDelegate()
+			: NextGeneration(1)
+		{
+		}
+
+		// The handle is invalid when every slot is taken.
+		DelegateHandle Add(const DelegateType& InDelegate)
+		{
+			DelegateHandle Handle;
+			for (std::size_t i = 0; i < MaxBindings; ++i)
+			{
+				Binding& Slot = Bindings[i];
+				if (Slot.Generation != 0)
+				{
+					continue;
+				}
+
+				Slot.Function = InDelegate;
+				Slot.Generation = NextGeneration++;
+				if (NextGeneration == 0)
+				{
+					NextGeneration = 1;
+				}
+
+				Handle.Index = static_cast<std::uint32_t>(i);
+				Handle.Generation = Slot.Generation;
+				return Handle;
+			}
+
+			assert(false && "MulticastDelegate: no free slot left, raise MaxBindings");
+			return Handle;
+		}
+
+		void Remove(DelegateHandle& Handle)
+		{
+			if (IsBound(Handle))
+			{
+				Bindings[Handle.Index].Function.Reset();
+				Bindings[Handle.Index].Generation = 0;
+			}
+
+			Handle.Invalidate();
+		}
+
+		bool IsBound(const DelegateHandle& Handle) const
+		{
+			return Handle.IsValid() && Handle.Index < MaxBindings && Bindings[Handle.Index].Generation == Handle.Generation;
+		}
+
+		void Clear()
+		{
+			for (Binding& Slot : Bindings)
+			{
+				Slot.Function.Reset();
+				Slot.Generation = 0;
+			}
+		}
+
+		// Subscribers may remove themselves (or others) while being called.
+		void Broadcast(Args... InArgs) const
+		{
+			for (const Binding& Slot : Bindings)
+			{
+				if (Slot.Generation == 0)
+				{
+					continue;
+				}
+
+				const DelegateType Function = Slot.Function;
+				Function(InArgs...);
+			}
+		}
+
+	private:
+		struct Binding
+		{
+			DelegateType Function;
+			std::uint32_t Generation;
+
+			Binding()
+				: Generation(0)
+			{
+			}
+		};
+
+		std::array<Binding, MaxBindings> Bindings;
+		std::uint32_t NextGeneration;
+	};
+}
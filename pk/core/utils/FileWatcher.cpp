@@ -0,0 +1,205 @@
+#include "FileWatcher.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace pk;
+
+namespace fs = std::filesystem;
+
+const int FileWatcher::DEFAULT_POLL_INTERVAL_MS = 250;
+
+FileWatcher::FileWatcher()
+	: bRunning(false)
+{
+}
+
+void FileWatcher::Start(const std::string& InRootPath, const OnFileChangedDelegate& InDelegate)
+{
+	if (IsRunning())
+	{
+		return;
+	}
+
+	RootPath = InRootPath;
+	if (!RootPath.empty() && RootPath.back() != '/')
+	{
+		RootPath += '/';
+	}
+
+	OnFileChanged = InDelegate;
+	bRunning = true;
+	Worker = std::thread(&FileWatcher::Run, this);
+}
+
+void FileWatcher::Stop()
+{
+	bRunning = false;
+	if (Worker.joinable())
+	{
+		Worker.join();
+	}
+}
+
+bool FileWatcher::IsRunning() const
+{
+	return bRunning;
+}
+
+std::string FileWatcher::GetRootPath() const
+{
+	return RootPath;
+}
+
+FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+void FileWatcher::Run()
+{
+#ifdef __linux__
+	RunNotify();
+#else
+	RunPolling();
+#endif
+}
+
+void FileWatcher::RunNotify()
+{
+#ifdef __linux__
+	const int Handle = inotify_init1(IN_NONBLOCK);
+	if (Handle < 0)
+	{
+		std::cout << "[FileWatcher] - inotify unavailable, falling back to polling.\n";
+		RunPolling();
+		return;
+	}
+
+	constexpr uint32_t EventMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+	std::map<int, std::string> WatchedFolders;
+	const auto WatchFolder = [&](const std::string& Folder)
+	{
+		const int WatchId = inotify_add_watch(Handle, Folder.c_str(), EventMask);
+		if (WatchId >= 0)
+		{
+			WatchedFolders[WatchId] = Folder;
+		}
+	};
+
+	std::error_code Error;
+	WatchFolder(RootPath);
+	for (fs::recursive_directory_iterator It(RootPath, Error), End; !Error && It != End; It.increment(Error))
+	{
+		if (It->is_directory(Error))
+		{
+			WatchFolder(It->path().generic_string() + '/');
+		}
+	}
+
+	alignas(inotify_event) char Buffer[4096];
+	std::set<std::string> ChangedPaths;
+	while (bRunning)
+	{
+		pollfd Descriptor{ Handle, POLLIN, 0 };
+		if (poll(&Descriptor, 1, DEFAULT_POLL_INTERVAL_MS) <= 0)
+		{
+			continue;
+		}
+
+		// Editors tend to emit bursts of events for a single save, collapse them before notifying.
+		ChangedPaths.clear();
+		ssize_t Length;
+		while ((Length = read(Handle, Buffer, sizeof(Buffer))) > 0)
+		{
+			for (char* Ptr = Buffer; Ptr < Buffer + Length; )
+			{
+				const inotify_event* Event = reinterpret_cast<const inotify_event*>(Ptr);
+				Ptr += sizeof(inotify_event) + Event->len;
+
+				if (Event->len == 0 || WatchedFolders.count(Event->wd) <= 0)
+				{
+					continue;
+				}
+
+				const std::string Path = WatchedFolders[Event->wd] + Event->name;
+				if (Event->mask & IN_ISDIR)
+				{
+					WatchFolder(Path + '/');
+				}
+				else if (Event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+				{
+					ChangedPaths.insert(Path);
+				}
+			}
+		}
+
+		for (const std::string& Path : ChangedPaths)
+		{
+			Notify(Path);
+		}
+	}
+
+	close(Handle);
+#endif
+}
+
+void FileWatcher::RunPolling()
+{
+	std::map<std::string, fs::file_time_type> LastWriteTimes;
+	bool bFirstScan = true;
+
+	while (bRunning)
+	{
+		std::error_code Error;
+		for (fs::recursive_directory_iterator It(RootPath, Error), End; !Error && It != End; It.increment(Error))
+		{
+			if (!It->is_regular_file(Error))
+			{
+				continue;
+			}
+
+			const std::string Path = It->path().generic_string();
+			const fs::file_time_type WriteTime = It->last_write_time(Error);
+			if (Error)
+			{
+				continue;
+			}
+
+			auto Found = LastWriteTimes.find(Path);
+			if (Found == LastWriteTimes.end())
+			{
+				LastWriteTimes.emplace(Path, WriteTime);
+				if (!bFirstScan)
+				{
+					Notify(Path);
+				}
+			}
+			else if (Found->second != WriteTime)
+			{
+				Found->second = WriteTime;
+				Notify(Path);
+			}
+		}
+
+		bFirstScan = false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_POLL_INTERVAL_MS));
+	}
+}
+
+void FileWatcher::Notify(const std::string& Path) const
+{
+	if (OnFileChanged)
+	{
+		OnFileChanged(Path);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace pk
+{
+	class FileWatcher
+	{
+	public:
+		typedef std::function<void(const std::string&)> OnFileChangedDelegate;
+
+		static const int DEFAULT_POLL_INTERVAL_MS;
+
+		FileWatcher();
+		FileWatcher(const FileWatcher& InWatcher) = delete;
+		void operator=(const FileWatcher& InWatcher) = delete;
+
+		// The delegate runs on the watcher thread, paths are reported as RootPath + relative path.
+		void Start(const std::string& InRootPath, const OnFileChangedDelegate& InDelegate);
+		void Stop();
+		bool IsRunning() const;
+
+		std::string GetRootPath() const;
+
+		~FileWatcher();
+
+	private:
+		void Run();
+		void RunNotify();
+		void RunPolling();
+
+		void Notify(const std::string& Path) const;
+
+		std::string RootPath;
+		OnFileChangedDelegate OnFileChanged;
+
+		std::thread Worker;
+		std::atomic<bool> bRunning;
+	};
+}
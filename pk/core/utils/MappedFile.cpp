@@ -0,0 +1,144 @@
+#include "MappedFile.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <Windows.h>
+#elif __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace pk;
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+MappedFile::MappedFile(const std::string& InPath)
+	: bOpen(false), Data(nullptr), Size(0), FileHandle(INVALID_HANDLE_VALUE), MappingHandle(nullptr)
+{
+	FileHandle = CreateFileA(InPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (FileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	LARGE_INTEGER FileSize;
+	if (!GetFileSizeEx(FileHandle, &FileSize))
+	{
+		Close();
+		return;
+	}
+
+	bOpen = true;
+	Size = static_cast<std::size_t>(FileSize.QuadPart);
+	if (Size <= 0)
+	{
+		return;
+	}
+
+	MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (MappingHandle != nullptr)
+	{
+		Data = static_cast<const char*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+	}
+
+	if (Data == nullptr)
+	{
+		Close();
+	}
+}
+
+void MappedFile::Close()
+{
+	if (Data != nullptr)
+	{
+		UnmapViewOfFile(Data);
+	}
+
+	if (MappingHandle != nullptr)
+	{
+		CloseHandle(MappingHandle);
+	}
+
+	if (FileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(FileHandle);
+	}
+
+	bOpen = false;
+	Data = nullptr;
+	Size = 0;
+	MappingHandle = nullptr;
+	FileHandle = INVALID_HANDLE_VALUE;
+}
+#elif __linux__
+MappedFile::MappedFile(const std::string& InPath)
+	: bOpen(false), Data(nullptr), Size(0), FileHandle(-1)
+{
+	FileHandle = open(InPath.c_str(), O_RDONLY);
+	if (FileHandle < 0)
+	{
+		return;
+	}
+
+	struct stat FileStat;
+	if (fstat(FileHandle, &FileStat) != 0)
+	{
+		Close();
+		return;
+	}
+
+	bOpen = true;
+	Size = static_cast<std::size_t>(FileStat.st_size);
+	if (Size <= 0)
+	{
+		return;
+	}
+
+	void* Mapped = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, FileHandle, 0);
+	if (Mapped == MAP_FAILED)
+	{
+		Close();
+		return;
+	}
+
+	Data = static_cast<const char*>(Mapped);
+}
+
+void MappedFile::Close()
+{
+	if (Data != nullptr)
+	{
+		munmap(const_cast<char*>(Data), Size);
+	}
+
+	if (FileHandle >= 0)
+	{
+		close(FileHandle);
+	}
+
+	bOpen = false;
+	Data = nullptr;
+	Size = 0;
+	FileHandle = -1;
+}
+#endif
+
+bool MappedFile::IsOpen() const
+{
+	return bOpen;
+}
+
+std::string_view MappedFile::GetView() const
+{
+	if (Data == nullptr)
+	{
+		return std::string_view();
+	}
+
+	return std::string_view(Data, Size);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
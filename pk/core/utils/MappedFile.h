@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace pk
+{
+	// Read-only view of a whole file mapped in memory, the content lives as long as the object.
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& InPath);
+
+		MappedFile(const MappedFile& InFile) = delete;
+		void operator=(const MappedFile& InFile) = delete;
+
+		bool IsOpen() const;
+		std::string_view GetView() const;
+
+		~MappedFile();
+
+	private:
+		void Close();
+
+		bool bOpen;
+		const char* Data;
+		std::size_t Size;
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+		void* FileHandle;
+		void* MappingHandle;
+#elif __linux__
+		int FileHandle;
+#endif
+	};
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Delegate.h"
+
+namespace pk
+{
+	enum class PoolGrowth : std::uint8_t
+	{
+		// Acquire fails once every object is live.
+		Fixed,
+		// Capacity doubles once every object is live.
+		Double
+	};
+
+	struct PoolStats
+	{
+		int Capacity;
+		int Live;
+		int HighWater;
+		// Acquire calls that found every object live, whether or not the pool could grow.
+		int Exhausted;
+
+		PoolStats()
+			: Capacity(0), Live(0), HighWater(0), Exhausted(0)
+		{
+		}
+	};
+
+	// Objects are created once by the factory and handed out again after Release,
+	// a free list of slot indices keeps both O(1).
+	template <typename T>
+	class ObjectPool
+	{
+	public:
+		typedef std::shared_ptr<T> SharedPtr;
+		typedef Delegate<SharedPtr(int Index)> FactoryDelegate;
+		typedef Delegate<void(T& Object)> HookDelegate;
+
+		ObjectPool()
+			: Growth(PoolGrowth::Fixed)
+		{
+		}
+
+		ObjectPool(PoolGrowth InGrowth, const FactoryDelegate& InFactory)
+			: Factory(InFactory), Growth(InGrowth)
+		{
+		}
+
+		ObjectPool(const ObjectPool& InPool) = delete;
+		void operator=(const ObjectPool& InPool) = delete;
+
+		void SetFactory(const FactoryDelegate& InFactory)
+		{
+			Factory = InFactory;
+		}
+
+		void SetGrowth(PoolGrowth InGrowth)
+		{
+			Growth = InGrowth;
+		}
+
+		// Called on the object right before Acquire returns it.
+		void SetOnAcquire(const HookDelegate& InHook)
+		{
+			OnAcquire = InHook;
+		}
+
+		// Called on the object as soon as it goes back to the free list.
+		void SetOnRelease(const HookDelegate& InHook)
+		{
+			OnRelease = InHook;
+		}
+
+		// Creates objects up front, only Shrink gives them back.
+		void Reserve(int InCapacity)
+		{
+			if (InCapacity <= GetCapacity() || !Factory)
+			{
+				return;
+			}
+
+			const int OldCapacity = GetCapacity();
+			Objects.reserve(InCapacity);
+			LiveSlots.reserve(InCapacity);
+			FreeSlots.reserve(InCapacity);
+			for (int Index = OldCapacity; Index < InCapacity; ++Index)
+			{
+				Objects.push_back(Factory(Index));
+				LiveSlots.push_back(0);
+			}
+
+			// Lower indices are handed out first.
+			for (int Index = InCapacity - 1; Index >= OldCapacity; --Index)
+			{
+				FreeSlots.push_back(Index);
+			}
+
+			Stats.Capacity = InCapacity;
+		}
+
+		// Drops the objects past InCapacity, fails without touching anything if one of them is still live.
+		bool Shrink(int InCapacity)
+		{
+			InCapacity = std::max(0, InCapacity);
+			for (int Index = InCapacity; Index < GetCapacity(); ++Index)
+			{
+				if (LiveSlots[Index] != 0)
+				{
+					return false;
+				}
+			}
+
+			if (InCapacity >= GetCapacity())
+			{
+				return true;
+			}
+
+			Objects.resize(InCapacity);
+			LiveSlots.resize(InCapacity);
+			FreeSlots.erase(std::remove_if(FreeSlots.begin(), FreeSlots.end(), [InCapacity](int Index) { return Index >= InCapacity; }), FreeSlots.end());
+			Stats.Capacity = InCapacity;
+			return true;
+		}
+
+		SharedPtr Acquire()
+		{
+			int Index;
+			return Acquire(Index);
+		}
+
+		// OutIndex is -1 when the pool is exhausted and can't grow.
+		SharedPtr Acquire(int& OutIndex)
+		{
+			OutIndex = -1;
+			if (FreeSlots.empty())
+			{
+				Stats.Exhausted++;
+				if (Growth == PoolGrowth::Fixed)
+				{
+					return nullptr;
+				}
+
+				Reserve(GetCapacity() > 0 ? GetCapacity() * 2 : 1);
+				if (FreeSlots.empty())
+				{
+					return nullptr;
+				}
+			}
+
+			OutIndex = FreeSlots.back();
+			FreeSlots.pop_back();
+			LiveSlots[OutIndex] = 1;
+
+			Stats.Live++;
+			if (Stats.Live > Stats.HighWater)
+			{
+				Stats.HighWater = Stats.Live;
+			}
+
+			const SharedPtr& Object = Objects[OutIndex];
+			if (OnAcquire)
+			{
+				OnAcquire(*Object);
+			}
+
+			return Object;
+		}
+
+		// Releasing a free slot is a no-op, so owners may release from every "done" path.
+		void Release(int Index)
+		{
+			if (!IsLive(Index))
+			{
+				return;
+			}
+
+			LiveSlots[Index] = 0;
+			FreeSlots.push_back(Index);
+			Stats.Live--;
+
+			if (OnRelease)
+			{
+				OnRelease(*Objects[Index]);
+			}
+		}
+
+		void ReleaseAll()
+		{
+			for (int Index = GetCapacity() - 1; Index >= 0; --Index)
+			{
+				Release(Index);
+			}
+		}
+
+		bool IsLive(int Index) const
+		{
+			return Index >= 0 && Index < GetCapacity() && LiveSlots[Index] != 0;
+		}
+
+		const SharedPtr& Get(int Index) const
+		{
+			return Objects[Index];
+		}
+
+		int GetCapacity() const
+		{
+			return static_cast<int>(Objects.size());
+		}
+
+		int GetLive() const
+		{
+			return Stats.Live;
+		}
+
+		PoolStats GetStats() const
+		{
+			return Stats;
+		}
+
+		template <typename Function>
+		void ForEach(Function&& InFunction) const
+		{
+			for (const SharedPtr& Object : Objects)
+			{
+				InFunction(*Object);
+			}
+		}
+
+		template <typename Function>
+		void ForEachLive(Function&& InFunction) const
+		{
+			for (int Index = 0; Index < GetCapacity(); ++Index)
+			{
+				if (LiveSlots[Index] != 0)
+				{
+					InFunction(*Objects[Index]);
+				}
+			}
+		}
+
+	private:
+		FactoryDelegate Factory;
+		HookDelegate OnAcquire;
+		HookDelegate OnRelease;
+		PoolGrowth Growth;
+
+		std::vector<SharedPtr> Objects;
+		std::vector<std::uint8_t> LiveSlots;
+		std::vector<int> FreeSlots;
+
+		PoolStats Stats;
+	};
+}
@@ -0,0 +1,172 @@
+#include "Profiler.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace pk;
+
+const int Profiler::HISTORY_FRAMES = 600;
+
+Profiler::Profiler()
+	: bEnabled(false), Frame(0), LastGpuFrame(-1), Origin(std::chrono::steady_clock::now()), Totals(HISTORY_FRAMES, FrameTotals{ -1, {} })
+{
+}
+
+void Profiler::SetEnabled(bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+}
+
+bool Profiler::IsEnabled() const
+{
+	return bEnabled;
+}
+
+void Profiler::BeginFrame(int InFrame)
+{
+	Frame = InFrame;
+
+	// Events are appended roughly in frame order, GPU ones trail by a few frames.
+	while (!Events.empty() && Events.front().Frame <= Frame - HISTORY_FRAMES)
+	{
+		Events.pop_front();
+	}
+}
+
+int Profiler::GetFrame() const
+{
+	return Frame;
+}
+
+double Profiler::Now() const
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Origin).count();
+}
+
+void Profiler::AddEvent(const char* Name, ProfileTrack Track, int EventFrame, double Start, double Duration)
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	Events.push_back({ Name, Track, EventFrame, Start, Duration });
+	if (Track == ProfileTrack::Gpu && EventFrame > LastGpuFrame)
+	{
+		LastGpuFrame = EventFrame;
+	}
+
+	if (EventFrame < 0)
+	{
+		return;
+	}
+
+	FrameTotals& Slot = Totals[EventFrame % HISTORY_FRAMES];
+	if (Slot.Frame > EventFrame)
+	{
+		return;
+	}
+
+	if (Slot.Frame != EventFrame)
+	{
+		Slot.Frame = EventFrame;
+		Slot.Entries.clear();
+	}
+
+	for (FrameTotal& Entry : Slot.Entries)
+	{
+		if (Entry.Track == Track && std::strcmp(Entry.Name, Name) == 0)
+		{
+			Entry.Duration += Duration;
+			return;
+		}
+	}
+
+	Slot.Entries.push_back({ Name, Track, Duration });
+}
+
+const Profiler::EventList& Profiler::GetEvents() const
+{
+	return Events;
+}
+
+double Profiler::GetFrameTotal(const char* Name, ProfileTrack Track, int EventFrame) const
+{
+	const FrameTotals* Slot = FindTotals(EventFrame);
+	if (Slot == nullptr)
+	{
+		return -1.0;
+	}
+
+	for (const FrameTotal& Entry : Slot->Entries)
+	{
+		if (Entry.Track == Track && std::strcmp(Entry.Name, Name) == 0)
+		{
+			return Entry.Duration;
+		}
+	}
+
+	return -1.0;
+}
+
+const Profiler::FrameTotals* Profiler::FindTotals(int InFrame) const
+{
+	if (InFrame < 0)
+	{
+		return nullptr;
+	}
+
+	const FrameTotals& Slot = Totals[InFrame % HISTORY_FRAMES];
+	return (Slot.Frame == InFrame) ? &Slot : nullptr;
+}
+
+int Profiler::GetLastGpuFrame() const
+{
+	return LastGpuFrame;
+}
+
+bool Profiler::ExportTrace(const std::string& Path) const
+{
+	std::ofstream File(Path, std::ios::out | std::ios::trunc);
+	if (!File.is_open())
+	{
+		std::cout << "[Profiler] - Unable to write trace to " << Path << "\n";
+		return false;
+	}
+
+	// Complete events in microseconds, one thread per track.
+	File << std::fixed << std::setprecision(3);
+	File << "{\"traceEvents\":[\n";
+	File << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+	File << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+	for (const ProfileEvent& Event : Events)
+	{
+		const bool bGpu = Event.Track == ProfileTrack::Gpu;
+		File << ",\n{\"name\":\"" << Event.Name << "\",\"cat\":\"" << (bGpu ? "gpu" : "cpu") << "\",\"ph\":\"X\""
+			<< ",\"ts\":" << Event.Start * 1000.0 << ",\"dur\":" << Event.Duration * 1000.0
+			<< ",\"pid\":1,\"tid\":" << (bGpu ? 2 : 1) << ",\"args\":{\"frame\":" << Event.Frame << "}}";
+	}
+
+	File << "\n]}\n";
+	return File.good();
+}
+
+ProfileScope::ProfileScope(const char* InName)
+	: Name(InName), Start(0.0), bActive(Profiler::Get().IsEnabled())
+{
+	if (bActive)
+	{
+		Start = Profiler::Get().Now();
+	}
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (bActive)
+	{
+		Profiler& Instance = Profiler::Get();
+		Instance.AddEvent(Name, ProfileTrack::Cpu, Instance.GetFrame(), Start, Instance.Now() - Start);
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace pk
+{
+	enum class ProfileTrack : std::uint8_t
+	{
+		Cpu,
+		Gpu
+	};
+
+	// One timed block, times are in milliseconds since the profiler was created.
+	// Names are string literals, nothing is copied per event.
+	struct ProfileEvent
+	{
+		const char* Name;
+		ProfileTrack Track;
+		int Frame;
+		double Start;
+		double Duration;
+	};
+
+	// Timeline of the last frames, CPU scopes and the GPU timings the renderer reads back a few frames later.
+	// Main thread only. Disabled it records nothing and the renderer issues no queries.
+	class Profiler
+	{
+	public:
+		typedef std::deque<ProfileEvent> EventList;
+
+		// Frames kept in the timeline, older events are dropped as new frames begin.
+		static const int HISTORY_FRAMES;
+
+		static Profiler& Get()
+		{
+			static Profiler Instance;
+			return Instance;
+		}
+
+		Profiler(const Profiler& InProfiler) = delete;
+		void operator=(const Profiler& InProfiler) = delete;
+
+		void SetEnabled(bool bInEnabled);
+		bool IsEnabled() const;
+
+		void BeginFrame(int InFrame);
+		int GetFrame() const;
+		double Now() const;
+
+		// GPU events arrive late, they carry the frame they were measured in rather than the current one.
+		void AddEvent(const char* Name, ProfileTrack Track, int Frame, double Start, double Duration);
+		const EventList& GetEvents() const;
+		// Summed duration of a name over one frame, -1 if nothing was recorded. Kept up to date by AddEvent, no timeline scan.
+		double GetFrameTotal(const char* Name, ProfileTrack Track, int Frame) const;
+		// Newest frame whose GPU timings have been read back, -1 before the first.
+		int GetLastGpuFrame() const;
+
+		// Chrome trace event JSON, opens in chrome://tracing or Perfetto with CPU and GPU on separate rows.
+		bool ExportTrace(const std::string& Path) const;
+
+	private:
+		struct FrameTotal
+		{
+			const char* Name;
+			ProfileTrack Track;
+			double Duration;
+		};
+
+		// Reused ring slot per frame, a handful of distinct names each.
+		struct FrameTotals
+		{
+			int Frame;
+			std::vector<FrameTotal> Entries;
+		};
+
+		Profiler();
+
+		const FrameTotals* FindTotals(int InFrame) const;
+
+		bool bEnabled;
+		int Frame;
+		int LastGpuFrame;
+		std::chrono::steady_clock::time_point Origin;
+		EventList Events;
+		std::vector<FrameTotals> Totals;
+	};
+
+	// Times the enclosing block on the CPU track.
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const char* InName);
+		ProfileScope(const ProfileScope& InScope) = delete;
+		void operator=(const ProfileScope& InScope) = delete;
+		~ProfileScope();
+
+	private:
+		const char* Name;
+		double Start;
+		bool bActive;
+	};
+}
@@ -4,6 +4,7 @@ using namespace pk;
 
 std::random_device Random::Device{};
 std::default_random_engine Random::Engine{ Device()};
+bool Random::bSeeded = false;
 
 float Random::Get(float Min, float Max)
 {
@@ -16,3 +17,26 @@ int Random::Get(int Min, int Max)
 	IntDistribution Distribution(Min, Max);
 	return Distribution(Engine);
 }
+
+float Random::Get(REngine& InEngine, float Min, float Max)
+{
+	FloatDistribution Distribution(Min, Max);
+	return Distribution(InEngine);
+}
+
+int Random::Get(REngine& InEngine, int Min, int Max)
+{
+	IntDistribution Distribution(Min, Max);
+	return Distribution(InEngine);
+}
+
+unsigned int Random::NewSeed()
+{
+	return bSeeded ? static_cast<unsigned int>(Engine()) : Device();
+}
+
+void Random::SetSeed(unsigned int InSeed)
+{
+	Engine.seed(InSeed);
+	bSeeded = true;
+}
@@ -14,8 +14,15 @@ namespace pk
 
 		static float Get(float Min, float Max);
 		static int Get(int Min, int Max);
+		// Same draws from a caller owned engine, so a seeded engine replays the same sequence.
+		static float Get(REngine& InEngine, float Min, float Max);
+		static int Get(REngine& InEngine, int Min, int Max);
+		static unsigned int NewSeed();
+		// Reseeds the shared engine, from then on NewSeed draws from it too so a whole run replays.
+		static void SetSeed(unsigned int InSeed);
 	private:
 		static Seed Device;
 		static REngine Engine;
+		static bool bSeeded;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace pk
+{
+	// Lock-free single producer / single consumer queue, the capacity is rounded up to a power of two.
+	template <typename T>
+	class RingBuffer
+	{
+	public:
+		RingBuffer(std::size_t InCapacity)
+			: Head(0), Tail(0)
+		{
+			std::size_t Capacity = 1;
+			while (Capacity < InCapacity)
+			{
+				Capacity <<= 1;
+			}
+
+			Items.resize(Capacity);
+			Mask = Capacity - 1;
+		}
+
+		RingBuffer(const RingBuffer& InBuffer) = delete;
+		void operator=(const RingBuffer& InBuffer) = delete;
+
+		// Producer side, returns how many items fit.
+		std::size_t Push(const T* InItems, std::size_t Count)
+		{
+			const std::size_t CurrentHead = Head.load(std::memory_order_relaxed);
+			const std::size_t CurrentTail = Tail.load(std::memory_order_acquire);
+			const std::size_t ToPush = std::min(Count, Items.size() - (CurrentHead - CurrentTail));
+			for (std::size_t i = 0; i < ToPush; ++i)
+			{
+				Items[(CurrentHead + i) & Mask] = InItems[i];
+			}
+
+			Head.store(CurrentHead + ToPush, std::memory_order_release);
+			return ToPush;
+		}
+
+		// Consumer side, returns how many items were copied out.
+		std::size_t Pop(T* OutItems, std::size_t Count)
+		{
+			const std::size_t CurrentTail = Tail.load(std::memory_order_relaxed);
+			const std::size_t CurrentHead = Head.load(std::memory_order_acquire);
+			const std::size_t ToPop = std::min(Count, CurrentHead - CurrentTail);
+			for (std::size_t i = 0; i < ToPop; ++i)
+			{
+				OutItems[i] = Items[(CurrentTail + i) & Mask];
+			}
+
+			Tail.store(CurrentTail + ToPop, std::memory_order_release);
+			return ToPop;
+		}
+
+		std::size_t Size() const
+		{
+			return Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire);
+		}
+
+		std::size_t Free() const
+		{
+			return Items.size() - Size();
+		}
+
+		std::size_t Capacity() const
+		{
+			return Items.size();
+		}
+
+	private:
+		std::vector<T> Items;
+		std::size_t Mask;
+
+		alignas(64) std::atomic<std::size_t> Head;
+		alignas(64) std::atomic<std::size_t> Tail;
+	};
+}
@@ -1,5 +1,6 @@
 #include "Emitter.h"
 
+#include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../asset/Shader.h"
@@ -7,19 +8,10 @@
 #include "../asset/AssetManager.h"
 #include "../utils/Common.h"
 #include "../render/Renderer.h"
+#include "GpuParticles.h"
 
 using namespace pk;
 
-void Particle::Set(const glm::vec3& InPosition, const glm::vec3& InDirection, const glm::vec4& InColor, float InLife, float InSpeed, float InOverrideScale)
-{
-	Position = InPosition;
-	Direction = InDirection;
-	Color = InColor;
-	Life = InLife;
-	OverrideScale = InOverrideScale;
-	Speed = InSpeed;
-}
-
 ParticlePattern::Base::Base(bool bInLoop, float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor)
 	: bLoop(bInLoop), SpawnAmount(InSpawnAmount), Speed(InSpeed), Life(InLife), Color(InColor)
 {
@@ -50,214 +42,229 @@ int ParticlePattern::Base::GetSpawnAmount() const
 	return SpawnAmount;
 }
 
-void ParticlePattern::Base::Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position,
-	const glm::vec3& Direction, float OverrideScale)
+ParticlePattern::Linear::Linear(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor)
+	: Base(true, InSpeed, InLife, InSpawnAmount, InColor)
 {
 }
 
-int ParticlePattern::Base::NextInactive(ParticleList& Pool, const int LastInactive)
+const glm::vec3 ParticlePattern::Bounce::COMPASS[NUM_DIRECTIONS] = {
+	glm::vec3(0.f, -1.f, 0.f), // Top
+	glm::vec3(1.f, 0.f, 0.f), // Right
+	glm::vec3(0.f, 1.f, 0.f), // Bottom
+	glm::vec3(-1.f, 0.f, 0.f), // Left
+};
+
+ParticlePattern::Bounce::Bounce(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor)
+	: Base(false, InSpeed, InLife, InSpawnAmount, InColor)
+{
+}
+
+EmitterBase::EmitterBase(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName)
+	: ParticleScale(InParticleScale),
+		PoolCapacity(std::max(1, InPoolCapacity)), OverflowPolicy(ParticleOverflow::StealOldest),
+		ParticleShaderName(std::move(InShaderName)), ParticleTextureName(std::move(InTextureName))
 {
-	for (int i = LastInactive; i < Pool.size(); ++i)
+	Pool.reserve(PoolCapacity);
+	Stats.Capacity = PoolCapacity;
+}
+
+void EmitterBase::Integrate(float Delta, float ColorDecayFactor)
+{
+	if (Gpu != nullptr)
 	{
-		if (Pool[i]->Life <= 0.f)
-		{
-			return i;
-		}
+		Stats.Dropped += Gpu->Simulate(Pool, Delta, ColorDecayFactor);
+		Pool.clear();
+		Stats.Live = Gpu->GetNumLive();
+		Stats.HighWater = std::max(Stats.HighWater, Stats.Live);
+		return;
 	}
 
-	for (int i = 0; i < LastInactive; ++i)
+	int Index = 0;
+	while (Index < static_cast<int>(Pool.size()))
 	{
-		if (Pool[i]->Life <= 0.f)
+		Particle& CurrentParticle = Pool[Index];
+		CurrentParticle.Life -= Delta;
+		if (CurrentParticle.Life <= 0.f)
 		{
-			return i;
+			// The swapped in particle hasn't been updated yet, so the index stays.
+			CurrentParticle = Pool.back();
+			Pool.pop_back();
+			continue;
 		}
+
+		const glm::vec3 Velocity = CurrentParticle.Direction * CurrentParticle.Speed;
+		CurrentParticle.Position += Velocity * Delta;
+		CurrentParticle.Color.a -= ColorDecayFactor * Delta;
+		++Index;
 	}
 
-	return 0;
+	Stats.Live = static_cast<int>(Pool.size());
 }
 
-void ParticlePattern::Base::SpawnParticle(const Particle::SharedPtr& NewParticle, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+void EmitterBase::Render() const
 {
-	if (NewParticle == nullptr)
+	const Shader::SharedPtr Shader = AssetManager::Get().GetShader(ParticleShaderName);
+	const Texture::SharedPtr Texture = AssetManager::Get().GetTexture(ParticleTextureName);
+	if (Gpu != nullptr)
 	{
+		Gpu->Render(Texture, ParticleScale);
 		return;
 	}
 
-	NewParticle->Set(Position, Direction, Color, Life, Speed, OverrideScale);
+	Renderer::Get().RenderParticleVfx(
+		Pool,
+		Shader,
+		Texture,
+		ParticleScale
+	);
 }
 
-ParticlePattern::Linear::Linear(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor)
-	: Base(true, InSpeed, InLife, InSpawnAmount, InColor)
+void EmitterBase::Reset()
 {
-}
+	Pool.clear();
+	Stats.Live = 0;
 
-void ParticlePattern::Linear::Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position,
-	const glm::vec3& Direction, float OverrideScale)
-{
-	for (int i = 0; i < GetSpawnAmount(); ++i)
+	if (Gpu != nullptr)
 	{
-		LastInactive = NextInactive(Pool, LastInactive);
-		SpawnParticle(Pool[LastInactive], Position, Direction, OverrideScale);
+		Gpu->Reset();
 	}
 }
 
-ParticlePattern::Bounce::Bounce(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor)
-	: Base(false, InSpeed, InLife, InSpawnAmount, InColor)
-{
-
-}
-
-void ParticlePattern::Bounce::Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position,
-	const glm::vec3& Direction, float OverrideScale)
+Particle* EmitterBase::StealOldest()
 {
-	const std::vector<glm::vec3> Compass = {
-		glm::vec3(0.f, -1.f, 0.f), // Top
-		glm::vec3(1.f, 0.f, 0.f), // Right
-		glm::vec3(0.f, 1.f, 0.f), // Bottom
-		glm::vec3(-1.f, 0.f, 0.f), // Left
-	};
-
-	float MaxDot = -1.f;
-	int DirectionIndex = 0;
-	const glm::vec3 NormalizedDirection = glm::normalize(Direction);
-	for (int i = 0; i < Compass.size(); ++i)
+	// Only reached on overflow, the usual spawn never scans.
+	Stats.Stolen++;
+	int Oldest = 0;
+	for (int Index = 1; Index < static_cast<int>(Pool.size()); ++Index)
 	{
-		const float CurrentDot = glm::dot(NormalizedDirection, Compass[i]);
-		if (CurrentDot > MaxDot)
+		if (Pool[Index].Life < Pool[Oldest].Life)
 		{
-			MaxDot = CurrentDot;
-			DirectionIndex = i;
+			Oldest = Index;
 		}
 	}
 
-	const glm::vec3 MainDirection = Compass[DirectionIndex];
-	const glm::vec3 ToAdd = (MainDirection.x == 0.f) ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+	return &Pool[Oldest];
+}
 
-	std::vector<glm::vec3> DirectionsToSpawn;
-	DirectionsToSpawn.push_back(MainDirection);
-	DirectionsToSpawn.push_back(MainDirection + ToAdd);
-	DirectionsToSpawn.push_back(MainDirection - ToAdd);
+void EmitterBase::SetParticleScale(float InScale)
+{
+	ParticleScale = InScale;
+}
 
-	const int DirectionsCount = static_cast<int>(DirectionsToSpawn.size());
+float EmitterBase::GetParticleScale() const
+{
+	return ParticleScale;
+}
 
-	for (int i = 0; i < GetSpawnAmount(); ++i)
-	{
-		LastInactive = NextInactive(Pool, LastInactive);
-		SpawnParticle(Pool[LastInactive], Position, DirectionsToSpawn[i % DirectionsCount], OverrideScale);
-	}
+void EmitterBase::SetOverflowPolicy(ParticleOverflow InPolicy)
+{
+	OverflowPolicy = InPolicy;
 }
 
-Emitter::Emitter(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName, ParticlePattern::Base::SharedPtr InParticlePattern)
-	: ParticleScale(InParticleScale),
-		LastInactive(0), PoolCapacity(InPoolCapacity),
-		ParticleShaderName(std::move(InShaderName)), ParticleTextureName(std::move(InTextureName)),
-		ParticlePattern(std::move(InParticlePattern))
+ParticleOverflow EmitterBase::GetOverflowPolicy() const
 {
-	InitializePool();
+	return OverflowPolicy;
 }
 
-void Emitter::Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale)
+int EmitterBase::GetNumLive() const
 {
-	if (!ParticlePattern)
+	if (Gpu != nullptr)
 	{
-		return;
+		return Gpu->GetNumLive();
 	}
 
-	ParticlePattern->Spawn(Pool, LastInactive, Position, Direction, OverrideScale);
+	return static_cast<int>(Pool.size());
 }
 
-void Emitter::Spawn(const glm::vec3& Position, float OverrideScale)
+EmitterStats EmitterBase::GetStats() const
 {
-	Spawn(Position, glm::vec3(0.f), OverrideScale);
+	return Stats;
 }
 
-void Emitter::Spawn(const glm::vec3& Position, const glm::vec3& Direction)
+void EmitterBase::EnableGpuSimulation(int InGpuCapacity, std::string InUpdateShaderName, std::string InRenderShaderName)
 {
-	Spawn(Position, Direction, -1.f);
+	Pool.clear();
+	Gpu = std::make_shared<GpuParticles>(InGpuCapacity, std::move(InUpdateShaderName), std::move(InRenderShaderName));
+	Stats.Live = 0;
+
+	// A frame never queues more than the GPU buffer holds.
+	PoolCapacity = Gpu->GetCapacity();
+	Pool.reserve(PoolCapacity);
+	Stats.Capacity = PoolCapacity;
 }
 
-void Emitter::Spawn(const glm::vec3& Position)
+bool EmitterBase::IsGpuSimulated() const
 {
-	Spawn(Position, glm::vec3(0.f));
+	return Gpu != nullptr;
 }
 
-void Emitter::Update(float Delta, const glm::vec3& Position, const glm::vec3& Direction)
+void EmitterBase::ReadBack(ParticleList& OutParticles) const
 {
-	if (!ParticlePattern)
+	if (Gpu != nullptr)
 	{
+		Gpu->ReadBack(OutParticles);
 		return;
 	}
 
-	if (ParticlePattern->ShouldLoop())
-	{
-		ParticlePattern->Spawn(Pool, LastInactive, Position, Direction, -1.f);
-	}
-
-	const float ColorDecayFactor = 2.f / ParticlePattern->GetLife();
-	for (const Particle::SharedPtr& CurrentParticle : Pool)
-	{
-		CurrentParticle->Life -= Delta;
-		if (CurrentParticle->Life <= 0.f)
-		{
-			continue;
-		}
+	OutParticles = Pool;
+}
 
-		const glm::vec3 Velocity = CurrentParticle->Direction * CurrentParticle->Speed;
-		CurrentParticle->Position += Velocity * Delta;
-		CurrentParticle->Color.a -= ColorDecayFactor * Delta;
-	}
+void AnyEmitter::Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale)
+{
+	Impl->Spawn(Position, Direction, OverrideScale);
 }
 
-void Emitter::Update(float Delta)
+void AnyEmitter::Spawn(const glm::vec3& Position, const glm::vec3& Direction)
 {
-	Update(Delta, glm::vec3(0.f), glm::vec3(0.f));
+	Spawn(Position, Direction, -1.f);
 }
 
-void Emitter::Render() const
+void AnyEmitter::Spawn(const glm::vec3& Position, float OverrideScale)
 {
-	const Shader::SharedPtr Shader = AssetManager::Get().GetShader(ParticleShaderName);
-	const Texture::SharedPtr Texture = AssetManager::Get().GetTexture(ParticleTextureName);
+	Spawn(Position, glm::vec3(0.f), OverrideScale);
+}
 
-	Renderer::Get().RenderParticleVfx(
-		Pool,
-		Shader,
-		Texture,
-		ParticleScale
-	);
+void AnyEmitter::Spawn(const glm::vec3& Position)
+{
+	Spawn(Position, glm::vec3(0.f));
 }
 
-void Emitter::Reset()
+void AnyEmitter::Update(float Delta, const glm::vec3& Position, const glm::vec3& Direction)
 {
-	for (const Particle::SharedPtr& CurrentParticle : Pool)
-	{
-		CurrentParticle->Life = 0.f;
-	}
+	Impl->Update(Delta, Position, Direction);
+}
 
-	LastInactive = 0;
+void AnyEmitter::Update(float Delta)
+{
+	Update(Delta, glm::vec3(0.f), glm::vec3(0.f));
 }
 
-void Emitter::SetParticleScale(float InScale)
+void AnyEmitter::Render() const
 {
-	ParticleScale = InScale;
+	Impl->GetEmitter().Render();
 }
 
-float Emitter::GetParticleScale() const
+void AnyEmitter::Reset()
 {
-	return ParticleScale;
+	Impl->GetEmitter().Reset();
 }
 
-Emitter::~Emitter()
+void AnyEmitter::SetParticleScale(float InScale)
 {
-	Pool.clear();
+	Impl->GetEmitter().SetParticleScale(InScale);
 }
 
-void Emitter::InitializePool()
+float AnyEmitter::GetParticleScale() const
 {
-	Pool.reserve(PoolCapacity);
+	return Impl->GetEmitter().GetParticleScale();
+}
 
-	for (int i = 0; i < PoolCapacity; ++i)
-	{
-		Pool.push_back(std::make_shared<Particle>());
-	}
+void AnyEmitter::SetOverflowPolicy(ParticleOverflow InPolicy)
+{
+	Impl->GetEmitter().SetOverflowPolicy(InPolicy);
 }
 
+EmitterStats AnyEmitter::GetStats() const
+{
+	return Impl->GetEmitter().GetStats();
+}
@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -10,10 +12,11 @@
 
 namespace pk
 {
+	class EmitterBase;
+	class GpuParticles;
+
 	struct Particle
 	{
-		typedef std::shared_ptr<Particle> SharedPtr;
-
 		glm::vec3 Position;
 		glm::vec3 Direction;
 		glm::vec4 Color;
@@ -24,14 +27,37 @@ namespace pk
 		void Set(const glm::vec3& InPosition, const glm::vec3& InDirection, const glm::vec4& InColor, float InLife, float InSpeed, float InOverrideScale);
 	};
 
+	enum class ParticleOverflow : std::uint8_t
+	{
+		// Spawns are dropped while every particle is live.
+		DropNew,
+		// The particle closest to its end is reused.
+		StealOldest,
+		// Capacity doubles.
+		Grow
+	};
+
+	struct EmitterStats
+	{
+		int Capacity;
+		int Live;
+		int HighWater;
+		int Dropped;
+		int Stolen;
+		int Grown;
+
+		EmitterStats()
+			: Capacity(0), Live(0), HighWater(0), Dropped(0), Stolen(0), Grown(0)
+		{
+		}
+	};
+
+	// Patterns are plain policies, Emitter<Pattern> calls Spawn directly so the loop inlines.
 	namespace ParticlePattern
 	{
 		class Base
 		{
 		public:
-			typedef std::shared_ptr<Base> SharedPtr;
-			typedef std::vector<Particle::SharedPtr> ParticleList;
-
 			Base(bool bInLoop, float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
 
 			bool ShouldLoop() const;
@@ -40,13 +66,8 @@ namespace pk
 			float GetLife() const;
 			glm::vec4 GetColor() const;
 
-			virtual void Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale);
-
-			virtual ~Base() = default;
-
 		protected:
-			static int NextInactive(ParticleList& Pool, int LastInactive);
-			void SpawnParticle(const Particle::SharedPtr& NewParticle, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
+			void SpawnParticle(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
 
 		private:
 			bool bLoop;
@@ -60,28 +81,142 @@ namespace pk
 		{
 		public:
 			Linear(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
-			void Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) override;
-
-			~Linear() override = default;
+			void Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
 		};
 
 		class Bounce : public Base
 		{
 		public:
-			Bounce(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
-			void Spawn(ParticleList& Pool, int& LastInactive, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) override;
+			static const int NUM_DIRECTIONS = 4;
+			static const glm::vec3 COMPASS[NUM_DIRECTIONS];
 
-			~Bounce() override = default;
+			Bounce(float InSpeed, float InLife, int InSpawnAmount, const glm::vec4& InColor);
+			void Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const;
 		};
 	}
 
-	class Emitter
+	// Pool shared by every emitter: live particles are packed at the front, a dead one is swapped with the last live one.
+	class EmitterBase
+	{
+	public:
+		typedef std::vector<Particle> ParticleList;
+
+		EmitterBase(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName);
+
+		EmitterBase(const EmitterBase& InEmitter) = delete;
+		void operator=(const EmitterBase& InEmitter) = delete;
+
+		void Render() const;
+		void Reset();
+
+		// Slot for a new particle, nullptr when the overflow policy drops it.
+		Particle* NewParticle();
+
+		void SetParticleScale(float InScale);
+		float GetParticleScale() const;
+
+		// Only applies to CPU simulated emitters, see EnableGpuSimulation.
+		void SetOverflowPolicy(ParticleOverflow InPolicy);
+		ParticleOverflow GetOverflowPolicy() const;
+
+		int GetNumLive() const;
+		EmitterStats GetStats() const;
+
+		// From here on the pool only queues each frame's spawns, moving and drawing them is done on the GPU.
+		// The GPU buffer can't steal or grow, once it is full new spawns are always dropped and counted in Dropped,
+		// a frame late since the count comes back from the GPU.
+		void EnableGpuSimulation(int InGpuCapacity, std::string InUpdateShaderName, std::string InRenderShaderName);
+		bool IsGpuSimulated() const;
+		// Live particles in pool order, read back from the GPU when simulated there.
+		void ReadBack(ParticleList& OutParticles) const;
+
+	protected:
+		~EmitterBase() = default;
+
+		void Integrate(float Delta, float ColorDecayFactor);
+
+	private:
+		Particle* StealOldest();
+
+		float ParticleScale;
+
+		ParticleList Pool;
+		int PoolCapacity;
+		ParticleOverflow OverflowPolicy;
+		EmitterStats Stats;
+
+		std::string ParticleShaderName;
+		std::string ParticleTextureName;
+
+		std::shared_ptr<GpuParticles> Gpu;
+	};
+
+	template <class Pattern>
+	class Emitter : public EmitterBase
 	{
 	public:
 		typedef std::shared_ptr<Emitter> SharedPtr;
-		typedef std::vector<Particle::SharedPtr> ParticleList;
 
-		Emitter(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName, ParticlePattern::Base::SharedPtr InParticlePattern);
+		Emitter(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName, const Pattern& InPattern)
+			: EmitterBase(InPoolCapacity, InParticleScale, std::move(InShaderName), std::move(InTextureName)), mPattern(InPattern)
+		{
+		}
+
+		void Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale)
+		{
+			mPattern.Spawn(*this, Position, Direction, OverrideScale);
+		}
+
+		void Spawn(const glm::vec3& Position, const glm::vec3& Direction)
+		{
+			Spawn(Position, Direction, -1.f);
+		}
+
+		void Spawn(const glm::vec3& Position, float OverrideScale)
+		{
+			Spawn(Position, glm::vec3(0.f), OverrideScale);
+		}
+
+		void Spawn(const glm::vec3& Position)
+		{
+			Spawn(Position, glm::vec3(0.f));
+		}
+
+		void Update(float Delta, const glm::vec3& Position, const glm::vec3& Direction)
+		{
+			if (mPattern.ShouldLoop())
+			{
+				mPattern.Spawn(*this, Position, Direction, -1.f);
+			}
+
+			Integrate(Delta, 2.f / mPattern.GetLife());
+		}
+
+		void Update(float Delta)
+		{
+			Update(Delta, glm::vec3(0.f), glm::vec3(0.f));
+		}
+
+		const Pattern& GetPattern() const
+		{
+			return mPattern;
+		}
+
+	private:
+		Pattern mPattern;
+	};
+
+	// Type erased emitter for patterns picked at runtime, one virtual call per spawn instead of per particle.
+	class AnyEmitter
+	{
+	public:
+		typedef std::shared_ptr<AnyEmitter> SharedPtr;
+
+		template <class Pattern>
+		AnyEmitter(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName, const Pattern& InPattern)
+			: Impl(std::make_unique<Model<Pattern>>(InPoolCapacity, InParticleScale, std::move(InShaderName), std::move(InTextureName), InPattern))
+		{
+		}
 
 		void Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale);
 		void Spawn(const glm::vec3& Position, const glm::vec3& Direction);
@@ -96,21 +231,134 @@ namespace pk
 
 		void SetParticleScale(float InScale);
 		float GetParticleScale() const;
-
-		~Emitter();
+		void SetOverflowPolicy(ParticleOverflow InPolicy);
+		EmitterStats GetStats() const;
 
 	private:
-		void InitializePool();
+		struct Concept
+		{
+			virtual void Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) = 0;
+			virtual void Update(float Delta, const glm::vec3& Position, const glm::vec3& Direction) = 0;
+			virtual EmitterBase& GetEmitter() = 0;
+			virtual const EmitterBase& GetEmitter() const = 0;
+			virtual ~Concept() = default;
+		};
 
-		float ParticleScale;
+		template <class Pattern>
+		struct Model : Concept
+		{
+			Model(int InPoolCapacity, float InParticleScale, std::string InShaderName, std::string InTextureName, const Pattern& InPattern)
+				: Target(InPoolCapacity, InParticleScale, std::move(InShaderName), std::move(InTextureName), InPattern)
+			{
+			}
 
-		ParticleList Pool;
-		int LastInactive;
-		int PoolCapacity;
+			void Spawn(const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) override
+			{
+				Target.Spawn(Position, Direction, OverrideScale);
+			}
 
-		std::string ParticleShaderName;
-		std::string ParticleTextureName;
+			void Update(float Delta, const glm::vec3& Position, const glm::vec3& Direction) override
+			{
+				Target.Update(Delta, Position, Direction);
+			}
 
-		ParticlePattern::Base::SharedPtr ParticlePattern;
+			EmitterBase& GetEmitter() override
+			{
+				return Target;
+			}
+
+			const EmitterBase& GetEmitter() const override
+			{
+				return Target;
+			}
+
+			Emitter<Pattern> Target;
+		};
+
+		std::unique_ptr<Concept> Impl;
 	};
-}
\ No newline at end of file
+
+	inline void Particle::Set(const glm::vec3& InPosition, const glm::vec3& InDirection, const glm::vec4& InColor, float InLife, float InSpeed, float InOverrideScale)
+	{
+		Position = InPosition;
+		Direction = InDirection;
+		Color = InColor;
+		Life = InLife;
+		OverrideScale = InOverrideScale;
+		Speed = InSpeed;
+	}
+
+	inline Particle* EmitterBase::NewParticle()
+	{
+		if (static_cast<int>(Pool.size()) >= PoolCapacity)
+		{
+			if (OverflowPolicy == ParticleOverflow::DropNew || Gpu != nullptr)
+			{
+				Stats.Dropped++;
+				return nullptr;
+			}
+
+			if (OverflowPolicy == ParticleOverflow::StealOldest)
+			{
+				return StealOldest();
+			}
+
+			Stats.Grown++;
+			PoolCapacity *= 2;
+			Pool.reserve(PoolCapacity);
+			Stats.Capacity = PoolCapacity;
+		}
+
+		Pool.emplace_back();
+		Stats.Live = static_cast<int>(Pool.size());
+		Stats.HighWater = std::max(Stats.HighWater, Stats.Live);
+		return &Pool.back();
+	}
+
+	inline void ParticlePattern::Base::SpawnParticle(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+	{
+		Particle* NewParticle = Target.NewParticle();
+		if (NewParticle == nullptr)
+		{
+			return;
+		}
+
+		NewParticle->Set(Position, Direction, Color, Life, Speed, OverrideScale);
+	}
+
+	inline void ParticlePattern::Linear::Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+	{
+		const int Amount = GetSpawnAmount();
+		for (int i = 0; i < Amount; ++i)
+		{
+			SpawnParticle(Target, Position, Direction, OverrideScale);
+		}
+	}
+
+	inline void ParticlePattern::Bounce::Spawn(EmitterBase& Target, const glm::vec3& Position, const glm::vec3& Direction, float OverrideScale) const
+	{
+		int DirectionIndex = 0;
+		float MaxDot = -1.f;
+		const glm::vec3 NormalizedDirection = glm::normalize(Direction);
+		for (int i = 0; i < NUM_DIRECTIONS; ++i)
+		{
+			const float CurrentDot = glm::dot(NormalizedDirection, COMPASS[i]);
+			if (CurrentDot > MaxDot)
+			{
+				MaxDot = CurrentDot;
+				DirectionIndex = i;
+			}
+		}
+
+		// The main direction, then the two diagonals next to it.
+		const glm::vec3& MainDirection = COMPASS[DirectionIndex];
+		const glm::vec3 ToAdd = (MainDirection.x == 0.f) ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+		const int Amount = GetSpawnAmount();
+		for (int i = 0; i < Amount; ++i)
+		{
+			const int Side = i % 3;
+			const glm::vec3 SpawnDirection = Side == 0 ? MainDirection : (Side == 1 ? MainDirection + ToAdd : MainDirection - ToAdd);
+			SpawnParticle(Target, Position, SpawnDirection, OverrideScale);
+		}
+	}
+}
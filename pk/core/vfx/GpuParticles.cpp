@@ -0,0 +1,269 @@
+#include "GpuParticles.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <glad/glad.h>
+
+#include "Emitter.h"
+#include "../asset/AssetManager.h"
+#include "../render/Renderer.h"
+
+using namespace pk;
+
+static_assert(sizeof(Particle) == 13 * sizeof(float), "Particle is uploaded as is, it can't have padding");
+
+const std::vector<std::string> GpuParticles::FEEDBACK_VARYINGS = {
+	"outPosition",
+	"outDirection",
+	"outColor",
+	"outLife",
+	"outSpeed",
+	"outScale"
+};
+
+GpuParticles::GpuParticles(int InCapacity, std::string InUpdateShaderName, std::string InRenderShaderName)
+	: Capacity(std::max(1, InCapacity)), EmitCapacity(0), Current(0), bHasState(false), Drawn(0), NextQuery(0),
+		bCountPending{}, NumLive(0), NumNewDropped(0),
+		Buffers{ 0, 0 }, VertexArrays{ 0, 0 }, DeadBuffer(0), CountQueries{}, GeneratedQueries{}, EmitBuffer(0), EmitVertexArray(0),
+		UpdateShaderName(std::move(InUpdateShaderName)), RenderShaderName(std::move(InRenderShaderName))
+{
+}
+
+int GpuParticles::Simulate(const std::vector<Particle>& Emitted, float Delta, float ColorDecayFactor)
+{
+	const Shader::SharedPtr UpdateShader = AssetManager::Get().GetShader(UpdateShaderName);
+	if (UpdateShader == nullptr)
+	{
+		return 0;
+	}
+
+	// Created on first use, owners may be built before the GL context.
+	if (Buffers[0] == 0)
+	{
+		Initialize();
+	}
+
+	const int NumEmitted = static_cast<int>(Emitted.size());
+	if (NumEmitted > 0)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, EmitBuffer);
+		if (NumEmitted > EmitCapacity)
+		{
+			EmitCapacity = NumEmitted;
+			glBufferData(GL_ARRAY_BUFFER, EmitCapacity * sizeof(Particle), Emitted.data(), GL_STREAM_DRAW);
+		}
+		else
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, 0, NumEmitted * sizeof(Particle), Emitted.data());
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	PollCounts();
+
+	// Whatever the update does not write stays dead, so the next one can read the whole buffer without a count.
+	const int Source = Current;
+	const int Target = 1 - Current;
+	glBindBuffer(GL_COPY_READ_BUFFER, DeadBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, Buffers[Target]);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, Capacity * sizeof(Particle));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// A GPU more than NUM_QUERIES updates behind leaves this one uncounted rather than stalling.
+	const int Query = NextQuery;
+	const bool bCounted = !bCountPending[Query];
+
+	Renderer::Get().UseShader(UpdateShader);
+	UpdateShader->SetFloat("delta", Delta);
+	UpdateShader->SetFloat("colorDecay", ColorDecayFactor);
+
+	glEnable(GL_RASTERIZER_DISCARD);
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, Buffers[Target]);
+	if (bCounted)
+	{
+		glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, CountQueries[Query]);
+		glBeginQuery(GL_PRIMITIVES_GENERATED, GeneratedQueries[Query]);
+	}
+
+	glBeginTransformFeedback(GL_POINTS);
+
+	if (bHasState)
+	{
+		glBindVertexArray(VertexArrays[Source]);
+		glDrawArrays(GL_POINTS, 0, Capacity);
+	}
+
+	// Particles past the end of the target buffer are not written, a full pool drops new spawns.
+	if (NumEmitted > 0)
+	{
+		glBindVertexArray(EmitVertexArray);
+		glDrawArrays(GL_POINTS, 0, NumEmitted);
+	}
+
+	glEndTransformFeedback();
+	if (bCounted)
+	{
+		glEndQuery(GL_PRIMITIVES_GENERATED);
+		glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+		bCountPending[Query] = true;
+		NextQuery = (NextQuery + 1) % NUM_QUERIES;
+	}
+
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+	glDisable(GL_RASTERIZER_DISCARD);
+	glBindVertexArray(0);
+
+	Drawn = Source;
+	Current = Target;
+	bHasState = true;
+
+	const int NumDropped = NumNewDropped;
+	NumNewDropped = 0;
+	return NumDropped;
+}
+
+void GpuParticles::Render(const TexturePtr& InTexture, float Scale) const
+{
+	if (!bHasState)
+	{
+		return;
+	}
+
+	const Shader::SharedPtr RenderShader = AssetManager::Get().GetShader(RenderShaderName);
+	Renderer::Get().RenderParticleFeedback(RenderShader, InTexture, VertexArrays[Drawn], Capacity, Scale);
+}
+
+void GpuParticles::Reset()
+{
+	bHasState = false;
+	// Results still in flight belong to the old state, they are never read.
+	std::fill(bCountPending, bCountPending + NUM_QUERIES, false);
+	NumLive = 0;
+	NumNewDropped = 0;
+}
+
+int GpuParticles::GetCapacity() const
+{
+	return Capacity;
+}
+
+int GpuParticles::GetNumLive() const
+{
+	PollCounts();
+	return NumLive;
+}
+
+void GpuParticles::ReadBack(std::vector<Particle>& OutParticles) const
+{
+	OutParticles.clear();
+	if (!bHasState)
+	{
+		return;
+	}
+
+	// Live particles are packed at the start, the first dead one ends them.
+	OutParticles.resize(Capacity);
+	glBindBuffer(GL_ARRAY_BUFFER, Buffers[Current]);
+	glGetBufferSubData(GL_ARRAY_BUFFER, 0, Capacity * sizeof(Particle), OutParticles.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	const auto FirstDead = std::find_if(OutParticles.begin(), OutParticles.end(), [](const Particle& Candidate) { return Candidate.Life <= 0.f; });
+	OutParticles.erase(FirstDead, OutParticles.end());
+}
+
+GpuParticles::~GpuParticles()
+{
+	if (Buffers[0] == 0)
+	{
+		return;
+	}
+
+	glDeleteQueries(NUM_QUERIES, CountQueries);
+	glDeleteQueries(NUM_QUERIES, GeneratedQueries);
+	glDeleteVertexArrays(2, VertexArrays);
+	glDeleteVertexArrays(1, &EmitVertexArray);
+	glDeleteBuffers(2, Buffers);
+	glDeleteBuffers(1, &DeadBuffer);
+	glDeleteBuffers(1, &EmitBuffer);
+}
+
+void GpuParticles::Initialize()
+{
+	glGenBuffers(2, Buffers);
+	glGenVertexArrays(2, VertexArrays);
+	glGenBuffers(1, &EmitBuffer);
+	glGenVertexArrays(1, &EmitVertexArray);
+	glGenBuffers(1, &DeadBuffer);
+	glGenQueries(NUM_QUERIES, CountQueries);
+	glGenQueries(NUM_QUERIES, GeneratedQueries);
+
+	Particle Dead;
+	Dead.Set(glm::vec3(0.f), glm::vec3(0.f), glm::vec4(0.f), -1.f, 0.f, -1.f);
+	const std::vector<Particle> DeadParticles(Capacity, Dead);
+	glBindBuffer(GL_ARRAY_BUFFER, DeadBuffer);
+	glBufferData(GL_ARRAY_BUFFER, Capacity * sizeof(Particle), DeadParticles.data(), GL_STATIC_COPY);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, Buffers[i]);
+		glBufferData(GL_ARRAY_BUFFER, Capacity * sizeof(Particle), DeadParticles.data(), GL_DYNAMIC_COPY);
+
+		glBindVertexArray(VertexArrays[i]);
+		BindAttributes(Buffers[i]);
+	}
+
+	EmitCapacity = Capacity;
+	glBindBuffer(GL_ARRAY_BUFFER, EmitBuffer);
+	glBufferData(GL_ARRAY_BUFFER, EmitCapacity * sizeof(Particle), nullptr, GL_STREAM_DRAW);
+	glBindVertexArray(EmitVertexArray);
+	BindAttributes(EmitBuffer);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GpuParticles::BindAttributes(unsigned int Buffer) const
+{
+	const GLsizei Stride = sizeof(Particle);
+	glBindBuffer(GL_ARRAY_BUFFER, Buffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, Position));
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, Direction));
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, Color));
+	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, Life));
+	glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, Speed));
+	glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, Stride, (void*)offsetof(Particle, OverrideScale));
+	for (unsigned int Attribute = 0; Attribute < 6; ++Attribute)
+	{
+		glEnableVertexAttribArray(Attribute);
+	}
+}
+
+void GpuParticles::PollCounts() const
+{
+	for (int i = 0; i < NUM_QUERIES; ++i)
+	{
+		const int Index = (NextQuery + i) % NUM_QUERIES;
+		if (!bCountPending[Index])
+		{
+			continue;
+		}
+
+		GLuint bAvailable = GL_FALSE;
+		glGetQueryObjectuiv(CountQueries[Index], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		// Queries finish in order, the newer ones can't be ready either.
+		if (bAvailable == GL_FALSE)
+		{
+			return;
+		}
+
+		// Both queries ended together, the written one being available means the other is too.
+		GLuint Written = 0, Generated = 0;
+		glGetQueryObjectuiv(CountQueries[Index], GL_QUERY_RESULT, &Written);
+		glGetQueryObjectuiv(GeneratedQueries[Index], GL_QUERY_RESULT, &Generated);
+		NumLive = static_cast<int>(Written);
+		NumNewDropped += static_cast<int>(Generated - std::min(Generated, Written));
+		bCountPending[Index] = false;
+	}
+}
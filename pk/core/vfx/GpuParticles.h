@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pk
+{
+	struct Particle;
+	class Texture;
+
+	// Particle state lives in two buffers, each frame transform feedback reads one and writes the other.
+	// Only GL 3.3 is used and the CPU never waits on the GPU: the target is first overwritten with dead particles
+	// on the GPU, the update packs the live ones at its start, and both the update and the draw go over the whole
+	// capacity with the geometry shaders skipping the dead. Counts come from queries polled a few frames later.
+	// Drawing shows the state the last update started from, so the frame being recorded never waits on its own update.
+	class GpuParticles
+	{
+	public:
+		typedef std::shared_ptr<Texture> TexturePtr;
+
+		// Outputs of the update program, in the same order as the fields of Particle.
+		static const std::vector<std::string> FEEDBACK_VARYINGS;
+
+		GpuParticles(int InCapacity, std::string InUpdateShaderName, std::string InRenderShaderName);
+
+		GpuParticles(const GpuParticles& InParticles) = delete;
+		void operator=(const GpuParticles& InParticles) = delete;
+
+		// Advances the live particles and appends the emitted ones, all on the GPU.
+		// Emitted particles that don't fit in the buffer are dropped, returns how many earlier updates dropped,
+		// found since the last call.
+		int Simulate(const std::vector<Particle>& Emitted, float Delta, float ColorDecayFactor);
+		void Render(const TexturePtr& InTexture, float Scale) const;
+		void Reset();
+
+		int GetCapacity() const;
+		// Count from the newest update the GPU has finished, reading it never stalls.
+		int GetNumLive() const;
+		// Waits for the GPU, meant for validation only.
+		void ReadBack(std::vector<Particle>& OutParticles) const;
+
+		~GpuParticles();
+
+	private:
+		void Initialize();
+		void BindAttributes(unsigned int Buffer) const;
+		// Collects the query results the GPU has finished, oldest first, without waiting.
+		void PollCounts() const;
+
+		// Updates whose counts can be in flight at once.
+		static const int NUM_QUERIES = 4;
+
+		int Capacity;
+		int EmitCapacity;
+		// Buffer the last update wrote.
+		int Current;
+		bool bHasState;
+		// Buffer the last update read, which is what gets drawn.
+		int Drawn;
+		int NextQuery;
+		mutable bool bCountPending[NUM_QUERIES];
+		mutable int NumLive;
+		mutable int NumNewDropped;
+
+		unsigned int Buffers[2];
+		unsigned int VertexArrays[2];
+		// Capacity dead particles, copied over the target before each update.
+		unsigned int DeadBuffer;
+		unsigned int CountQueries[NUM_QUERIES];
+		// Points the update emitted whether or not they fit, the difference with the count is what was dropped.
+		unsigned int GeneratedQueries[NUM_QUERIES];
+		unsigned int EmitBuffer;
+		unsigned int EmitVertexArray;
+
+		std::string UpdateShaderName;
+		std::string RenderShaderName;
+	};
+}
@@ -8,19 +8,27 @@
 using namespace pk;
 
 Window::Window(const int InWidth, const int InHeight, std::string InTitle)
-	: Width(InWidth), Height(InHeight), Title(std::move(InTitle)), WindowPtr(nullptr)
+	: Window(InWidth, InHeight, std::move(InTitle), true)
+{
+}
+
+Window::Window(const int InWidth, const int InHeight, std::string InTitle, bool bInVisible)
+	: Width(InWidth), Height(InHeight), FramebufferWidth(InWidth), FramebufferHeight(InHeight), Title(std::move(InTitle)), bVisible(bInVisible), WindowPtr(nullptr)
 {
     Initialize();
 }
 
 void Window::Initialize()
 {
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // OpenGL major version 3
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3); // OpenGL minor version 3
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // OpenGL Core profile
+    GLFWwindow* window = bVisible ? nullptr : CreateSurfacelessWindow();
+    if (window == nullptr)
+    {
+        glfwInit();
+        SetContextHints();
+        glfwWindowHint(GLFW_VISIBLE, bVisible ? GLFW_TRUE : GLFW_FALSE);
+        window = glfwCreateWindow(Width, Height, Title.c_str(), nullptr, nullptr);
+    }
 
-    GLFWwindow* window = glfwCreateWindow(Width, Height, Title.c_str(), nullptr, nullptr);
     if (window == nullptr)
     {
         throw Error("Failed to create GLFW window");
@@ -34,6 +42,7 @@ void Window::Initialize()
         throw Error("Failed to initialize GLAD");
     }
 
+    glfwGetFramebufferSize(WindowPtr, &FramebufferWidth, &FramebufferHeight);
     glfwSetWindowUserPointer(WindowPtr, this);
     glfwSetFramebufferSizeCallback(WindowPtr, [](GLFWwindow* InWindow, int InWidth, int InHeight)
 	    {
@@ -60,6 +69,16 @@ int Window::GetHeight() const
 	return Height;
 }
 
+int Window::GetFramebufferWidth() const
+{
+    return FramebufferWidth;
+}
+
+int Window::GetFramebufferHeight() const
+{
+    return FramebufferHeight;
+}
+
 glm::vec2 Window::GetScreenCenter() const
 {
     return {Width / 2, Height / 2};
@@ -75,6 +94,11 @@ GLFWwindow* Window::GetWindow() const
     return WindowPtr;
 }
 
+bool Window::IsVisible() const
+{
+    return bVisible;
+}
+
 void Window::Maximize() const
 {
     glfwMaximizeWindow(WindowPtr);
@@ -92,7 +116,12 @@ int Window::ShouldClose() const
 
 void Window::CloseFrame() const
 {
-    glfwSwapBuffers(WindowPtr);
+    // Nothing is presented from a hidden window, skipping the swap also skips waiting on vsync.
+    if (bVisible)
+    {
+        glfwSwapBuffers(WindowPtr);
+    }
+
     glfwPollEvents();
 }
 
@@ -150,9 +179,43 @@ Window::~Window()
     glfwTerminate();
 }
 
+void Window::SetContextHints() const
+{
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // OpenGL major version 3
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3); // OpenGL minor version 3
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // OpenGL Core profile
+}
+
+GLFWwindow* Window::CreateSurfacelessWindow() const
+{
+#ifdef GLFW_PLATFORM_NULL
+    // No display needed at all, e.g. a build machine rendering through Mesa's EGL.
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (glfwInit())
+    {
+        SetContextHints();
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        GLFWwindow* window = glfwCreateWindow(Width, Height, Title.c_str(), nullptr, nullptr);
+        if (window != nullptr)
+        {
+            return window;
+        }
+
+        glfwTerminate();
+    }
+
+    std::cout << "[Window] - No surfaceless context, falling back to a hidden window\n";
+    glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+    glfwDefaultWindowHints();
+#endif
+    return nullptr;
+}
+
 void Window::FrameBufferSizeCallback(GLFWwindow* InWindow, int InWidth, int InHeight)
 {
-    glad_glViewport(0, 0, InWidth, InHeight);
+    // The scene sets its viewport every frame from these, nothing on the GL side has to follow.
+    FramebufferWidth = InWidth;
+    FramebufferHeight = InHeight;
 }
 
 void Window::OnCloseCallback(GLFWwindow* InWindow)
@@ -19,6 +19,8 @@ namespace pk
 		typedef std::function<void()> OnCloseDelegate;
 
 		Window(const int InWidth, const int InHeight, std::string InTitle);
+		// A hidden window never shows up nor swaps, it only carries the GL context for offscreen rendering.
+		Window(const int InWidth, const int InHeight, std::string InTitle, bool bInVisible);
 		Window(const Window&) = delete;
 		Window(const Window&&) = delete;
 		void operator=(const Window&) = delete;
@@ -26,11 +28,16 @@ namespace pk
 
 		void Initialize();
 
+		// Size the game is laid out in, fixed at creation whatever the window is resized to.
 		int GetWidth() const;
 		int GetHeight() const;
+		// Pixels actually backing the window, follows resizes and high dpi scaling.
+		int GetFramebufferWidth() const;
+		int GetFramebufferHeight() const;
 		glm::vec2 GetScreenCenter() const;
 		std::string GetTitle() const;
 		GLFWwindow* GetWindow() const;
+		bool IsVisible() const;
 
 		void Maximize() const;
 		void ShouldClose(int Value) const;
@@ -58,12 +65,18 @@ namespace pk
 		};
 
 	private:
+		void SetContextHints() const;
+		GLFWwindow* CreateSurfacelessWindow() const;
+
 		void FrameBufferSizeCallback(GLFWwindow* InWindow, int InWidth, int InHeight);
 		void OnCloseCallback(GLFWwindow* InWindow);
 
 		int Width;
 		int Height;
+		int FramebufferWidth;
+		int FramebufferHeight;
 		std::string Title;
+		bool bVisible;
 
 		GLFWwindow* WindowPtr;
 
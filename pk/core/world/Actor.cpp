@@ -1,6 +1,7 @@
 #include "Actor.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
 
 #include "../asset/AssetManager.h"
 #include "Component.h"
@@ -10,7 +11,12 @@
 using namespace pk;
 
 Actor::Actor()
-	: Id(-1), InitialLifeSpan(0.f), LifeSpan(0.f), Velocity(0.f), Color(Colors::Black), bPendingDestroy(false), bHasCollision(false) {}
+	: Id(-1), bHasBegun(false), ReloadGeneration(0), InitialLifeSpan(0.f), Velocity(0.f), Color(Colors::Black), Layer(RenderLayer::Actors), LayerSlot(-1), bPendingDestroy(false), bHasCollision(false), bCollisionVolume(false),
+		bInViewport(true), bDestroyOffscreen(false), TypeTags(0)
+{
+	ComponentSlots.fill(nullptr);
+	AddTypeTag<Actor>();
+}
 
 Actor::Actor(const Transform& InTransform)
 	: Actor()
@@ -103,6 +109,28 @@ glm::vec4 Actor::GetColor() const
 	return Color;
 }
 
+void Actor::SetRenderLayer(RenderLayer InLayer)
+{
+	if (Layer == InLayer)
+	{
+		return;
+	}
+
+	const RenderLayer OldLayer = Layer;
+	Layer = InLayer;
+
+	const SceneSharedPtr CurrentScene = LayerSlot >= 0 ? GetScene() : nullptr;
+	if (CurrentScene != nullptr)
+	{
+		CurrentScene->MoveToLayer(*this, OldLayer);
+	}
+}
+
+RenderLayer Actor::GetRenderLayer() const
+{
+	return Layer;
+}
+
 float Actor::GetInitialLifeSpan() const
 {
 	return InitialLifeSpan;
@@ -111,11 +139,21 @@ float Actor::GetInitialLifeSpan() const
 void Actor::SetInitialLifeSpan(float InLifeSpan)
 {
 	InitialLifeSpan = std::max(0.f, InLifeSpan);
+	if (Id >= 0)
+	{
+		StartLifeSpan();
+	}
 }
 
 float Actor::GetLifeSpan() const
 {
-	return LifeSpan;
+	const SceneSharedPtr CurrentScene = GetScene();
+	if (CurrentScene == nullptr || !CurrentScene->IsTimerActive(LifeSpanTimer))
+	{
+		return 0.f;
+	}
+
+	return InitialLifeSpan - CurrentScene->GetTimerRemaining(LifeSpanTimer);
 }
 
 void Actor::SetConfig(const std::string& InConfigFile)
@@ -138,32 +176,98 @@ bool Actor::HasCollision() const
 	return bHasCollision;
 }
 
+void Actor::SetCollisionVolume(bool bInVolume)
+{
+	bCollisionVolume = bInVolume;
+}
+
+bool Actor::IsCollisionVolume() const
+{
+	return bCollisionVolume;
+}
+
 void Actor::OnActorHit(const SharedPtr& HitActor, const CollisionResult& Result)
 {
 }
 
+IDamageable* Actor::AsDamageable()
+{
+	return nullptr;
+}
+
 void Actor::Move(const float Delta)
 {
 	mTransform.Location += Velocity * Delta;
 }
 
-void Actor::UpdateLifeSpan(const float Delta)
+void Actor::OnActivate()
+{
+}
+
+void Actor::OnDeactivate()
+{
+}
+
+TimerHandle Actor::SetTimer(float Delay, const TimerWheel::TimerCallback& Callback)
+{
+	const SceneSharedPtr CurrentScene = GetScene();
+	if (CurrentScene == nullptr)
+	{
+		return TimerHandle();
+	}
+
+	return CurrentScene->SetTimer(Delay, weak_from_this(), Callback);
+}
+
+void Actor::ClearTimer(TimerHandle& Handle) const
 {
+	const SceneSharedPtr CurrentScene = GetScene();
+	if (CurrentScene != nullptr)
+	{
+		CurrentScene->ClearTimer(Handle);
+	}
+
+	Handle.Invalidate();
+}
+
+bool Actor::IsTimerActive(const TimerHandle& Handle) const
+{
+	const SceneSharedPtr CurrentScene = GetScene();
+	return CurrentScene != nullptr && CurrentScene->IsTimerActive(Handle);
+}
+
+void Actor::StartLifeSpan()
+{
+	ClearTimer(LifeSpanTimer);
 	if (InitialLifeSpan <= 0.f)
 	{
 		return;
 	}
 
-	LifeSpan += Delta;
-	if (LifeSpan >= InitialLifeSpan)
+	LifeSpanTimer = SetTimer(InitialLifeSpan, [this]() { Destroy(); });
+}
+
+void Actor::AddComponent(const ComponentSharedPtr& InComponent, std::uint32_t TypeIndex)
+{
+	if (TypeIndex >= MAX_COMPONENT_TYPES)
 	{
-		Destroy();
+		std::cout << "[Actor] - Too many component types, raise MAX_COMPONENT_TYPES.\n";
+		return;
 	}
+
+	Components.push_back(InComponent);
+	ComponentSlots[TypeIndex] = InComponent.get();
 }
 
-void Actor::AddComponent(const ComponentSharedPtr& InComponent)
+void Actor::AddTypeTag(std::uint32_t Tag)
 {
-	Components.push_back(InComponent);
+	if (Tag >= MAX_TYPE_TAGS)
+	{
+		std::cout << "[Actor] - Too many actor types, raise MAX_TYPE_TAGS.\n";
+		return;
+	}
+
+	TypeTags |= (1ull << Tag);
 }
 
 void Actor::BeginComponents() const
@@ -243,6 +347,11 @@ void Actor::LoadConfig()
 {
 }
 
+void Actor::OnConfigReloaded()
+{
+	LoadConfig();
+}
+
 void Actor::Begin()
 {
 	LoadConfig();
@@ -252,7 +361,6 @@ void Actor::Begin()
 void Actor::Update(const float Delta)
 {
 	Move(Delta);
-	UpdateLifeSpan(Delta);
 	UpdateComponents(Delta);
 }
 
@@ -295,34 +403,15 @@ void Actor::CancelDestroy()
 
 bool Actor::IsInViewport() const
 {
-	const SceneSharedPtr CurrentScene = GetScene();
-	if (CurrentScene == nullptr)
-	{
-		return false;
-	}
-
-	const Window::SharedPtr CurrentWindow = CurrentScene->GetWindow();
-	if (CurrentWindow == nullptr)
-	{
-		return false;
-	}
-
-	const glm::vec3 Location = GetLocation();
-	const glm::vec2 SizeOffset = GetBoundingBox().ScaleOffset;
-	const float WindowWidth = static_cast<float>(CurrentWindow->GetWidth());
-	const float WindowHeight = static_cast<float>(CurrentWindow->GetHeight());
-
-	if (Location.x + SizeOffset.x <= 0.f 
-		|| Location.x - SizeOffset.x >= WindowWidth)
-	{
-		return false;
-	}
+	return bInViewport;
+}
 
-	if (Location.y + SizeOffset.y <= 0.f || 
-		Location.y - SizeOffset.y >= WindowHeight)
-	{
-		return false;
-	}
+void Actor::SetDestroyOffscreen(bool bInDestroyOffscreen)
+{
+	bDestroyOffscreen = bInDestroyOffscreen;
+}
 
-	return true;
+bool Actor::IsDestroyOffscreen() const
+{
+	return bDestroyOffscreen;
 }
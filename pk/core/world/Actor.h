@@ -1,11 +1,16 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "../render/RenderLayer.h"
 #include "../utils/Common.h"
+#include "TimerWheel.h"
+#include "TypeId.h"
 
 namespace pk
 {
@@ -13,6 +18,7 @@ namespace pk
 	class Window;
 	class Component;
 	class InputHandler;
+	class IDamageable;
 
 	class Actor : public std::enable_shared_from_this<Actor>
 	{
@@ -23,6 +29,9 @@ namespace pk
 		typedef std::shared_ptr<Component> ComponentSharedPtr;
 		typedef std::vector<ComponentSharedPtr> ComponentList;
 
+		static const std::uint32_t MAX_COMPONENT_TYPES = 8;
+		static const std::uint32_t MAX_TYPE_TAGS = 64;
+
 		Actor();
 		Actor(const Transform& InTransform);
 		Actor(const glm::vec3& InLocation, const glm::vec3 InSize);
@@ -52,6 +61,10 @@ namespace pk
 		void SetColor(const glm::vec4& InColor);
 		glm::vec4 GetColor() const;
 
+		// The scene keeps one bucket per layer, changing it moves the actor right away.
+		void SetRenderLayer(RenderLayer InLayer);
+		RenderLayer GetRenderLayer() const;
+
 		float GetInitialLifeSpan() const;
 		void SetInitialLifeSpan(float InLifeSpan);
 		float GetLifeSpan() const;
@@ -61,16 +74,21 @@ namespace pk
 
 		void HasCollision(bool bInCollision);
 		bool HasCollision() const;
+		// Volumes are too big for the point quad tree, they are tested against every colliding actor.
+		void SetCollisionVolume(bool bInVolume);
+		bool IsCollisionVolume() const;
 		virtual void OnActorHit(const SharedPtr& HitActor, const CollisionResult& Result);
+		virtual IDamageable* AsDamageable();
 
 		glm::mat4 GetRenderModel() const;
 		BoundingBox GetBoundingBox() const;
 		void BindTexture() const;
 		void UnBindTexture() const;
 
-		bool Collide(const Actor& Other, CollisionResult& OutResult) const;
+		virtual bool Collide(const Actor& Other, CollisionResult& OutResult) const;
 
 		virtual void LoadConfig();
+		virtual void OnConfigReloaded();
 		virtual void Begin();
 		virtual void Update(const float Delta);
 		virtual void Input(const InputHandler& Handler, const float Delta);
@@ -78,35 +96,60 @@ namespace pk
 
 		ComponentList GetComponents() const;
 
+		// Exact type lookup, components are not found through their base classes.
 		template<class T>
-		std::shared_ptr<T> GetComponent() const;
+		T* GetComponent() const;
+
+		template<class T>
+		bool HasComponent() const;
 
 		bool IsDestroyed() const;
 		virtual void Destroy();
 		void CancelDestroy();
 
+		// As of the scene's last cull pass, which runs every frame between Update and Render.
 		bool IsInViewport() const;
+		// The cull pass destroys the actor the frame it is found fully outside the view.
+		void SetDestroyOffscreen(bool bInDestroyOffscreen);
+		bool IsDestroyOffscreen() const;
 
+		// True for every class in the hierarchy that called AddTypeTag in its constructor.
 		template<class Dest>
-		bool IsA()
+		bool IsA() const
 		{
-			const Dest* ObjDest = dynamic_cast<Dest*>(this);
-			return ObjDest != nullptr;
+			const std::uint32_t Tag = TypeId<Actor>::Get<Dest>();
+			return Tag < MAX_TYPE_TAGS && (TypeTags & (1ull << Tag)) != 0;
 		}
 
 		virtual ~Actor() = default;
 
 	protected:
 		void Move(const float Delta);
-		void UpdateLifeSpan(const float Delta);
-		void AddComponent(const ComponentSharedPtr& InComponent);
+		// Run every time the actor joins or leaves the scene's live set, Begin only runs on Add.
+		virtual void OnActivate();
+		virtual void OnDeactivate();
+		// The callback is dropped if the actor is gone by the time the timer fires.
+		TimerHandle SetTimer(float Delay, const TimerWheel::TimerCallback& Callback);
+		void ClearTimer(TimerHandle& Handle) const;
+		bool IsTimerActive(const TimerHandle& Handle) const;
+		template<class T>
+		void AddComponent(const std::shared_ptr<T>& InComponent);
+
+		template<class T>
+		void AddTypeTag();
 		void BeginComponents() const;
 		void UpdateComponents(const float Delta) const;
 
 	private:
+		void StartLifeSpan();
+		void AddComponent(const ComponentSharedPtr& InComponent, std::uint32_t TypeIndex);
+		void AddTypeTag(std::uint32_t Tag);
+
 		int Id;
+		bool bHasBegun;
+		int ReloadGeneration;
 		float InitialLifeSpan;
-		float LifeSpan;
+		TimerHandle LifeSpanTimer;
 
 		Transform mTransform;
 		glm::vec3 Velocity;
@@ -114,31 +157,54 @@ namespace pk
 		std::string ShaderName;
 		std::string TextureName;
 		glm::vec4 Color;
+		RenderLayer Layer;
+		// Position in the scene's bucket for its layer, -1 while not in a scene.
+		int LayerSlot;
 
 		bool bPendingDestroy;
 		bool bHasCollision;
+		bool bCollisionVolume;
+		bool bInViewport;
+		bool bDestroyOffscreen;
 
 		std::string ConfigFile;
 
 		SceneWeakPtr ScenePtr;
 
 		ComponentList Components;
+		std::array<Component*, MAX_COMPONENT_TYPES> ComponentSlots;
+		std::uint64_t TypeTags;
 
 		friend class Scene;
 	};
 
 	template <class T>
-	std::shared_ptr<T> Actor::GetComponent() const
+	T* Actor::GetComponent() const
 	{
-		for (const ComponentSharedPtr& CurrentComponent : Components)
+		const std::uint32_t TypeIndex = TypeId<Component>::Get<T>();
+		if (TypeIndex >= MAX_COMPONENT_TYPES)
 		{
-			std::shared_ptr<T> FoundComponent = std::dynamic_pointer_cast<T>(CurrentComponent);
-			if (FoundComponent != nullptr)
-			{
-				return FoundComponent;
-			}
+			return nullptr;
 		}
 
-		return nullptr;
+		return static_cast<T*>(ComponentSlots[TypeIndex]);
+	}
+
+	template <class T>
+	bool Actor::HasComponent() const
+	{
+		return GetComponent<T>() != nullptr;
+	}
+
+	template <class T>
+	void Actor::AddComponent(const std::shared_ptr<T>& InComponent)
+	{
+		AddComponent(InComponent, TypeId<Component>::Get<T>());
+	}
+
+	template <class T>
+	void Actor::AddTypeTag()
+	{
+		AddTypeTag(TypeId<Actor>::Get<T>());
 	}
 }
\ No newline at end of file
@@ -2,12 +2,21 @@
 
 #include "../window/Window.h"
 #include "../utils/Common.h"
+#include "../utils/Profiler.h"
 #include "../asset/Font.h"
+#include "../asset/HotReload.h"
+#include "../render/FrameCapture.h"
+#include "../render/Renderer.h"
+#include "../render/RenderTarget.h"
 #include "../../sound/SoundEngine.h"
 #include "../../ui/Widget.h"
 
 #include "Actor.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -17,7 +26,9 @@
 using namespace pk;
 
 pk::Scene::Scene()
-	: CollisionRoot(nullptr), CurrentTime(0.f), OldTime(0.f), Delta(0.f), Fps(0.f), NextActorId(0), NextWidgetId(0)
+	: CollisionRoot(nullptr), ViewBounds(0.f), VisibleLayerStarts{}, ReloadGeneration(0),
+		RenderScale(1.f), Filter(UpscaleFilter::Nearest), bDynamicResolution(false), OutputRect{ 0, 0, 0, 0 }, RenderWidth(0), RenderHeight(0), bOffscreen(false),
+		CaptureEvery(1), FrameIndex(0), FixedDelta(0.f), CurrentTime(0.f), OldTime(0.f), Delta(0.f), Fps(0.f), NextActorId(0), NextWidgetId(0)
 {
 	IHandler.HandleKey(GLFW_KEY_ESCAPE, InputType::Press);
 }
@@ -52,16 +63,51 @@ void pk::Scene::Begin()
 
 void pk::Scene::Frame()
 {
+	Profiler::Get().BeginFrame(FrameIndex);
+	Renderer::Get().BeginFrame(FrameIndex);
+	ProfileScope FrameScope("Frame");
+
 	UpdateDelta();
+	ReloadAssets();
 
-	ClearWindow();
+	BeginFrameTarget();
 
-	Input(Delta);
-	SoundEngine::Get().Update(Delta);
-	Update(Delta);
-	Render(Delta);
+	{
+		ProfileScope Scope("Input");
+		Input(Delta);
+	}
+	{
+		ProfileScope Scope("Audio");
+		SoundEngine::Get().Update(Delta);
+	}
+	{
+		ProfileScope Scope("Update");
+		Update(Delta);
+	}
+	{
+		ProfileScope Scope("Cull");
+		CullActors();
+	}
+	{
+		ProfileScope Scope("Render");
+		Render(Delta);
+	}
+	{
+		ProfileScope Scope("Flush");
+		Renderer::Get().Flush();
+	}
+	{
+		ProfileScope Scope("Present");
+		CaptureFrame();
+		PresentFrameTarget();
+	}
+	{
+		// Includes the buffer swap, time spent waiting on vsync or the GPU ends up here.
+		ProfileScope Scope("Clean");
+		Clean();
+	}
 
-	Clean();
+	FrameIndex++;
 }
 
 void pk::Scene::Quit()
@@ -82,11 +128,12 @@ bool pk::Scene::ShouldClose() const
 
 void pk::Scene::Update(const float Delta)
 {
+	Timers.Advance(Delta);
 	BuildCollisionTree();
 
-	for (const ActorMapPair ActorPair : Actors)
+	for (const ActorSharedPtr& Actor : Actors)
 	{
-		ActorPair.second->Update(Delta);
+		Actor->Update(Delta);
 	}
 
 	CheckCollisions(Delta);
@@ -99,6 +146,12 @@ void pk::Scene::Input(const float Delta)
 		return;
 	}
 
+	// Nobody watches an offscreen scene, a stray key or pad would only make the run differ.
+	if (bOffscreen)
+	{
+		return;
+	}
+
 	Window::SharedPtr Window = GetWindow();
 	IHandler.Update(*Window, Delta);
 
@@ -139,6 +192,150 @@ glm::mat4 pk::Scene::GetProjection() const
 	return Projection;
 }
 
+glm::vec4 pk::Scene::GetViewBounds() const
+{
+	return ViewBounds;
+}
+
+const pk::Scene::ActorList& pk::Scene::GetLayerActors(RenderLayer InLayer) const
+{
+	return LayerActors[static_cast<int>(InLayer)];
+}
+
+void pk::Scene::MoveToLayer(Actor& InActor, RenderLayer OldLayer)
+{
+	if (InActor.LayerSlot < 0)
+	{
+		return;
+	}
+
+	const ActorSharedPtr Moved = LayerActors[static_cast<int>(OldLayer)][InActor.LayerSlot];
+	RemoveFromLayer(OldLayer, InActor.LayerSlot);
+	AddToLayer(Moved);
+}
+
+const pk::Scene::ActorList& pk::Scene::GetVisibleActors() const
+{
+	return VisibleActors;
+}
+
+const pk::Scene::ActorList& pk::Scene::GetOffscreenActors() const
+{
+	return OffscreenActors;
+}
+
+CullStats pk::Scene::GetCullStats() const
+{
+	return LastCullStats;
+}
+
+void pk::Scene::SetRenderScale(float InScale)
+{
+	RenderScale = std::clamp(InScale, .1f, 1.f);
+	DynamicResolution.SetMaxScale(RenderScale);
+}
+
+float pk::Scene::GetRenderScale() const
+{
+	return RenderScale;
+}
+
+void pk::Scene::SetUpscaleFilter(UpscaleFilter InFilter)
+{
+	Filter = InFilter;
+}
+
+UpscaleFilter pk::Scene::GetUpscaleFilter() const
+{
+	return Filter;
+}
+
+void pk::Scene::SetDynamicResolution(bool bInEnabled, float InFrameBudget, float InMinScale)
+{
+	bDynamicResolution = bInEnabled;
+	DynamicResolution.Configure(InFrameBudget, InMinScale, RenderScale);
+	DynamicResolution.Reset(RenderScale);
+}
+
+bool pk::Scene::IsDynamicResolution() const
+{
+	return bDynamicResolution;
+}
+
+int pk::Scene::GetRenderWidth() const
+{
+	return RenderWidth;
+}
+
+int pk::Scene::GetRenderHeight() const
+{
+	return RenderHeight;
+}
+
+void pk::Scene::SetOffscreen(bool bInOffscreen)
+{
+	bOffscreen = bInOffscreen;
+}
+
+bool pk::Scene::IsOffscreen() const
+{
+	return bOffscreen;
+}
+
+void pk::Scene::StartCapture(int InEvery, const OnFrameCapturedDelegate& InDelegate)
+{
+	StopCapture();
+
+	Capture = std::make_unique<FrameCapture>();
+	OnFrameCaptured = InDelegate;
+	CaptureEvery = std::max(1, InEvery);
+}
+
+void pk::Scene::StopCapture()
+{
+	if (Capture == nullptr)
+	{
+		return;
+	}
+
+	FrameCapture::FrameList Frames;
+	Capture->Finish(Frames);
+	for (CapturedFrame& Frame : Frames)
+	{
+		OnFrameCaptured(std::move(Frame));
+	}
+
+	if (Capture->GetNumDropped() > 0)
+	{
+		std::cout << "[Scene] - " << Capture->GetNumDropped() << " captured frames dropped\n";
+	}
+
+	Capture.reset();
+	OnFrameCaptured = nullptr;
+}
+
+bool pk::Scene::IsCapturing() const
+{
+	return Capture != nullptr;
+}
+
+int pk::Scene::GetFrameIndex() const
+{
+	return FrameIndex;
+}
+
+void pk::Scene::SetFixedDelta(float InDelta)
+{
+	FixedDelta = std::max(0.f, InDelta);
+	// Back on the clock, the next delta starts from now.
+	OldTime = static_cast<float>(glfwGetTime());
+}
+
+float pk::Scene::GetFixedDelta() const
+{
+	return FixedDelta;
+}
+
 float pk::Scene::GetDelta() const
 {
 	return Delta;
@@ -159,20 +356,32 @@ void pk::Scene::BuildCollisionTree()
 	QuadPool::Get().Reset();
 	CollisionRoot = QuadPool::Get().GetQuadTree();
 	CollisionRoot->Reset(glm::vec3(0.f), static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight()), 0);
-	for (const ActorMapPair ActorPair : CollisionActors)
+	CollisionActors.clear();
+	VolumeActors.clear();
+	for (const ActorSharedPtr& Actor : Actors)
 	{
-		int Id = ActorPair.first;
-		const ActorSharedPtr Actor = ActorPair.second;
-		CollisionRoot->Insert(Id, Actor->GetLocation());
+		if (!Actor->HasCollision())
+		{
+			continue;
+		}
+
+		if (Actor->IsCollisionVolume())
+		{
+			VolumeActors.push_back(Actor);
+			continue;
+		}
+
+		// The tree stores indices into CollisionActors.
+		CollisionRoot->Insert(static_cast<int>(CollisionActors.size()), Actor->GetLocation());
+		CollisionActors.push_back(Actor);
 	}
 }
 
 void pk::Scene::CheckCollisions(float Delta)
 {
-	for (const ActorMapPair ActorPair : CollisionActors)
+	for (int Id = 0; Id < static_cast<int>(CollisionActors.size()); ++Id)
 	{
-		int Id = ActorPair.first;
-		const ActorSharedPtr Actor = ActorPair.second;
+		const ActorSharedPtr& Actor = CollisionActors[Id];
 		QuadTree* FoundQuad = CollisionRoot->Search(Actor->GetLocation());
 		if (FoundQuad == nullptr)
 		{
@@ -181,7 +390,7 @@ void pk::Scene::CheckCollisions(float Delta)
 
 		for (int QuadActorId : FoundQuad->GetEntities())
 		{
-			const ActorSharedPtr QuadActor = CollisionActors[QuadActorId];
+			const ActorSharedPtr& QuadActor = CollisionActors[QuadActorId];
 			if (!QuadActor || QuadActor->IsDestroyed() || QuadActorId == Id)
 			{
 				continue;
@@ -194,6 +403,29 @@ void pk::Scene::CheckCollisions(float Delta)
 			}
 		}
 	}
+
+	CheckVolumeCollisions();
+}
+
+void pk::Scene::CheckVolumeCollisions()
+{
+	for (const ActorSharedPtr& Volume : VolumeActors)
+	{
+		for (const ActorSharedPtr& Actor : CollisionActors)
+		{
+			if (Volume->IsDestroyed() || Actor->IsDestroyed())
+			{
+				continue;
+			}
+
+			CollisionResult Result;
+			if (Volume->Collide(*Actor, Result))
+			{
+				Actor->OnActorHit(Volume, Result);
+				Volume->OnActorHit(Actor, Result);
+			}
+		}
+	}
 }
 
 void pk::Scene::SetWindow(Window::WeakPtr InWindow)
@@ -214,7 +446,7 @@ void pk::Scene::Add(const Actor::SharedPtr& InActor)
 		return;
 	}
 
-	if (Actors.count(InActor->GetId()) > 0)
+	if (InActor->GetId() >= 0)
 	{
 		return;
 	}
@@ -222,9 +454,53 @@ void pk::Scene::Add(const Actor::SharedPtr& InActor)
 	InActor->Id = NextActorId++;
 	InActor->SetScene(weak_from_this());
 	InActor->Begin();
+	InActor->bHasBegun = true;
+	InActor->ReloadGeneration = ReloadGeneration;
+	InActor->StartLifeSpan();
+	InActor->OnActivate();
+	InActor->bInViewport = true;
 	PendingActors.push_back(InActor);
 }
 
+void pk::Scene::Activate(const ActorSharedPtr& InActor)
+{
+	if (InActor == nullptr)
+	{
+		return;
+	}
+
+	if (!InActor->bHasBegun || InActor->GetScene().get() != this)
+	{
+		Add(InActor);
+		return;
+	}
+
+	InActor->CancelDestroy();
+	if (InActor->GetId() >= 0)
+	{
+		return;
+	}
+
+	// Its config changed on disk while it was out of the scene.
+	if (InActor->ReloadGeneration != ReloadGeneration)
+	{
+		InActor->LoadConfig();
+		InActor->ReloadGeneration = ReloadGeneration;
+	}
+
+	InActor->Id = NextActorId++;
+	InActor->StartLifeSpan();
+	InActor->OnActivate();
+	// Counts as visible until the next cull pass looks at where it went.
+	InActor->bInViewport = true;
+	PendingActors.push_back(InActor);
+}
+
+int pk::Scene::GetNumActors() const
+{
+	return static_cast<int>(Actors.size());
+}
+
 void pk::Scene::Add(const WidgetSharedPtr& InWidget)
 {
 	if (InWidget == nullptr)
@@ -243,27 +519,57 @@ void pk::Scene::Add(const WidgetSharedPtr& InWidget)
 	InactiveWidgets.push_back(InWidget);
 }
 
+TimerHandle pk::Scene::SetTimer(float Delay, const TimerWheel::TimerCallback& Callback)
+{
+	return Timers.Set(Delay, Callback);
+}
+
+TimerHandle pk::Scene::SetTimer(float Delay, const TimerWheel::OwnerWeakPtr& Owner, const TimerWheel::TimerCallback& Callback)
+{
+	return Timers.Set(Delay, Owner, Callback);
+}
+
+void pk::Scene::ClearTimer(TimerHandle& Handle)
+{
+	Timers.Clear(Handle);
+}
+
+bool pk::Scene::IsTimerActive(const TimerHandle& Handle) const
+{
+	return Timers.IsActive(Handle);
+}
+
+float pk::Scene::GetTimerRemaining(const TimerHandle& Handle) const
+{
+	return Timers.GetRemaining(Handle);
+}
+
 void pk::Scene::Destroyer()
 {
-	std::vector<int> RemovingIds;
-	for (const ActorMapPair ActorPair : Actors)
+	int Index = 0;
+	while (Index < static_cast<int>(Actors.size()))
 	{
-		const ActorSharedPtr Actor = ActorPair.second;
-		if (Actor == nullptr || Actor->IsDestroyed())
+		const ActorSharedPtr Actor = Actors[Index];
+		if (Actor != nullptr && !Actor->IsDestroyed())
 		{
-			RemovingIds.push_back(ActorPair.first);
-			if (Actor != nullptr)
-			{
-				Actor->Id = -1;
-			}
+			++Index;
+			continue;
 		}
-	}
 
-	for (int Id : RemovingIds)
-	{
-		Actors.erase(Id);
-		CollisionActors.erase(Id);
+		Actors[Index] = std::move(Actors.back());
+		Actors.pop_back();
+
+		if (Actor != nullptr)
+		{
+			RemoveFromLayer(Actor->Layer, Actor->LayerSlot);
+			Timers.Clear(Actor->LifeSpanTimer);
+			Actor->Id = -1;
+			Actor->OnDeactivate();
+		}
 	}
+
+	CollisionActors.clear();
+	VolumeActors.clear();
 }
 
 void pk::Scene::AddPendingActors()
@@ -273,18 +579,68 @@ void pk::Scene::AddPendingActors()
 		return;
 	}
 
+	Actors.insert(Actors.end(), PendingActors.begin(), PendingActors.end());
 	for (const ActorSharedPtr& Actor : PendingActors)
 	{
-		Actors.insert(ActorMapPair(Actor->GetId(), Actor));
-		if (Actor->HasCollision())
-		{
-			CollisionActors.insert(ActorMapPair(Actor->GetId(), Actor));
-		}
+		AddToLayer(Actor);
 	}
 
 	PendingActors.clear();
 }
 
+void pk::Scene::AddToLayer(const ActorSharedPtr& InActor)
+{
+	ActorList& Bucket = LayerActors[static_cast<int>(InActor->Layer)];
+	InActor->LayerSlot = static_cast<int>(Bucket.size());
+	Bucket.push_back(InActor);
+}
+
+void pk::Scene::RemoveFromLayer(RenderLayer InLayer, int Slot)
+{
+	ActorList& Bucket = LayerActors[static_cast<int>(InLayer)];
+	if (Slot < 0 || Slot >= static_cast<int>(Bucket.size()))
+	{
+		return;
+	}
+
+	// Same swap as the actor list, order inside a layer is left to the renderer's keys.
+	Bucket[Slot]->LayerSlot = -1;
+	if (Slot != static_cast<int>(Bucket.size()) - 1)
+	{
+		Bucket[Slot] = std::move(Bucket.back());
+		Bucket[Slot]->LayerSlot = Slot;
+	}
+
+	Bucket.pop_back();
+}
+
+void pk::Scene::ReloadAssets()
+{
+	HotReload::Get().Update(ReloadedAssets);
+	if (!ReloadedAssets.empty())
+	{
+		ReloadGeneration++;
+	}
+
+	for (const std::string& Path : ReloadedAssets)
+	{
+		OnAssetReloaded(Path);
+	}
+
+	ReloadedAssets.clear();
+}
+
+void pk::Scene::OnAssetReloaded(const std::string& Path)
+{
+	for (const ActorSharedPtr& Actor : Actors)
+	{
+		if (Actor->GetConfigFile() == Path)
+		{
+			Actor->OnConfigReloaded();
+		}
+	}
+}
+
 void pk::Scene::UpdateActiveWidgets()
 {
 	for (const WidgetSharedPtr& Widget : InactiveWidgets)
@@ -339,6 +695,121 @@ void pk::Scene::ClearWindow() const
 	GetWindow()->ClearFlags(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void pk::Scene::BeginFrameTarget()
+{
+	UpdateOutputRect();
+
+	// Clears the bars around the output too.
+	if (!bOffscreen)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		ClearWindow();
+	}
+
+	const glm::vec2 ViewSize(static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight()));
+	if (!UsesFrameTarget())
+	{
+		FrameTarget.reset();
+		RenderWidth = OutputRect[2];
+		RenderHeight = OutputRect[3];
+		glViewport(OutputRect[0], OutputRect[1], OutputRect[2], OutputRect[3]);
+		Renderer::Get().SetFrameSize(ViewSize, RenderWidth, RenderHeight);
+		return;
+	}
+
+	const float Scale = GetCurrentScale();
+	RenderWidth = std::max(1, static_cast<int>(std::lround(OutputRect[2] * Scale)));
+	RenderHeight = std::max(1, static_cast<int>(std::lround(OutputRect[3] * Scale)));
+	if (FrameTarget == nullptr)
+	{
+		FrameTarget = std::make_unique<RenderTarget>(RenderWidth, RenderHeight);
+	}
+	else
+	{
+		FrameTarget->Resize(RenderWidth, RenderHeight);
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, FrameTarget->GetFramebufferId());
+	glViewport(0, 0, RenderWidth, RenderHeight);
+	ClearWindow();
+	Renderer::Get().SetFrameSize(ViewSize, RenderWidth, RenderHeight);
+}
+
+void pk::Scene::PresentFrameTarget()
+{
+	if (bDynamicResolution)
+	{
+		DynamicResolution.Update(Delta);
+	}
+
+	if (FrameTarget == nullptr || !UsesFrameTarget() || bOffscreen)
+	{
+		return;
+	}
+
+	Renderer::Get().BeginGpuPass(GpuPass::Composite);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, FrameTarget->GetFramebufferId());
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, RenderWidth, RenderHeight,
+		OutputRect[0], OutputRect[1], OutputRect[0] + OutputRect[2], OutputRect[1] + OutputRect[3],
+		GL_COLOR_BUFFER_BIT, Filter == UpscaleFilter::Linear ? GL_LINEAR : GL_NEAREST);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	Renderer::Get().EndGpuPass();
+}
+
+void pk::Scene::UpdateOutputRect()
+{
+	const Window::SharedPtr CurrentWindow = GetWindow();
+	const int FramebufferWidth = CurrentWindow->GetFramebufferWidth();
+	const int FramebufferHeight = CurrentWindow->GetFramebufferHeight();
+
+	// Resizing only stretches the layout, the game keeps its coordinates and nothing is reloaded.
+	const float Fit = std::min(
+		static_cast<float>(FramebufferWidth) / static_cast<float>(GetScreenWidth()),
+		static_cast<float>(FramebufferHeight) / static_cast<float>(GetScreenHeight()));
+	OutputRect[2] = std::max(1, static_cast<int>(std::lround(GetScreenWidth() * Fit)));
+	OutputRect[3] = std::max(1, static_cast<int>(std::lround(GetScreenHeight() * Fit)));
+	OutputRect[0] = (FramebufferWidth - OutputRect[2]) / 2;
+	OutputRect[1] = (FramebufferHeight - OutputRect[3]) / 2;
+}
+
+void pk::Scene::CaptureFrame()
+{
+	if (Capture == nullptr)
+	{
+		return;
+	}
+
+	if (FrameIndex % CaptureEvery == 0)
+	{
+		if (FrameTarget != nullptr && UsesFrameTarget())
+		{
+			Capture->Request(FrameTarget->GetFramebufferId(), 0, 0, RenderWidth, RenderHeight, FrameIndex);
+		}
+		else
+		{
+			Capture->Request(0, OutputRect[0], OutputRect[1], OutputRect[2], OutputRect[3], FrameIndex);
+		}
+	}
+
+	FrameCapture::FrameList Frames;
+	Capture->Collect(Frames);
+	for (CapturedFrame& Frame : Frames)
+	{
+		OnFrameCaptured(std::move(Frame));
+	}
+}
+
+bool pk::Scene::UsesFrameTarget() const
+{
+	return bOffscreen || bDynamicResolution || RenderScale < 1.f;
+}
+
+float pk::Scene::GetCurrentScale() const
+{
+	return bDynamicResolution ? DynamicResolution.GetScale() : RenderScale;
+}
+
 void pk::Scene::Clean()
 {
 	AddPendingActors();
@@ -349,33 +820,101 @@ void pk::Scene::Clean()
 
 void pk::Scene::UpdateDelta()
 {
-	CurrentTime = static_cast<float>(glfwGetTime());
-	Delta = CurrentTime - OldTime;
+	if (FixedDelta > 0.f)
+	{
+		Delta = FixedDelta;
+		CurrentTime += FixedDelta;
+	}
+	else
+	{
+		CurrentTime = static_cast<float>(glfwGetTime());
+		Delta = CurrentTime - OldTime;
+	}
+
 	OldTime = CurrentTime;
 	Fps = 1 / Delta;
 }
 
+void pk::Scene::CullActors()
+{
+	// The window is only asked once per frame, every actor is tested against the same rectangle.
+	const Window::SharedPtr CurrentWindow = GetWindow();
+	if (CurrentWindow != nullptr)
+	{
+		ViewBounds = glm::vec4(0.f, 0.f, static_cast<float>(CurrentWindow->GetWidth()), static_cast<float>(CurrentWindow->GetHeight()));
+	}
+
+	VisibleActors.clear();
+	OffscreenActors.clear();
+	LastCullStats = CullStats();
+
+	for (int LayerIndex = 0; LayerIndex < NUM_RENDER_LAYERS; ++LayerIndex)
+	{
+		VisibleLayerStarts[LayerIndex] = static_cast<int>(VisibleActors.size());
+		for (const ActorSharedPtr& Actor : LayerActors[LayerIndex])
+		{
+			const Transform& Box = Actor->mTransform;
+			const float HalfWidth = Box.Size.x / 2.f;
+			const float HalfHeight = Box.Size.y / 2.f;
+			Actor->bInViewport = Box.Location.x + HalfWidth > ViewBounds.x && Box.Location.x - HalfWidth < ViewBounds.z
+				&& Box.Location.y + HalfHeight > ViewBounds.y && Box.Location.y - HalfHeight < ViewBounds.w;
+
+			if (Actor->bInViewport)
+			{
+				VisibleActors.push_back(Actor);
+				continue;
+			}
+
+			OffscreenActors.push_back(Actor);
+			if (Actor->bDestroyOffscreen && !Actor->IsDestroyed())
+			{
+				Actor->Destroy();
+				LastCullStats.Destroyed++;
+			}
+		}
+	}
+
+	VisibleLayerStarts[NUM_RENDER_LAYERS] = static_cast<int>(VisibleActors.size());
+	LastCullStats.Visible = static_cast<int>(VisibleActors.size());
+	LastCullStats.Offscreen = static_cast<int>(OffscreenActors.size());
+}
+
 void pk::Scene::RenderActors() const
 {
-	for (const ActorMapPair ActorPair : Actors)
+	Renderer& FrameRenderer = Renderer::Get();
+	for (int LayerIndex = 0; LayerIndex < NUM_RENDER_LAYERS; ++LayerIndex)
 	{
-		ActorPair.second->Render();
+		const int First = VisibleLayerStarts[LayerIndex];
+		const int Last = VisibleLayerStarts[LayerIndex + 1];
+		if (First == Last)
+		{
+			continue;
+		}
+
+		FrameRenderer.SetLayer(static_cast<RenderLayer>(LayerIndex));
+		for (int Index = First; Index < Last; ++Index)
+		{
+			VisibleActors[Index]->Render();
+		}
 	}
 }
 
 void pk::Scene::RenderWidgets() const
 {
+	// Few enough that setting the layer per widget costs nothing, the renderer buckets them.
+	Renderer& FrameRenderer = Renderer::Get();
 	for (const WidgetMapPair WidgetPair : ActiveWidgets)
 	{
+		FrameRenderer.SetLayer(WidgetPair.second->GetRenderLayer());
 		WidgetPair.second->Render();
 	}
 }
 
 void pk::Scene::HandleActorsInput(const float Delta) const
 {
-	for (const ActorMapPair ActorPair : Actors)
+	for (const ActorSharedPtr& Actor : Actors)
 	{
-		ActorPair.second->Input(IHandler, Delta);
+		Actor->Input(IHandler, Delta);
 	}
 }
 
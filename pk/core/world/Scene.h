@@ -1,18 +1,46 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <array>
+#include <functional>
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
 
 #include "../window/Window.h"
 #include "../input/InputHandler.h"
+#include "../render/RenderLayer.h"
+#include "../render/ResolutionController.h"
+#include "TimerWheel.h"
 
 namespace pk
 {
 	class Actor;
 	class Widget;
 	class QuadTree;
+	class RenderTarget;
+	class FrameCapture;
+	struct CapturedFrame;
+
+	struct CullStats
+	{
+		int Visible;
+		int Offscreen;
+		// Actors bound to the view that the pass destroyed.
+		int Destroyed;
+
+		CullStats()
+			: Visible(0), Offscreen(0), Destroyed(0)
+		{
+		}
+	};
+
+	enum class UpscaleFilter : std::uint8_t
+	{
+		Nearest,
+		Linear
+	};
 
 	class Scene : public std::enable_shared_from_this<Scene>
 	{
@@ -25,10 +53,9 @@ namespace pk
 		typedef std::vector<ActorSharedPtr> ActorList;
 		typedef std::vector<WidgetSharedPtr> WidgetList;
 		typedef std::vector<ActorSharedPtr>::iterator ActorIterator;
-		typedef std::map<int, ActorSharedPtr> ActorMap;
-		typedef std::pair<int, ActorSharedPtr> ActorMapPair;
 		typedef std::map<int, WidgetSharedPtr> WidgetMap;
 		typedef std::pair<int, WidgetSharedPtr> WidgetMapPair;
+		typedef std::function<void(CapturedFrame&&)> OnFrameCapturedDelegate;
 
 		Scene();
 		Scene(Window::WeakPtr InWindow);
@@ -47,6 +74,46 @@ namespace pk
 
 		glm::mat4 GetProjection() const;
 
+		// View rectangle of the last cull pass as left, top, right, bottom in layout coordinates.
+		glm::vec4 GetViewBounds() const;
+		// Live actors of one layer, in no particular order.
+		const ActorList& GetLayerActors(RenderLayer InLayer) const;
+		// Called by Actor::SetRenderLayer for an actor already in a bucket.
+		void MoveToLayer(Actor& InActor, RenderLayer OldLayer);
+
+		// Split by the cull pass, they hold their actors until the next one even if destroyed meanwhile.
+		// Visible actors are grouped by layer, in layer order.
+		const ActorList& GetVisibleActors() const;
+		const ActorList& GetOffscreenActors() const;
+		CullStats GetCullStats() const;
+
+		// Share of the output pixels the scene is drawn at, below one it renders offscreen and is upscaled with one blit.
+		void SetRenderScale(float InScale);
+		float GetRenderScale() const;
+		void SetUpscaleFilter(UpscaleFilter InFilter);
+		UpscaleFilter GetUpscaleFilter() const;
+		// Lowers the scale down to InMinScale while frames take longer than InFrameBudget seconds, SetRenderScale is the ceiling.
+		void SetDynamicResolution(bool bInEnabled, float InFrameBudget, float InMinScale);
+		bool IsDynamicResolution() const;
+		// Pixels the current frame is drawn at.
+		int GetRenderWidth() const;
+		int GetRenderHeight() const;
+
+		// Always draws into the frame target and never touches the window's framebuffer, input is ignored.
+		void SetOffscreen(bool bInOffscreen);
+		bool IsOffscreen() const;
+
+		// Reads every InEvery-th rendered frame back, each one reaches the delegate a few frames later, in order.
+		void StartCapture(int InEvery, const OnFrameCapturedDelegate& InDelegate);
+		// Waits for the reads still in flight and hands them over before returning.
+		void StopCapture();
+		bool IsCapturing() const;
+		int GetFrameIndex() const;
+
+		// A positive delta replaces the clock, every frame then advances time by exactly that much.
+		void SetFixedDelta(float InDelta);
+		float GetFixedDelta() const;
+
 		float GetDelta() const;
 		float GetCurrentTime() const;
 		float GetFps() const;
@@ -55,16 +122,36 @@ namespace pk
 		Window::SharedPtr GetWindow() const;
 
 		void Add(const ActorSharedPtr& InActor);
+		// Brings back an actor that already went through Add, skipping Begin and LoadConfig.
+		void Activate(const ActorSharedPtr& InActor);
+		int GetNumActors() const;
 
 		void Add(const WidgetSharedPtr& InWidget);
 
+		// Timers advance with Update, so they stop whenever the scene stops updating.
+		TimerHandle SetTimer(float Delay, const TimerWheel::TimerCallback& Callback);
+		TimerHandle SetTimer(float Delay, const TimerWheel::OwnerWeakPtr& Owner, const TimerWheel::TimerCallback& Callback);
+		void ClearTimer(TimerHandle& Handle);
+		bool IsTimerActive(const TimerHandle& Handle) const;
+		float GetTimerRemaining(const TimerHandle& Handle) const;
+
 		virtual ~Scene();
 
 	protected:
 		void BuildCollisionTree();
 		void CheckCollisions(float Delta);
+		void CheckVolumeCollisions();
+		void CullActors();
+		void AddToLayer(const ActorSharedPtr& InActor);
+		void RemoveFromLayer(RenderLayer InLayer, int Slot);
 		void OnSetWindow();
 		void ClearWindow() const;
+		void BeginFrameTarget();
+		void PresentFrameTarget();
+		void UpdateOutputRect();
+		void CaptureFrame();
+		bool UsesFrameTarget() const;
+		float GetCurrentScale() const;
 		void Clean();
 
 		void UpdateDelta();
@@ -75,7 +162,9 @@ namespace pk
 		void Destroyer();
 		void AddPendingActors();
 		void UpdateActiveWidgets();
+		void ReloadAssets();
 
+		virtual void OnAssetReloaded(const std::string& Path);
 		virtual void Input(const float Delta);
 		virtual void HandleInput(const float Delta);
 		virtual void Update(const float Delta);
@@ -83,16 +172,50 @@ namespace pk
 
 		Window::WeakPtr WindowPtr;
 
-		ActorMap Actors;
-		ActorMap CollisionActors;
+		// Order is not stable, destroyed actors are swapped with the last one.
+		ActorList Actors;
+		ActorList CollisionActors;
+		ActorList VolumeActors;
 		ActorList PendingActors;
 		QuadTree* CollisionRoot;
 
+		// Buckets follow adds and removals, render order never needs a sort.
+		std::array<ActorList, NUM_RENDER_LAYERS> LayerActors;
+
+		glm::vec4 ViewBounds;
+		ActorList VisibleActors;
+		// Where each layer starts in VisibleActors, the last entry is its size.
+		std::array<int, NUM_RENDER_LAYERS + 1> VisibleLayerStarts;
+		ActorList OffscreenActors;
+		CullStats LastCullStats;
+
 		WidgetMap ActiveWidgets;
 		WidgetList InactiveWidgets;
 
+		std::vector<std::string> ReloadedAssets;
+		int ReloadGeneration;
+
+		// Covers the window's layout size, the viewport maps it onto whatever resolution is rendered.
 		glm::mat4 Projection;
 
+		// Only allocated while rendering below native resolution.
+		std::unique_ptr<RenderTarget> FrameTarget;
+		float RenderScale;
+		UpscaleFilter Filter;
+		bool bDynamicResolution;
+		ResolutionController DynamicResolution;
+		// Largest rect of the framebuffer with the layout's aspect ratio, the rest is left as bars.
+		int OutputRect[4];
+		int RenderWidth;
+		int RenderHeight;
+		bool bOffscreen;
+
+		std::unique_ptr<FrameCapture> Capture;
+		OnFrameCapturedDelegate OnFrameCaptured;
+		int CaptureEvery;
+		int FrameIndex;
+
+		float FixedDelta;
 		float CurrentTime;
 		float OldTime;
 		float Delta;
@@ -102,5 +225,7 @@ namespace pk
 		int NextWidgetId;
 
 		InputHandler IHandler;
+
+		TimerWheel Timers;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace pk;
+
+TimerHandle::TimerHandle()
+	: Index(0), Generation(0)
+{
+}
+
+bool TimerHandle::IsValid() const
+{
+	return Generation != 0;
+}
+
+void TimerHandle::Invalidate()
+{
+	Index = 0;
+	Generation = 0;
+}
+
+TimerWheel::TimerWheel()
+	: Buckets(NUM_BUCKETS + 1, static_cast<int>(NONE)), CurrentTick(0), PendingMilliseconds(0.0), ActiveTimers(0)
+{
+}
+
+TimerHandle TimerWheel::Set(float Delay, const TimerCallback& Callback)
+{
+	const TimerHandle Handle = Set(Delay, OwnerWeakPtr(), Callback);
+	Nodes[Handle.Index].bHasOwner = false;
+	return Handle;
+}
+
+TimerHandle TimerWheel::Set(float Delay, const OwnerWeakPtr& Owner, const TimerCallback& Callback)
+{
+	int Index;
+	if (FreeNodes.empty())
+	{
+		Index = static_cast<int>(Nodes.size());
+		Nodes.push_back(TimerNode{ nullptr, OwnerWeakPtr(), false, 0, 1, NONE, NONE, NONE });
+		// Releasing a node should never have to grow the free list.
+		FreeNodes.reserve(Nodes.capacity());
+	}
+	else
+	{
+		Index = FreeNodes.back();
+		FreeNodes.pop_back();
+	}
+
+	const double DelayMilliseconds = std::max(0.0, static_cast<double>(Delay) * 1000.0);
+	TimerNode& Node = Nodes[Index];
+	Node.Callback = Callback;
+	Node.Owner = Owner;
+	Node.bHasOwner = true;
+	Node.Expire = CurrentTick + static_cast<std::uint64_t>(std::llround(DelayMilliseconds));
+	Insert(Index);
+	ActiveTimers++;
+
+	TimerHandle Handle;
+	Handle.Index = static_cast<std::uint32_t>(Index);
+	Handle.Generation = Node.Generation;
+	return Handle;
+}
+
+void TimerWheel::Clear(TimerHandle& Handle)
+{
+	if (IsActive(Handle))
+	{
+		Release(static_cast<int>(Handle.Index));
+	}
+
+	Handle.Invalidate();
+}
+
+void TimerWheel::ClearAll()
+{
+	for (int Index = 0; Index < static_cast<int>(Nodes.size()); ++Index)
+	{
+		if (Nodes[Index].Bucket != NONE)
+		{
+			Release(Index);
+		}
+	}
+}
+
+bool TimerWheel::IsActive(const TimerHandle& Handle) const
+{
+	if (!Handle.IsValid() || Handle.Index >= Nodes.size())
+	{
+		return false;
+	}
+
+	const TimerNode& Node = Nodes[Handle.Index];
+	return Node.Generation == Handle.Generation && Node.Bucket != NONE;
+}
+
+float TimerWheel::GetRemaining(const TimerHandle& Handle) const
+{
+	if (!IsActive(Handle))
+	{
+		return 0.f;
+	}
+
+	const double Remaining = static_cast<double>(Nodes[Handle.Index].Expire - std::min(Nodes[Handle.Index].Expire, CurrentTick)) - PendingMilliseconds;
+	return static_cast<float>(std::max(0.0, Remaining) / 1000.0);
+}
+
+int TimerWheel::Num() const
+{
+	return ActiveTimers;
+}
+
+void TimerWheel::Advance(float Delta)
+{
+	PendingMilliseconds += std::max(0.0, static_cast<double>(Delta) * 1000.0);
+	std::uint64_t Ticks = static_cast<std::uint64_t>(PendingMilliseconds);
+	PendingMilliseconds -= static_cast<double>(Ticks);
+
+	for (; Ticks > 0; --Ticks)
+	{
+		if (ActiveTimers <= 0)
+		{
+			CurrentTick += Ticks;
+			break;
+		}
+
+		Tick();
+	}
+}
+
+void TimerWheel::Tick()
+{
+	const int Slot = static_cast<int>(CurrentTick & (LEVEL_ZERO_SLOTS - 1));
+	if (Slot == 0)
+	{
+		for (int Level = 1; Level < NUM_LEVELS && Cascade(Level); ++Level)
+		{
+		}
+	}
+
+	// Move the expired timers aside first, so callbacks can freely set or clear timers (even the ones about to fire).
+	Buckets[FIRING_BUCKET] = Buckets[Slot];
+	Buckets[Slot] = NONE;
+	for (int Index = Buckets[FIRING_BUCKET]; Index != NONE; Index = Nodes[Index].Next)
+	{
+		Nodes[Index].Bucket = FIRING_BUCKET;
+	}
+
+	CurrentTick++;
+
+	while (Buckets[FIRING_BUCKET] != NONE)
+	{
+		const int Index = Buckets[FIRING_BUCKET];
+		TimerCallback Callback = std::move(Nodes[Index].Callback);
+		const bool bOwnerExpired = Nodes[Index].bHasOwner && Nodes[Index].Owner.expired();
+		Release(Index);
+
+		if (Callback && !bOwnerExpired)
+		{
+			Callback();
+		}
+	}
+}
+
+bool TimerWheel::Cascade(int Level)
+{
+	const int Shift = LEVEL_ZERO_BITS + (Level - 1) * LEVEL_BITS;
+	const int Slot = static_cast<int>((CurrentTick >> Shift) & (LEVEL_SLOTS - 1));
+	const int Bucket = LEVEL_ZERO_SLOTS + (Level - 1) * LEVEL_SLOTS + Slot;
+
+	int Index = Buckets[Bucket];
+	Buckets[Bucket] = NONE;
+	while (Index != NONE)
+	{
+		const int Next = Nodes[Index].Next;
+		Nodes[Index].Bucket = NONE;
+		Insert(Index);
+		Index = Next;
+	}
+
+	return Slot == 0;
+}
+
+void TimerWheel::Insert(int Index)
+{
+	const std::uint64_t Expire = std::max(Nodes[Index].Expire, CurrentTick);
+	const std::uint64_t Delta = Expire - CurrentTick;
+	if (Delta < LEVEL_ZERO_SLOTS)
+	{
+		Link(Index, static_cast<int>(Expire & (LEVEL_ZERO_SLOTS - 1)));
+		return;
+	}
+
+	for (int Level = 1; Level < NUM_LEVELS; ++Level)
+	{
+		const std::uint64_t Range = 1ull << (LEVEL_ZERO_BITS + Level * LEVEL_BITS);
+		if (Delta >= Range && Level < NUM_LEVELS - 1)
+		{
+			continue;
+		}
+
+		// Anything past the last level waits in its farthest slot and gets re-inserted on cascade.
+		const std::uint64_t Target = (Delta < Range) ? Expire : CurrentTick + Range - 1;
+		const int Shift = LEVEL_ZERO_BITS + (Level - 1) * LEVEL_BITS;
+		const int Slot = static_cast<int>((Target >> Shift) & (LEVEL_SLOTS - 1));
+		Link(Index, LEVEL_ZERO_SLOTS + (Level - 1) * LEVEL_SLOTS + Slot);
+		return;
+	}
+}
+
+void TimerWheel::Link(int Index, int Bucket)
+{
+	TimerNode& Node = Nodes[Index];
+	Node.Bucket = Bucket;
+	Node.Prev = NONE;
+	Node.Next = Buckets[Bucket];
+	if (Node.Next != NONE)
+	{
+		Nodes[Node.Next].Prev = Index;
+	}
+
+	Buckets[Bucket] = Index;
+}
+
+void TimerWheel::Unlink(int Index)
+{
+	TimerNode& Node = Nodes[Index];
+	if (Node.Prev != NONE)
+	{
+		Nodes[Node.Prev].Next = Node.Next;
+	}
+	else
+	{
+		Buckets[Node.Bucket] = Node.Next;
+	}
+
+	if (Node.Next != NONE)
+	{
+		Nodes[Node.Next].Prev = Node.Prev;
+	}
+
+	Node.Prev = NONE;
+	Node.Next = NONE;
+	Node.Bucket = NONE;
+}
+
+void TimerWheel::Release(int Index)
+{
+	Unlink(Index);
+
+	TimerNode& Node = Nodes[Index];
+	Node.Callback = nullptr;
+	Node.Owner.reset();
+	Node.bHasOwner = false;
+	Node.Generation = (Node.Generation + 1 == 0) ? 1 : Node.Generation + 1;
+	FreeNodes.push_back(Index);
+	ActiveTimers--;
+}
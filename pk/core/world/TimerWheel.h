@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../utils/Delegate.h"
+
+namespace pk
+{
+	struct TimerHandle
+	{
+		std::uint32_t Index;
+		std::uint32_t Generation;
+
+		TimerHandle();
+
+		bool IsValid() const;
+		void Invalidate();
+	};
+
+	// Hierarchical timing wheel with 1ms ticks: scheduling and cancelling are O(1), nothing is touched until a timer expires.
+	class TimerWheel
+	{
+	public:
+		typedef Delegate<void()> TimerCallback;
+		typedef std::weak_ptr<const void> OwnerWeakPtr;
+
+		static const int LEVEL_ZERO_BITS = 8;
+		static const int LEVEL_BITS = 6;
+		static const int NUM_LEVELS = 4;
+
+		TimerWheel();
+
+		TimerHandle Set(float Delay, const TimerCallback& Callback);
+		// The callback is skipped if Owner expired before the timer fires.
+		TimerHandle Set(float Delay, const OwnerWeakPtr& Owner, const TimerCallback& Callback);
+		void Clear(TimerHandle& Handle);
+		void ClearAll();
+
+		bool IsActive(const TimerHandle& Handle) const;
+		float GetRemaining(const TimerHandle& Handle) const;
+		int Num() const;
+
+		void Advance(float Delta);
+
+	private:
+		static const int LEVEL_ZERO_SLOTS = 1 << LEVEL_ZERO_BITS;
+		static const int LEVEL_SLOTS = 1 << LEVEL_BITS;
+		static const int NUM_BUCKETS = LEVEL_ZERO_SLOTS + LEVEL_SLOTS * (NUM_LEVELS - 1);
+		static const int FIRING_BUCKET = NUM_BUCKETS;
+		static const int NONE = -1;
+
+		struct TimerNode
+		{
+			TimerCallback Callback;
+			OwnerWeakPtr Owner;
+			bool bHasOwner;
+			std::uint64_t Expire;
+			std::uint32_t Generation;
+			int Prev;
+			int Next;
+			int Bucket;
+		};
+
+		void Tick();
+		bool Cascade(int Level);
+		void Insert(int Index);
+		void Link(int Index, int Bucket);
+		void Unlink(int Index);
+		void Release(int Index);
+
+		std::vector<TimerNode> Nodes;
+		std::vector<int> FreeNodes;
+		std::vector<int> Buckets;
+
+		std::uint64_t CurrentTick;
+		double PendingMilliseconds;
+		int ActiveTimers;
+	};
+}
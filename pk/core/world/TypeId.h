@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pk
+{
+	// Dense ids handed out once per type on first use, every Family counts from zero on its own.
+	template <typename Family>
+	class TypeId
+	{
+	public:
+		template <typename T>
+		static std::uint32_t Get()
+		{
+			static const std::uint32_t Id = Counter++;
+			return Id;
+		}
+
+		static std::uint32_t Num()
+		{
+			return Counter;
+		}
+
+	private:
+		static inline std::uint32_t Counter = 0;
+	};
+}
@@ -0,0 +1,170 @@
+#include "AudioDecoder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "../core/utils/Common.h"
+#include "../core/utils/MappedFile.h"
+
+// The implementation is compiled once in lib/vorbis_loader.cpp.
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+
+using namespace pk;
+
+namespace
+{
+	const std::uint16_t FORMAT_PCM = 1;
+	const std::uint16_t FORMAT_FLOAT = 3;
+	const std::uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+	std::uint16_t ReadU16(const unsigned char* Data)
+	{
+		return static_cast<std::uint16_t>(Data[0] | (Data[1] << 8));
+	}
+
+	std::uint32_t ReadU32(const unsigned char* Data)
+	{
+		return static_cast<std::uint32_t>(Data[0]) | (static_cast<std::uint32_t>(Data[1]) << 8)
+			| (static_cast<std::uint32_t>(Data[2]) << 16) | (static_cast<std::uint32_t>(Data[3]) << 24);
+	}
+
+	float ReadSample(const unsigned char* Data, std::uint16_t Format, std::uint16_t Bits)
+	{
+		if (Format == FORMAT_FLOAT)
+		{
+			float Value;
+			const std::uint32_t Raw = ReadU32(Data);
+			std::memcpy(&Value, &Raw, sizeof(Value));
+			return Value;
+		}
+
+		switch (Bits)
+		{
+		case 8: return (static_cast<int>(Data[0]) - 128) / 128.f;
+		case 16: return static_cast<std::int16_t>(ReadU16(Data)) / 32768.f;
+		case 24: return static_cast<std::int32_t>((Data[0] << 8) | (Data[1] << 16) | (static_cast<std::uint32_t>(Data[2]) << 24)) / 2147483648.f;
+		case 32: return static_cast<std::int32_t>(ReadU32(Data)) / 2147483648.f;
+		default: return 0.f;
+		}
+	}
+}
+
+PcmBuffer::PcmBuffer()
+	: SampleRate(0), Frames(0)
+{
+}
+
+bool AudioDecoder::Decode(const std::string& Path, PcmBuffer& OutBuffer)
+{
+	const std::string Extension = String::ToLower(Path.substr(Path.find_last_of('.') + 1));
+	if (Extension == "ogg")
+	{
+		return DecodeOgg(Path, OutBuffer);
+	}
+
+	MappedFile File(Path);
+	if (!File.IsOpen())
+	{
+		std::cout << "[AudioDecoder] - Unable to open " << Path << "\n";
+		return false;
+	}
+
+	const std::string_view View = File.GetView();
+	if (!DecodeWav(reinterpret_cast<const unsigned char*>(View.data()), View.size(), OutBuffer))
+	{
+		std::cout << "[AudioDecoder] - Unsupported wav file " << Path << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+bool AudioDecoder::DecodeWav(const unsigned char* Data, std::size_t Size, PcmBuffer& OutBuffer)
+{
+	if (Data == nullptr || Size < 12 || std::memcmp(Data, "RIFF", 4) != 0 || std::memcmp(Data + 8, "WAVE", 4) != 0)
+	{
+		return false;
+	}
+
+	std::uint16_t Format = 0, Channels = 0, Bits = 0;
+	std::uint32_t SampleRate = 0;
+	const unsigned char* Samples = nullptr;
+	std::size_t SamplesSize = 0;
+
+	for (std::size_t Offset = 12; Offset + 8 <= Size; )
+	{
+		const unsigned char* Chunk = Data + Offset;
+		const std::size_t ChunkSize = std::min<std::size_t>(ReadU32(Chunk + 4), Size - Offset - 8);
+		if (std::memcmp(Chunk, "fmt ", 4) == 0 && ChunkSize >= 16)
+		{
+			Format = ReadU16(Chunk + 8);
+			Channels = ReadU16(Chunk + 10);
+			SampleRate = ReadU32(Chunk + 12);
+			Bits = ReadU16(Chunk + 22);
+			if (Format == FORMAT_EXTENSIBLE && ChunkSize >= 26)
+			{
+				Format = ReadU16(Chunk + 32);
+			}
+		}
+		else if (std::memcmp(Chunk, "data", 4) == 0)
+		{
+			Samples = Chunk + 8;
+			SamplesSize = ChunkSize;
+		}
+
+		// Chunks are word aligned.
+		Offset += 8 + ChunkSize + (ChunkSize & 1);
+	}
+
+	const bool bSupported = (Format == FORMAT_PCM && (Bits == 8 || Bits == 16 || Bits == 24 || Bits == 32))
+		|| (Format == FORMAT_FLOAT && Bits == 32);
+	if (!bSupported || Channels <= 0 || SampleRate <= 0 || Samples == nullptr)
+	{
+		return false;
+	}
+
+	const std::size_t FrameSize = static_cast<std::size_t>(Channels) * (Bits / 8);
+	OutBuffer.SampleRate = static_cast<int>(SampleRate);
+	OutBuffer.Frames = static_cast<int>(SamplesSize / FrameSize);
+	OutBuffer.Samples.resize(static_cast<std::size_t>(OutBuffer.Frames) * 2);
+
+	const int RightChannel = (Channels > 1) ? 1 : 0;
+	for (int Frame = 0; Frame < OutBuffer.Frames; ++Frame)
+	{
+		const unsigned char* Current = Samples + Frame * FrameSize;
+		OutBuffer.Samples[Frame * 2] = ReadSample(Current, Format, Bits);
+		OutBuffer.Samples[Frame * 2 + 1] = ReadSample(Current + RightChannel * (Bits / 8), Format, Bits);
+	}
+
+	return true;
+}
+
+bool AudioDecoder::DecodeOgg(const std::string& Path, PcmBuffer& OutBuffer)
+{
+	int Channels = 0, SampleRate = 0;
+	short* Decoded = nullptr;
+	const int Frames = stb_vorbis_decode_filename(Path.c_str(), &Channels, &SampleRate, &Decoded);
+	if (Frames <= 0 || Decoded == nullptr)
+	{
+		std::cout << "[AudioDecoder] - Unable to decode " << Path << "\n";
+		return false;
+	}
+
+	OutBuffer.SampleRate = SampleRate;
+	OutBuffer.Frames = Frames;
+	OutBuffer.Samples.resize(static_cast<std::size_t>(Frames) * 2);
+
+	const int RightChannel = (Channels > 1) ? 1 : 0;
+	for (int Frame = 0; Frame < Frames; ++Frame)
+	{
+		OutBuffer.Samples[Frame * 2] = Decoded[Frame * Channels] / 32768.f;
+		OutBuffer.Samples[Frame * 2 + 1] = Decoded[Frame * Channels + RightChannel] / 32768.f;
+	}
+
+	std::free(Decoded);
+	return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace pk
+{
+	// Decoded sound, always interleaved stereo floats at the file sample rate.
+	struct PcmBuffer
+	{
+		std::vector<float> Samples;
+		int SampleRate;
+		int Frames;
+
+		PcmBuffer();
+	};
+
+	namespace AudioDecoder
+	{
+		bool Decode(const std::string& Path, PcmBuffer& OutBuffer);
+		bool DecodeWav(const unsigned char* Data, std::size_t Size, PcmBuffer& OutBuffer);
+		bool DecodeOgg(const std::string& Path, PcmBuffer& OutBuffer);
+	}
+}
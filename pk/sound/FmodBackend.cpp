@@ -0,0 +1,177 @@
+#include "FmodBackend.h"
+
+#ifndef PK_NO_FMOD
+
+#include <iostream>
+
+using namespace pk;
+
+FmodBackend::FmodBackend()
+	: System(nullptr), LastResult(FMOD_OK)
+{
+}
+
+bool FmodBackend::Initialize(int MaxVoices)
+{
+	LastResult = FMOD::System_Create(&System);
+	if (LastResult != FMOD_OK)
+	{
+		System = nullptr;
+		return false;
+	}
+
+	LastResult = System->init(MaxVoices, FMOD_INIT_NORMAL, nullptr);
+	if (LastResult != FMOD_OK)
+	{
+		System->release();
+		System = nullptr;
+		return false;
+	}
+
+	Channels.assign(MaxVoices, nullptr);
+	return true;
+}
+
+void FmodBackend::Shutdown()
+{
+	if (System == nullptr)
+	{
+		return;
+	}
+
+	System->release();
+	System = nullptr;
+	Sounds.clear();
+	Channels.clear();
+}
+
+int FmodBackend::Load(const std::string& SoundPath, bool bStream)
+{
+	if (System == nullptr)
+	{
+		return -1;
+	}
+
+	FMOD_MODE Mode = FMOD_DEFAULT;
+	Mode |= FMOD_2D;
+	Mode |= FMOD_LOOP_OFF;
+	Mode |= bStream ? FMOD_CREATESTREAM : FMOD_CREATECOMPRESSEDSAMPLE;
+
+	FMOD::Sound* SoundObject = nullptr;
+	LastResult = System->createSound(SoundPath.c_str(), Mode, nullptr, &SoundObject);
+	if (LastResult != FMOD_OK)
+	{
+		std::cout << "Unable to load " << SoundPath << " " << LastResult << "\n";
+		return -1;
+	}
+
+	Sounds.push_back(SoundObject);
+	return static_cast<int>(Sounds.size()) - 1;
+}
+
+bool FmodBackend::Play(int Slot, int SoundIndex, float Volume, bool bMuted, bool bLoop)
+{
+	if (System == nullptr)
+	{
+		return false;
+	}
+
+	FMOD::Channel* Channel = nullptr;
+	LastResult = System->playSound(Sounds[SoundIndex], nullptr, true, &Channel);
+	if (LastResult != FMOD_OK)
+	{
+		return false;
+	}
+
+	Channel->setVolume(Volume);
+	Channel->setMute(bMuted);
+	if (bLoop)
+	{
+		Channel->setLoopCount(-1);
+		Channel->setMode(FMOD_LOOP_NORMAL);
+	}
+	else
+	{
+		Channel->setLoopCount(0);
+	}
+	Channel->setPaused(false);
+
+	Channels[Slot] = Channel;
+	return true;
+}
+
+void FmodBackend::Stop(int Slot)
+{
+	if (Channels[Slot] == nullptr)
+	{
+		return;
+	}
+
+	Channels[Slot]->stop();
+	Channels[Slot] = nullptr;
+}
+
+void FmodBackend::SetMute(int Slot, bool bMute)
+{
+	if (Channels[Slot] != nullptr)
+	{
+		Channels[Slot]->setMute(bMute);
+	}
+}
+
+void FmodBackend::SetVolume(int Slot, float Volume)
+{
+	if (Channels[Slot] != nullptr)
+	{
+		Channels[Slot]->setVolume(Volume);
+	}
+}
+
+void FmodBackend::SetPitch(int Slot, float Pitch)
+{
+	if (Channels[Slot] != nullptr)
+	{
+		Channels[Slot]->setPitch(Pitch);
+	}
+}
+
+bool FmodBackend::IsPlaying(int Slot) const
+{
+	if (Channels[Slot] == nullptr)
+	{
+		return false;
+	}
+
+	bool bPlaying = false;
+	if (Channels[Slot]->isPlaying(&bPlaying) != FMOD_OK)
+	{
+		return false;
+	}
+
+	return bPlaying;
+}
+
+void FmodBackend::Update(float Delta)
+{
+	if (System != nullptr)
+	{
+		System->update();
+	}
+}
+
+const char* FmodBackend::GetName() const
+{
+	return "FMOD";
+}
+
+FMOD_RESULT FmodBackend::GetLastResult() const
+{
+	return LastResult;
+}
+
+FmodBackend::~FmodBackend()
+{
+	Shutdown();
+}
+
+#endif
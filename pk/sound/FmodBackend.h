@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef PK_NO_FMOD
+
+#include <fmod/fmod.hpp>
+
+#include <vector>
+
+#include "ISoundBackend.h"
+
+namespace pk
+{
+	class FmodBackend : public ISoundBackend
+	{
+	public:
+		FmodBackend();
+
+		bool Initialize(int MaxVoices) override;
+		void Shutdown() override;
+
+		int Load(const std::string& SoundPath, bool bStream) override;
+
+		bool Play(int Slot, int SoundIndex, float Volume, bool bMuted, bool bLoop) override;
+		void Stop(int Slot) override;
+		void SetMute(int Slot, bool bMute) override;
+		void SetVolume(int Slot, float Volume) override;
+		void SetPitch(int Slot, float Pitch) override;
+		bool IsPlaying(int Slot) const override;
+
+		void Update(float Delta) override;
+		const char* GetName() const override;
+
+		FMOD_RESULT GetLastResult() const;
+
+		~FmodBackend() override;
+
+	private:
+		FMOD::System* System;
+		FMOD_RESULT LastResult;
+
+		std::vector<FMOD::Sound*> Sounds;
+		std::vector<FMOD::Channel*> Channels;
+	};
+}
+
+#endif
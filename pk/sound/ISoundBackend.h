@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+namespace pk
+{
+	// Voice bookkeeping (slots, groups, stealing) stays in SoundEngine, a backend only plays sounds on numbered slots.
+	class ISoundBackend
+	{
+	public:
+		virtual bool Initialize(int MaxVoices) = 0;
+		virtual void Shutdown() = 0;
+
+		// Returns the index of the loaded sound or -1 on failure.
+		virtual int Load(const std::string& SoundPath, bool bStream) = 0;
+
+		virtual bool Play(int Slot, int SoundIndex, float Volume, bool bMuted, bool bLoop) = 0;
+		virtual void Stop(int Slot) = 0;
+		virtual void SetMute(int Slot, bool bMute) = 0;
+		virtual void SetVolume(int Slot, float Volume) = 0;
+		virtual void SetPitch(int Slot, float Pitch) = 0;
+		virtual bool IsPlaying(int Slot) const = 0;
+
+		virtual void Update(float Delta) = 0;
+		virtual const char* GetName() const = 0;
+
+		virtual ~ISoundBackend() = default;
+	};
+}
@@ -0,0 +1,336 @@
+#include "MixerBackend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PK_MIXER_SSE 1
+#include <xmmintrin.h>
+#endif
+
+using namespace pk;
+
+const int MixerBackend::DEFAULT_SAMPLE_RATE = 44100;
+const int MixerBackend::DEFAULT_BLOCK_FRAMES = 512;
+const int MixerBackend::DEFAULT_LATENCY_BLOCKS = 4;
+
+MixerStats::MixerStats()
+	: Blocks(0), VoiceBlocks(0), Underruns(0), MixMilliseconds(0.0)
+{
+}
+
+MixerBackend::MixerBackend(MixerOutput InOutput)
+	: MixerBackend(InOutput, DEFAULT_SAMPLE_RATE, DEFAULT_BLOCK_FRAMES)
+{
+}
+
+MixerBackend::MixerBackend(MixerOutput InOutput, int InSampleRate, int InBlockFrames)
+	: Output(InOutput), SampleRate(std::max(1, InSampleRate)), BlockFrames(std::max(1, InBlockFrames)), PendingFrames(0.0),
+	bRunning(false), Underruns(0), Checksum(14695981039346656037ull)
+{
+}
+
+bool MixerBackend::Initialize(int MaxVoices)
+{
+	Voices.assign(MaxVoices, MixerVoice{ nullptr, 0.0, 1.f, 1.f, false, false, false });
+	Scratch.assign(static_cast<size_t>(BlockFrames) * 2, 0.f);
+	Block.assign(static_cast<size_t>(BlockFrames) * 2, 0.f);
+
+	if (Output == MixerOutput::Threaded)
+	{
+		// Without a sink the audio thread would mix into the void, refuse so the caller can pick another backend.
+		if (!OnOutput)
+		{
+			std::cout << "[MixerBackend] - Threaded output has no sink, call SetOutput before Initialize\n";
+			return false;
+		}
+
+		Queue = std::make_unique<RingBuffer<float>>(static_cast<size_t>(BlockFrames) * 2 * DEFAULT_LATENCY_BLOCKS);
+		bRunning = true;
+		AudioThread = std::thread(&MixerBackend::RunOutput, this);
+	}
+
+	return true;
+}
+
+void MixerBackend::Shutdown()
+{
+	bRunning = false;
+	if (AudioThread.joinable())
+	{
+		AudioThread.join();
+	}
+}
+
+int MixerBackend::Load(const std::string& SoundPath, bool bStream)
+{
+	PcmBuffer Decoded;
+	if (!AudioDecoder::Decode(SoundPath, Decoded))
+	{
+		return -1;
+	}
+
+	return Load(Decoded);
+}
+
+int MixerBackend::Load(const PcmBuffer& InBuffer)
+{
+	if (InBuffer.Frames <= 0 || InBuffer.SampleRate <= 0)
+	{
+		return -1;
+	}
+
+	Sounds.push_back(std::make_unique<PcmBuffer>(InBuffer));
+	return static_cast<int>(Sounds.size()) - 1;
+}
+
+bool MixerBackend::Play(int Slot, int SoundIndex, float Volume, bool bMuted, bool bLoop)
+{
+	if (SoundIndex < 0 || SoundIndex >= static_cast<int>(Sounds.size()))
+	{
+		return false;
+	}
+
+	Voices[Slot] = MixerVoice{ Sounds[SoundIndex].get(), 0.0, Volume, 1.f, bMuted, bLoop, true };
+	return true;
+}
+
+void MixerBackend::Stop(int Slot)
+{
+	Voices[Slot].bPlaying = false;
+}
+
+void MixerBackend::SetMute(int Slot, bool bMute)
+{
+	Voices[Slot].bMuted = bMute;
+}
+
+void MixerBackend::SetVolume(int Slot, float Volume)
+{
+	Voices[Slot].Volume = Volume;
+}
+
+void MixerBackend::SetPitch(int Slot, float Pitch)
+{
+	Voices[Slot].Pitch = std::max(0.01f, Pitch);
+}
+
+bool MixerBackend::IsPlaying(int Slot) const
+{
+	return Voices[Slot].bPlaying;
+}
+
+void MixerBackend::Update(float Delta)
+{
+	if (Output == MixerOutput::Null)
+	{
+		PendingFrames += static_cast<double>(Delta) * SampleRate;
+		const int Frames = static_cast<int>(PendingFrames);
+		PendingFrames -= Frames;
+
+		for (int Mixed = 0; Mixed < Frames; Mixed += BlockFrames)
+		{
+			MixBlock(Block.data(), std::min(BlockFrames, Frames - Mixed));
+		}
+
+		return;
+	}
+
+	const size_t BlockSamples = static_cast<size_t>(BlockFrames) * 2;
+	while (Queue->Free() >= BlockSamples)
+	{
+		MixBlock(Block.data(), BlockFrames);
+		Queue->Push(Block.data(), BlockSamples);
+	}
+}
+
+const char* MixerBackend::GetName() const
+{
+	return (Output == MixerOutput::Null) ? "Mixer (null output)" : "Mixer";
+}
+
+void MixerBackend::SetOutput(const OutputDelegate& InOutput)
+{
+	OnOutput = InOutput;
+}
+
+void MixerBackend::Render(float* OutSamples, int Frames)
+{
+	for (int Mixed = 0; Mixed < Frames; Mixed += BlockFrames)
+	{
+		MixBlock(OutSamples + static_cast<size_t>(Mixed) * 2, std::min(BlockFrames, Frames - Mixed));
+	}
+}
+
+int MixerBackend::GetSampleRate() const
+{
+	return SampleRate;
+}
+
+int MixerBackend::GetBlockFrames() const
+{
+	return BlockFrames;
+}
+
+std::uint64_t MixerBackend::GetChecksum() const
+{
+	return Checksum;
+}
+
+MixerStats MixerBackend::GetStats() const
+{
+	MixerStats Current = Stats;
+	Current.Underruns = Underruns.load();
+	return Current;
+}
+
+double MixerBackend::GetVoicesPerMillisecond() const
+{
+	if (Stats.MixMilliseconds <= 0.0)
+	{
+		return 0.0;
+	}
+
+	return static_cast<double>(Stats.VoiceBlocks) / Stats.MixMilliseconds;
+}
+
+MixerBackend::~MixerBackend()
+{
+	Shutdown();
+}
+
+void MixerBackend::MixBlock(float* OutSamples, int Frames)
+{
+	const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+
+	std::fill(OutSamples, OutSamples + static_cast<size_t>(Frames) * 2, 0.f);
+	for (MixerVoice& Voice : Voices)
+	{
+		if (Voice.bPlaying)
+		{
+			MixVoice(Voice, OutSamples, Frames);
+			Stats.VoiceBlocks++;
+		}
+	}
+
+	Stats.Blocks++;
+	Stats.MixMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	if (Output == MixerOutput::Null)
+	{
+		Accumulate(OutSamples, Frames * 2);
+	}
+}
+
+void MixerBackend::MixVoice(MixerVoice& Voice, float* OutSamples, int Frames)
+{
+	const PcmBuffer& Sound = *Voice.Sound;
+	const double Step = static_cast<double>(Voice.Pitch) * Sound.SampleRate / SampleRate;
+	const double SourceFrames = Sound.Frames;
+
+	// Silent voices still move forward so they end (or loop) on time.
+	if (Voice.bMuted || Voice.Volume <= 0.f)
+	{
+		Voice.Position += Step * Frames;
+		if (Voice.Position >= SourceFrames)
+		{
+			Voice.bPlaying = Voice.bLoop;
+			Voice.Position = std::fmod(Voice.Position, SourceFrames);
+		}
+
+		return;
+	}
+
+	int Frame = 0;
+	for (; Frame < Frames; ++Frame)
+	{
+		if (Voice.Position >= SourceFrames)
+		{
+			if (!Voice.bLoop)
+			{
+				Voice.bPlaying = false;
+				break;
+			}
+
+			Voice.Position = std::fmod(Voice.Position, SourceFrames);
+		}
+
+		const int Index = static_cast<int>(Voice.Position);
+		const float Fraction = static_cast<float>(Voice.Position - Index);
+		int Next = Index + 1;
+		if (Next >= Sound.Frames)
+		{
+			Next = Voice.bLoop ? 0 : Index;
+		}
+
+		const float* Current = &Sound.Samples[static_cast<size_t>(Index) * 2];
+		const float* Following = &Sound.Samples[static_cast<size_t>(Next) * 2];
+		Scratch[Frame * 2] = Current[0] + (Following[0] - Current[0]) * Fraction;
+		Scratch[Frame * 2 + 1] = Current[1] + (Following[1] - Current[1]) * Fraction;
+		Voice.Position += Step;
+	}
+
+	AddScaled(OutSamples, Scratch.data(), Voice.Volume, Frame * 2);
+}
+
+void MixerBackend::Accumulate(const float* Samples, int Count)
+{
+	for (int i = 0; i < Count; ++i)
+	{
+		const float Clamped = std::min(1.f, std::max(-1.f, Samples[i]));
+		const std::uint16_t Quantized = static_cast<std::uint16_t>(static_cast<std::int16_t>(std::lround(Clamped * 32767.f)));
+		Checksum = (Checksum ^ (Quantized & 0xFF)) * 1099511628211ull;
+		Checksum = (Checksum ^ (Quantized >> 8)) * 1099511628211ull;
+	}
+}
+
+void MixerBackend::RunOutput()
+{
+	const size_t BlockSamples = static_cast<size_t>(BlockFrames) * 2;
+	const std::chrono::duration<double> BlockDuration(static_cast<double>(BlockFrames) / SampleRate);
+	std::vector<float> Drained(BlockSamples, 0.f);
+	std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::now();
+	bool bStarted = false;
+
+	while (bRunning)
+	{
+		const size_t Popped = Queue->Pop(Drained.data(), BlockSamples);
+		if (Popped < BlockSamples)
+		{
+			std::fill(Drained.begin() + Popped, Drained.end(), 0.f);
+			if (bStarted)
+			{
+				Underruns++;
+			}
+		}
+
+		bStarted = bStarted || Popped > 0;
+		if (OnOutput)
+		{
+			OnOutput(Drained.data(), BlockFrames);
+		}
+
+		// Without a device pulling samples, pace the drain like one would.
+		Deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(BlockDuration);
+		std::this_thread::sleep_until(Deadline);
+	}
+}
+
+void MixerBackend::AddScaled(float* OutSamples, const float* InSamples, float Gain, int Count)
+{
+	int i = 0;
+#ifdef PK_MIXER_SSE
+	const __m128 GainVector = _mm_set1_ps(Gain);
+	for (; i + 4 <= Count; i += 4)
+	{
+		const __m128 Scaled = _mm_mul_ps(_mm_loadu_ps(InSamples + i), GainVector);
+		_mm_storeu_ps(OutSamples + i, _mm_add_ps(_mm_loadu_ps(OutSamples + i), Scaled));
+	}
+#endif
+
+	for (; i < Count; ++i)
+	{
+		OutSamples[i] += InSamples[i] * Gain;
+	}
+}
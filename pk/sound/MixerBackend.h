@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "AudioDecoder.h"
+#include "ISoundBackend.h"
+#include "../core/utils/RingBuffer.h"
+
+namespace pk
+{
+	enum class MixerOutput : std::uint8_t
+	{
+		// Update mixes exactly Delta seconds of audio and throws it away, deterministic and thread free.
+		Null,
+		// Update keeps the ring filled, an audio thread drains it in real time into the output delegate.
+		Threaded
+	};
+
+	struct MixerStats
+	{
+		std::uint64_t Blocks;
+		std::uint64_t VoiceBlocks;
+		std::uint64_t Underruns;
+		double MixMilliseconds;
+
+		MixerStats();
+	};
+
+	// Software mixer: sounds are decoded once to PCM and mixed on the calling thread, no external library involved.
+	class MixerBackend : public ISoundBackend
+	{
+	public:
+		typedef std::function<void(const float* Samples, int Frames)> OutputDelegate;
+
+		static const int DEFAULT_SAMPLE_RATE;
+		static const int DEFAULT_BLOCK_FRAMES;
+		static const int DEFAULT_LATENCY_BLOCKS;
+
+		MixerBackend(MixerOutput InOutput);
+		MixerBackend(MixerOutput InOutput, int InSampleRate, int InBlockFrames);
+
+		bool Initialize(int MaxVoices) override;
+		void Shutdown() override;
+
+		int Load(const std::string& SoundPath, bool bStream) override;
+		int Load(const PcmBuffer& InBuffer);
+
+		bool Play(int Slot, int SoundIndex, float Volume, bool bMuted, bool bLoop) override;
+		void Stop(int Slot) override;
+		void SetMute(int Slot, bool bMute) override;
+		void SetVolume(int Slot, float Volume) override;
+		void SetPitch(int Slot, float Pitch) override;
+		bool IsPlaying(int Slot) const override;
+
+		void Update(float Delta) override;
+		const char* GetName() const override;
+
+		// Called from the audio thread, Initialize fails for the threaded output until it is set.
+		void SetOutput(const OutputDelegate& InOutput);
+
+		// Mixes the next Frames of interleaved stereo audio into OutSamples.
+		void Render(float* OutSamples, int Frames);
+
+		int GetSampleRate() const;
+		int GetBlockFrames() const;
+		// FNV-1a of every rendered sample quantized to 16 bit, stable across runs and SIMD paths. Null output only.
+		std::uint64_t GetChecksum() const;
+		MixerStats GetStats() const;
+		// Voice blocks of GetBlockFrames() frames mixed per millisecond of mixing time.
+		double GetVoicesPerMillisecond() const;
+
+		~MixerBackend() override;
+
+	private:
+		struct MixerVoice
+		{
+			const PcmBuffer* Sound;
+			double Position;
+			float Volume;
+			float Pitch;
+			bool bMuted;
+			bool bLoop;
+			bool bPlaying;
+		};
+
+		void MixBlock(float* OutSamples, int Frames);
+		void MixVoice(MixerVoice& Voice, float* OutSamples, int Frames);
+		void Accumulate(const float* Samples, int Count);
+		void RunOutput();
+
+		static void AddScaled(float* OutSamples, const float* InSamples, float Gain, int Count);
+
+		MixerOutput Output;
+		int SampleRate;
+		int BlockFrames;
+		double PendingFrames;
+
+		std::vector<std::unique_ptr<PcmBuffer>> Sounds;
+		std::vector<MixerVoice> Voices;
+		std::vector<float> Scratch;
+		std::vector<float> Block;
+
+		OutputDelegate OnOutput;
+		std::unique_ptr<RingBuffer<float>> Queue;
+		std::thread AudioThread;
+		std::atomic<bool> bRunning;
+		std::atomic<std::uint64_t> Underruns;
+
+		std::uint64_t Checksum;
+		MixerStats Stats;
+	};
+}
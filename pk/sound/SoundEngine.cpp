@@ -1,33 +1,32 @@
 #include "SoundEngine.h"
 
 #include <iostream>
-#include <vector>
+#include <iterator>
 
+#include "FmodBackend.h"
+#include "MixerBackend.h"
 #include "../core/utils/Common.h"
 
 using namespace pk;
 
+const int SoundEngine::DEFAULT_PRIORITY = 128;
+
 void SoundEngine::Load(const std::string& SoundPath)
 {
-	if (!System || IsLoaded(SoundPath))
+	Load(SoundPath, SoundPath, false);
+}
+
+void SoundEngine::Load(const std::string& SoundPath, const std::string& GroupName, bool bStream)
+{
+	if (!Backend || IsLoaded(SoundPath))
 	{
 		return;
 	}
 
-	FMOD_MODE Mode = FMOD_DEFAULT;
-	Mode |= FMOD_2D;
-	Mode |= FMOD_LOOP_OFF;
-	Mode |= FMOD_CREATECOMPRESSEDSAMPLE;
-
-	FMOD::Sound* SoundObject = nullptr;
-	FMOD_RESULT Result = System->createSound(SoundPath.c_str(), Mode, nullptr, &SoundObject);
-	if (Result == FMOD_RESULT::FMOD_OK)
-	{
-		LoadedSounds.insert(std::pair<std::string, FMOD::Sound*>(SoundPath, SoundObject));
-	}
-	else
+	const int SoundIndex = Backend->Load(SoundPath, bStream);
+	if (SoundIndex >= 0)
 	{
-		std::cout << "Unable to load " << SoundPath << " " << Result << "\n";
+		LoadedSounds.insert(SoundPair(SoundPath, LoadedSound{ SoundIndex, FindGroup(GroupName), bStream }));
 	}
 }
 
@@ -38,171 +37,310 @@ SoundEngine::Id SoundEngine::Play(const std::string& SoundPath, const float Volu
 
 SoundEngine::Id SoundEngine::Play(const std::string& SoundPath, float Volume, bool bMuted, bool bLoop)
 {
-	if (!System || !IsLoaded(SoundPath))
+	if (!Backend)
+	{
+		return 0;
+	}
+
+	const SoundsMap::const_iterator Found = LoadedSounds.find(SoundPath);
+	if (Found == LoadedSounds.end())
+	{
+		return 0;
+	}
+
+	const LoadedSound& Sound = Found->second;
+	const int Slot = AcquireVoice(Sound.GroupIndex, Groups[Sound.GroupIndex].Priority);
+	if (Slot < 0)
 	{
 		return 0;
 	}
 
 	const float ActualVolume = Math::Clamp(Volume, 0.f, 1.f);
-	FMOD::Sound* SoundObject = LoadedSounds[SoundPath];
-	FMOD::Channel* Channel = nullptr;
-	LastResult = System->playSound(SoundObject, nullptr, true, &Channel);
-	if (LastResult == FMOD_OK)
-	{
-		Channel->setVolume(ActualVolume);
-		Channel->setMute(bMuted);
-		if (bLoop)
-		{
-			Channel->setLoopCount(-1);
-			Channel->setMode(FMOD_LOOP_NORMAL);
-		}
-		else
-		{
-			Channel->setLoopCount(0);
-		}
-		Channel->setPaused(false);
-		Id ChannelId = NextChannelId++;
-		ActiveChannels.insert(ChannelPair(ChannelId, Channel));
-		return ChannelId;
+	if (!Backend->Play(Slot, Sound.SoundIndex, ActualVolume, bMuted, bLoop))
+	{
+		FreeSlots[NumFree++] = Slot;
+		return 0;
 	}
 
-	return 0;
+	Voice& NewVoice = Voices[Slot];
+	NewVoice.bActive = true;
+	NewVoice.VoiceId = (NextGeneration << 8) | static_cast<Id>(Slot);
+	// Only 24 bits fit above the slot, a generation of 0 would make slot 0 hand out the invalid id.
+	NextGeneration = (NextGeneration + 1) & 0xFFFFFF;
+	if (NextGeneration == 0)
+	{
+		NextGeneration = 1;
+	}
+	NewVoice.GroupIndex = Sound.GroupIndex;
+	NewVoice.Priority = Groups[Sound.GroupIndex].Priority;
+	NewVoice.ActiveIndex = NumActive;
+	NewVoice.StartOrder = NextStartOrder++;
+	NewVoice.bLoop = bLoop;
+
+	ActiveSlots[NumActive++] = Slot;
+	Groups[Sound.GroupIndex].ActiveVoices++;
+	return NewVoice.VoiceId;
 }
 
 void SoundEngine::Mute(Id ChannelId, bool bMute)
 {
-	if (!IsActive(ChannelId))
+	Voice* Found = FindVoice(ChannelId);
+	if (Found == nullptr)
 	{
 		return;
 	}
 
-	ActiveChannels[ChannelId]->setMute(bMute);
+	Backend->SetMute(static_cast<int>(ChannelId & 0xFF), bMute);
 }
 
 void SoundEngine::Stop(Id ChannelId)
 {
-	if (!IsActive(ChannelId))
+	const Voice* Found = FindVoice(ChannelId);
+	if (Found == nullptr)
 	{
 		return;
 	}
 
-	ActiveChannels[ChannelId]->stop();
+	StopVoice(static_cast<int>(ChannelId & 0xFF));
 }
 
 void SoundEngine::SetChannelVolume(Id ChannelId, float NewVolume)
 {
-	if (!IsActive(ChannelId))
+	Voice* Found = FindVoice(ChannelId);
+	if (Found == nullptr)
 	{
 		return;
 	}
 
 	const float ActualVolume = Math::Clamp(NewVolume, 0.f, 1.f);
-	ActiveChannels[ChannelId]->setVolume(ActualVolume);
+	Backend->SetVolume(static_cast<int>(ChannelId & 0xFF), ActualVolume);
 }
 
 void SoundEngine::SetChannelPitch(Id ChannelId, float Pitch)
 {
-	if (!IsActive(ChannelId))
+	Voice* Found = FindVoice(ChannelId);
+	if (Found == nullptr)
 	{
 		return;
 	}
 
-	ActiveChannels[ChannelId]->setPitch(Pitch);
+	Backend->SetPitch(static_cast<int>(ChannelId & 0xFF), Pitch);
 }
 
 bool SoundEngine::IsPlaying(Id ChannelId) const
 {
-	if (!IsActive(ChannelId))
+	const Voice* Found = FindVoice(ChannelId);
+	if (Found == nullptr)
 	{
 		return false;
 	}
 
-	bool bPlaying = false;
-	FMOD_RESULT Result = ActiveChannels.at(ChannelId)->isPlaying(&bPlaying);
-	if (Result != FMOD_OK)
-	{
-		return false;
-	}
-
-	return bPlaying;
+	return Backend->IsPlaying(static_cast<int>(ChannelId & 0xFF));
 }
 
 bool SoundEngine::IsLooping(Id ChannelId) const
 {
-	if (!IsActive(ChannelId))
+	const Voice* Found = FindVoice(ChannelId);
+	return Found != nullptr && Found->bLoop;
+}
+
+bool SoundEngine::IsLoaded(const std::string& SoundName) const
+{
+	return LoadedSounds.count(SoundName) > 0;
+}
+
+void SoundEngine::SetGroupLimit(const std::string& GroupName, int MaxVoices, int Priority)
+{
+	VoiceGroup& Group = Groups[FindGroup(GroupName)];
+	Group.MaxVoices = Math::Clamp(MaxVoices, 1, MAX_VOICES);
+	Group.Priority = Priority;
+}
+
+int SoundEngine::GetActiveVoices() const
+{
+	return NumActive;
+}
+
+bool SoundEngine::SetBackend(std::unique_ptr<ISoundBackend> InBackend)
+{
+	if (InBackend == nullptr || !InBackend->Initialize(MAX_VOICES))
 	{
 		return false;
 	}
 
-	FMOD_RESULT Result;
-	FMOD::Channel* Channel = ActiveChannels.at(ChannelId);
-	FMOD_MODE LoopMode;
-	Result = Channel->getMode(&LoopMode);
-	if (Result != FMOD_OK || LoopMode == FMOD_DEFAULT)
+	for (int i = NumActive - 1; i >= 0; --i)
 	{
-		return false;
+		StopVoice(ActiveSlots[i]);
 	}
 
-	int LoopCount = 0;
-	Result = Channel->getLoopCount(&LoopCount);
-	if (Result != FMOD_OK)
+	if (Backend)
 	{
-		return false;
+		Backend->Shutdown();
 	}
 
-	return LoopCount != 0;
+	Backend = std::move(InBackend);
+	std::cout << "[SoundEngine] - Using " << Backend->GetName() << " backend\n";
+
+	for (SoundsMap::iterator It = LoadedSounds.begin(); It != LoadedSounds.end(); )
+	{
+		It->second.SoundIndex = Backend->Load(It->first, It->second.bStream);
+		It = (It->second.SoundIndex < 0) ? LoadedSounds.erase(It) : std::next(It);
+	}
+
+	return true;
 }
 
-bool SoundEngine::IsLoaded(const std::string& SoundName) const
+ISoundBackend* SoundEngine::GetBackend() const
 {
-	return LoadedSounds.count(SoundName) > 0;
+	return Backend.get();
+}
+
+void SoundEngine::Update(const float Delta)
+{
+	// Walk backwards so swap-removing the current voice never skips one.
+	for (int i = NumActive - 1; i >= 0; --i)
+	{
+		const int Slot = ActiveSlots[i];
+		if (!Backend->IsPlaying(Slot))
+		{
+			ReleaseVoice(Slot);
+		}
+	}
+
+	Backend->Update(Delta);
 }
 
-FMOD_RESULT SoundEngine::GetLastResult() const
+SoundEngine::~SoundEngine()
 {
-	return LastResult;
+	if (Backend)
+	{
+		Backend->Shutdown();
+	}
 }
 
-void SoundEngine::Update(const float Delta)
+SoundEngine::SoundEngine()
+	: Voices(), NumActive(0), NumFree(0), NextGeneration(1), NextStartOrder(0)
+{
+	for (int Slot = MAX_VOICES - 1; Slot >= 0; --Slot)
+	{
+		FreeSlots[NumFree++] = Slot;
+	}
+
+	Initialize();
+}
+
+void SoundEngine::Initialize()
 {
-	std::vector<ChannelsMap::iterator> StoppedSounds;
+#ifndef PK_NO_FMOD
+	if (SetBackend(std::make_unique<FmodBackend>()))
+	{
+		return;
+	}
+
+	std::cout << "[SoundEngine] - FMOD unavailable\n";
+#endif
+
+	// There is no device sink besides FMOD, keep voices timed by a null mixer and say so instead of going silent unannounced.
+	std::cout << "[SoundEngine] - No audio device, sound is muted\n";
+	SetBackend(std::make_unique<MixerBackend>(MixerOutput::Null));
+}
 
-	for (ChannelsMap::iterator It = ActiveChannels.begin(), End = ActiveChannels.end(); It != End; ++It)
+int SoundEngine::FindGroup(const std::string& GroupName)
+{
+	for (int i = 0; i < static_cast<int>(Groups.size()); ++i)
 	{
-		Id ChannelId = It->first;
-		if (!IsPlaying(ChannelId) && !IsLooping(ChannelId))
+		if (Groups[i].Name == GroupName)
 		{
-			StoppedSounds.push_back(It);
+			return i;
 		}
 	}
 
-	for (ChannelsMap::iterator& It : StoppedSounds)
+	Groups.push_back(VoiceGroup{ GroupName, MAX_VOICES, DEFAULT_PRIORITY, 0 });
+	return static_cast<int>(Groups.size()) - 1;
+}
+
+const SoundEngine::Voice* SoundEngine::FindVoice(Id ChannelId) const
+{
+	const Id Slot = ChannelId & 0xFF;
+	if (ChannelId == 0 || Slot >= MAX_VOICES || Voices[Slot].VoiceId != ChannelId || !Voices[Slot].bActive)
 	{
-		ActiveChannels.erase(It);
+		return nullptr;
 	}
 
-	System->update();
+	return &Voices[Slot];
 }
 
-SoundEngine::~SoundEngine()
+SoundEngine::Voice* SoundEngine::FindVoice(Id ChannelId)
 {
-	System->release();
+	return const_cast<Voice*>(static_cast<const SoundEngine*>(this)->FindVoice(ChannelId));
 }
 
-bool SoundEngine::IsActive(Id ChannelId) const
+int SoundEngine::AcquireVoice(int GroupIndex, int Priority)
 {
-	return ActiveChannels.count(ChannelId) > 0;
+	if (Groups[GroupIndex].ActiveVoices >= Groups[GroupIndex].MaxVoices)
+	{
+		StopVoice(FindVictim(GroupIndex));
+	}
+
+	if (NumFree <= 0)
+	{
+		const int Victim = FindVictim(-1);
+		if (Voices[Victim].Priority > Priority)
+		{
+			return -1;
+		}
+
+		StopVoice(Victim);
+	}
+
+	return FreeSlots[--NumFree];
 }
 
-SoundEngine::SoundEngine()
-	: NextChannelId(1)
+int SoundEngine::FindVictim(int GroupIndex) const
 {
-	Initialize();
+	// Lowest priority first, then the oldest one. A negative group searches every voice.
+	int Victim = -1;
+	for (int i = 0; i < NumActive; ++i)
+	{
+		const Voice& Candidate = Voices[ActiveSlots[i]];
+		if (GroupIndex >= 0 && Candidate.GroupIndex != GroupIndex)
+		{
+			continue;
+		}
+
+		if (Victim < 0
+			|| Candidate.Priority < Voices[Victim].Priority
+			|| (Candidate.Priority == Voices[Victim].Priority && Candidate.StartOrder < Voices[Victim].StartOrder))
+		{
+			Victim = ActiveSlots[i];
+		}
+	}
+
+	return Victim;
 }
 
-void SoundEngine::Initialize()
+void SoundEngine::ReleaseVoice(int Slot)
 {
-	LastResult = FMOD::System_Create(&System);
+	Voice& Released = Voices[Slot];
+
+	const int LastSlot = ActiveSlots[NumActive - 1];
+	ActiveSlots[Released.ActiveIndex] = LastSlot;
+	Voices[LastSlot].ActiveIndex = Released.ActiveIndex;
+	--NumActive;
+
+	Groups[Released.GroupIndex].ActiveVoices--;
+	Released.bActive = false;
+	Released.VoiceId = 0;
+	FreeSlots[NumFree++] = Slot;
+}
+
+void SoundEngine::StopVoice(int Slot)
+{
+	if (Slot < 0)
+	{
+		return;
+	}
 
-	System->init(32, FMOD_INIT_NORMAL, nullptr);
+	Backend->Stop(Slot);
+	ReleaseVoice(Slot);
 }
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <fmod/fmod.hpp>
-
+#include <array>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
+
+#include "ISoundBackend.h"
 
 namespace pk
 {
@@ -12,10 +15,39 @@ namespace pk
 	public:
 		typedef unsigned int Id;
 
-		typedef std::map<std::string, FMOD::Sound*> SoundsMap;
-		typedef std::pair<std::string, FMOD::Sound*> SoundPair;
-		typedef std::map<Id, FMOD::Channel*> ChannelsMap;
-		typedef std::pair<Id, FMOD::Channel*> ChannelPair;
+		static const int MAX_VOICES = 32;
+		static const int DEFAULT_PRIORITY;
+
+		struct LoadedSound
+		{
+			int SoundIndex;
+			int GroupIndex;
+			bool bStream;
+		};
+
+		// Sounds sharing a group (usually every file of the same asset) share a voice cap.
+		struct VoiceGroup
+		{
+			std::string Name;
+			int MaxVoices;
+			int Priority;
+			int ActiveVoices;
+		};
+
+		struct Voice
+		{
+			bool bActive;
+			Id VoiceId;
+			int GroupIndex;
+			int Priority;
+			int ActiveIndex;
+			unsigned int StartOrder;
+			bool bLoop;
+		};
+
+		typedef std::map<std::string, LoadedSound> SoundsMap;
+		typedef std::pair<std::string, LoadedSound> SoundPair;
+		typedef std::vector<VoiceGroup> GroupList;
 
 		static SoundEngine& Get()
 		{
@@ -24,6 +56,8 @@ namespace pk
 		}
 
 		void Load(const std::string& SoundPath);
+		// Streamed sounds are decoded while playing instead of being kept in memory, meant for long tracks.
+		void Load(const std::string& SoundPath, const std::string& GroupName, bool bStream);
 		Id Play(const std::string& SoundPath, float Volume);
 		Id Play(const std::string& SoundPath, float Volume, bool bMuted, bool bLoop);
 		void Mute(Id ChannelId, bool bMute);
@@ -35,7 +69,13 @@ namespace pk
 
 		bool IsLoaded(const std::string& SoundName) const;
 
-		FMOD_RESULT GetLastResult() const;
+		// Higher priority voices are never stolen by lower priority ones.
+		void SetGroupLimit(const std::string& GroupName, int MaxVoices, int Priority);
+		int GetActiveVoices() const;
+
+		// Stops every voice and reloads every known sound on the new backend.
+		bool SetBackend(std::unique_ptr<ISoundBackend> InBackend);
+		ISoundBackend* GetBackend() const;
 
 		void Update(const float Delta);
 
@@ -45,15 +85,29 @@ namespace pk
 		~SoundEngine();
 
 	private:
-		bool IsActive(Id ChannelId) const;
 		SoundEngine();
 		void Initialize();
 
-		FMOD::System* System;
-		FMOD_RESULT LastResult;
+		int FindGroup(const std::string& GroupName);
+		const Voice* FindVoice(Id ChannelId) const;
+		Voice* FindVoice(Id ChannelId);
+
+		int AcquireVoice(int GroupIndex, int Priority);
+		int FindVictim(int GroupIndex) const;
+		void ReleaseVoice(int Slot);
+		void StopVoice(int Slot);
+
+		std::unique_ptr<ISoundBackend> Backend;
 
 		SoundsMap LoadedSounds;
-		ChannelsMap ActiveChannels;
-		Id NextChannelId;
+		GroupList Groups;
+
+		std::array<Voice, MAX_VOICES> Voices;
+		std::array<int, MAX_VOICES> ActiveSlots;
+		std::array<int, MAX_VOICES> FreeSlots;
+		int NumActive;
+		int NumFree;
+		unsigned int NextGeneration;
+		unsigned int NextStartOrder;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,148 @@
+#include "Label.h"
+
+#include <iostream>
+
+#include "../core/asset/AssetManager.h"
+#include "../core/render/Renderer.h"
+
+using namespace pk;
+
+Label::Label()
+	: Position(0.f), Orient(TextOrient::Left), Scale(1.f), Color(1.f), Size(0.f), bDirty(true)
+{
+}
+
+Label::Label(const std::string& InFontName, TextOrient InOrient, float InScale, const glm::vec4& InColor)
+	: Position(0.f), Orient(InOrient), Scale(InScale), Color(InColor), Size(0.f), bDirty(true)
+{
+	SetFont(InFontName);
+}
+
+void Label::SetFont(const std::string& InFontName)
+{
+	LabelFont = AssetManager::Get().GetFont(InFontName);
+	if (LabelFont == nullptr)
+	{
+		std::cout << "[Label] - No font with name " << InFontName << "\n";
+		LabelShader = nullptr;
+	}
+	else
+	{
+		LabelShader = LabelFont->GetShader();
+	}
+
+	Measure();
+}
+
+void Label::SetText(const std::string& InText)
+{
+	if (InText == Text)
+	{
+		return;
+	}
+
+	Text = InText;
+	Measure();
+}
+
+void Label::SetPosition(const glm::vec2& InPosition)
+{
+	if (InPosition != Position)
+	{
+		Position = InPosition;
+		bDirty = true;
+	}
+}
+
+void Label::SetOrient(TextOrient InOrient)
+{
+	if (InOrient != Orient)
+	{
+		Orient = InOrient;
+		bDirty = true;
+	}
+}
+
+void Label::SetScale(float InScale)
+{
+	if (InScale != Scale)
+	{
+		Scale = InScale;
+		Measure();
+	}
+}
+
+void Label::SetColor(const glm::vec4& InColor)
+{
+	if (InColor != Color)
+	{
+		Color = InColor;
+		bDirty = true;
+	}
+}
+
+const std::string& Label::GetText() const
+{
+	return Text;
+}
+
+const glm::vec2& Label::GetPosition() const
+{
+	return Position;
+}
+
+const glm::vec2& Label::GetSize() const
+{
+	return Size;
+}
+
+float Label::GetCharacterAdvance(char InCharacter) const
+{
+	return LabelFont != nullptr ? LabelFont->GetCharacterAdvance(InCharacter, Scale) : 0.f;
+}
+
+void Label::Render()
+{
+	if (bDirty)
+	{
+		Layout();
+	}
+
+	if (LabelFont != nullptr)
+	{
+		Renderer::Get().RenderVertices(LabelShader, LabelFont->GetAtlasId(), Vertices);
+	}
+}
+
+void Label::Measure()
+{
+	Size = glm::vec2(0.f);
+	if (LabelFont != nullptr)
+	{
+		LabelFont->GetTextSize(Text, Scale, Size.x, Size.y);
+	}
+
+	bDirty = true;
+}
+
+void Label::Layout()
+{
+	bDirty = false;
+	if (LabelFont == nullptr)
+	{
+		Vertices.clear();
+		return;
+	}
+
+	glm::vec2 Start = Position;
+	if (Orient == TextOrient::Center)
+	{
+		Start.x -= Size.x / 2.f;
+	}
+	else if (Orient == TextOrient::Right)
+	{
+		Start.x -= Size.x;
+	}
+
+	LabelFont->BuildVertices(Text, Start, Scale, Color, Vertices);
+}
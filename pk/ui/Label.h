@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Widget.h"
+#include "../core/asset/Font.h"
+#include "../core/render/RenderCommand.h"
+
+namespace pk
+{
+	// Text that keeps its font, size and glyph quads between frames.
+	// Nothing is measured or laid out again until the text or its placement actually changes.
+	class Label
+	{
+	public:
+		Label();
+		Label(const std::string& InFontName, TextOrient InOrient, float InScale, const glm::vec4& InColor);
+
+		// The font is looked up here, once, instead of on every draw.
+		void SetFont(const std::string& InFontName);
+		// Setting the text or placement it already has costs a compare.
+		void SetText(const std::string& InText);
+		void SetPosition(const glm::vec2& InPosition);
+		void SetOrient(TextOrient InOrient);
+		void SetScale(float InScale);
+		void SetColor(const glm::vec4& InColor);
+
+		const std::string& GetText() const;
+		const glm::vec2& GetPosition() const;
+		// Measured when the text changes, not when it is drawn.
+		const glm::vec2& GetSize() const;
+		float GetCharacterAdvance(char InCharacter) const;
+
+		// Submits the cached quads, they are rebuilt first if something changed since the last draw.
+		// The label must not change again before the frame is flushed.
+		void Render();
+
+	private:
+		void Measure();
+		void Layout();
+
+		Font::SharedPtr LabelFont;
+		Shader::SharedPtr LabelShader;
+
+		std::string Text;
+		glm::vec2 Position;
+		TextOrient Orient;
+		float Scale;
+		glm::vec4 Color;
+
+		glm::vec2 Size;
+		std::vector<StreamVertex> Vertices;
+		bool bDirty;
+	};
+}
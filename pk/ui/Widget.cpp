@@ -7,7 +7,7 @@
 using namespace pk;
 
 Widget::Widget()
-	: bActive(false), Id(-1)
+	: bActive(false), Id(-1), Layer(RenderLayer::Ui)
 {
 }
 
@@ -30,12 +30,32 @@ void Widget::Input(const InputHandler& Handler, const float Delta)
 
 void Widget::Activate()
 {
+	if (bActive)
+	{
+		return;
+	}
+
 	bActive = true;
+	OnActivate();
+}
+
+void Widget::OnActivate()
+{
 }
 
 void Widget::Deactivate()
 {
+	if (!bActive)
+	{
+		return;
+	}
+
 	bActive = false;
+	OnDeactivate();
+}
+
+void Widget::OnDeactivate()
+{
 }
 
 bool Widget::IsActive() const
@@ -43,6 +63,16 @@ bool Widget::IsActive() const
 	return bActive;
 }
 
+void Widget::SetRenderLayer(RenderLayer InLayer)
+{
+	Layer = InLayer;
+}
+
+RenderLayer Widget::GetRenderLayer() const
+{
+	return Layer;
+}
+
 void Widget::SetScene(const SceneWeakPtr& InScene)
 {
 	ScenePtr = InScene;
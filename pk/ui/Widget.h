@@ -4,6 +4,8 @@
 #include <string>
 #include <glm/detail/type_vec.hpp>
 
+#include "../core/render/RenderLayer.h"
+
 namespace pk
 {
 	class Scene;
@@ -35,11 +37,19 @@ namespace pk
 		void Deactivate();
 		bool IsActive() const;
 
+		void SetRenderLayer(RenderLayer InLayer);
+		RenderLayer GetRenderLayer() const;
+
 		void SetScene(const SceneWeakPtr& InScene);
 		SceneSharedPtr GetScene() const;
 
 		virtual ~Widget() = default;
 	protected:
+		// Run by Activate whenever the widget goes from hidden to shown.
+		virtual void OnActivate();
+		// Run by Deactivate whenever the widget goes from shown to hidden.
+		virtual void OnDeactivate();
+
 		static void RenderText(const std::string& InFontName,
 			const glm::vec2& StartLocation,
 			const std::string& InText, TextOrient Orient,
@@ -49,6 +59,7 @@ namespace pk
 	private:
 		bool bActive;
 		int Id;
+		RenderLayer Layer;
 
 		SceneWeakPtr ScenePtr;
 